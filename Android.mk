@@ -27,8 +27,11 @@ SPVTOOLS_SRC_FILES := \
 		source/table.cpp \
 		source/text.cpp \
 		source/text_handler.cpp \
+		source/util/arena.cpp \
 		source/util/bit_vector.cpp \
+		source/util/parallel.cpp \
 		source/util/parse_number.cpp \
+		source/util/result_cache.cpp \
 		source/util/string_utils.cpp \
 		source/util/timer.cpp \
 		source/val/basic_block.cpp \
@@ -77,6 +80,8 @@ SPVTOOLS_SRC_FILES := \
 SPVTOOLS_OPT_SRC_FILES := \
 		source/opt/aggressive_dead_code_elim_pass.cpp \
 		source/opt/amd_ext_to_khr.cpp \
+		source/opt/analysis_report.cpp \
+		source/opt/analysis_snapshot.cpp \
 		source/opt/basic_block.cpp \
 		source/opt/block_merge_pass.cpp \
 		source/opt/block_merge_util.cpp \
@@ -184,6 +189,7 @@ SPVTOOLS_OPT_SRC_FILES := \
 		source/opt/value_number_table.cpp \
 		source/opt/vector_dce.cpp \
 		source/opt/workaround1209.cpp \
+		source/opt/worklist.cpp \
 		source/opt/wrap_opkill.cpp
 
 # Locations of grammar files.
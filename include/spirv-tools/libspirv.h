@@ -670,6 +670,13 @@ SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetSkipBlockLayout(
 SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetAllowLocalSizeId(
     spv_validator_options options, bool val);
 
+// Records the number of threads the validator may use to check function
+// bodies concurrently. 1 (the default) validates on the calling thread only,
+// and 0 uses one thread per hardware thread. The result and the reported
+// diagnostic are the same regardless of the number of threads.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetNumThreads(
+    spv_validator_options options, uint32_t num_threads);
+
 // Creates an optimizer options object with default options. Returns a valid
 // options object. The object remains valid until it is passed into
 // |spvOptimizerOptionsDestroy|.
@@ -702,6 +709,84 @@ SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetPreserveBindings(
 SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetPreserveSpecConstants(
     spv_optimizer_options options, bool val);
 
+// Records whether the instructions of the module being optimized should be
+// allocated in bulk from an arena rather than one at a time from the heap.
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetArenaAllocation(
+    spv_optimizer_options options, bool val);
+
+// Records the directory of an on-disk cache of optimization results.  When
+// set, the optimizer first looks for a result computed earlier for the same
+// module, target environment, passes and options, and stores its result there
+// otherwise.  The directory must exist.  Results are only cached when every
+// pass was registered from a flag or one of the standard recipes.  A cached
+// result is returned without running the validator or any pass, so no
+// messages are emitted for it.  The cache is not used when output about the
+// passes is requested, such as with Optimizer::SetPrintAll or SetTimeReport,
+// or when a pass observer is set.  Entries record the version of the
+// optimizer that computed them, so different versions can share a directory.
+// If |directory| is null or empty, results are not cached, which is the
+// default.
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetCacheDirectory(
+    spv_optimizer_options options, const char* directory);
+
+// Records the file of an analysis snapshot, which holds the dominator and
+// postdominator trees of the functions of a module.  When set, the optimizer
+// installs the trees in the file if it is a snapshot of the input module,
+// instead of computing them when passes need them, and afterwards replaces
+// the file with a snapshot of the optimized module.  Optimizing the output of
+// one run with the same file therefore starts with every tree computed.  A
+// snapshot is only used for a module identical to the one it was written
+// for, but its trees are not recomputed to be checked, so the file must not
+// be writable by anyone who is not trusted.  The optimizer fails if it cannot
+// write the snapshot.  No snapshot is written for a result read from the
+// cache.  If |path| is null or empty, no snapshot is used, which is the
+// default.
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetAnalysisSnapshot(
+    spv_optimizer_options options, const char* path);
+
+// Records the number of threads that passes which support it may use to
+// analyze independent functions concurrently.  1 (the default) optimizes on
+// the calling thread only, and 0 uses one thread per hardware thread.  The
+// optimized module is the same regardless of the number of threads.
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetNumThreads(
+    spv_optimizer_options options, uint32_t num_threads);
+
+// Measurements taken while the optimizer ran one pass.
+typedef struct spv_pass_metrics_t {
+  // The name of the pass, as printed by --print-all.
+  const char* pass_name;
+  // The elapsed and processor time of the pass, in seconds, or -1 if they
+  // could not be measured.
+  double wall_time;
+  double cpu_time;
+  // The growth of the peak resident set size of the process while the pass
+  // ran, in kilobytes, or -1 if it could not be measured.
+  long peak_rss_delta;
+  // The number of instructions in the module before and after the pass, not
+  // counting debug line instructions.
+  size_t num_insts_before;
+  size_t num_insts_after;
+  // The number of analyses the pass invalidated, and the number it built,
+  // including those it built again after invalidating them.
+  uint32_t num_analyses_invalidated;
+  uint32_t num_analyses_built;
+  // Whether the pass changed the module.
+  bool changed;
+} spv_pass_metrics_t;
+
+// Receives the |metrics| of a pass, along with the |user_data| it was
+// registered with.  |metrics| is only alive for the call.
+typedef void (*spv_pass_observer_fn_t)(void* user_data,
+                                       const spv_pass_metrics_t* metrics);
+
+// Records a function the optimizer calls after each pass that succeeded, with
+// the measurements taken while the pass ran.  Measuring only happens when an
+// observer is set.  If |observer| is null, no function is called, which is
+// the default.
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetPassObserver(
+    spv_optimizer_options options, spv_pass_observer_fn_t observer,
+    void* user_data);
+
 // Creates a reducer options object with default options. Returns a valid
 // options object. The object remains valid until it is passed into
 // |spvReducerOptionsDestroy|.
@@ -729,6 +814,16 @@ SPIRV_TOOLS_EXPORT void spvReducerOptionsSetFailOnValidationError(
 SPIRV_TOOLS_EXPORT void spvReducerOptionsSetTargetFunction(
     spv_reducer_options options, uint32_t target_function);
 
+// Sets the number of reduction steps the reducer tries at once.  The steps are
+// the next chunks of the current reduction pass, each applied to the current
+// module, and their interestingness is evaluated concurrently, so the
+// interestingness function must be safe to call from several threads.  The
+// first interesting step in pass order is kept, so the result is the same as
+// with 1 (the default), which tries one step at a time.  0 tries one step per
+// hardware thread.
+SPIRV_TOOLS_EXPORT void spvReducerOptionsSetNumJobs(
+    spv_reducer_options options, uint32_t num_jobs);
+
 // Creates a fuzzer options object with default options. Returns a valid
 // options object. The object remains valid until it is passed into
 // |spvFuzzerOptionsDestroy|.
@@ -805,6 +900,26 @@ SPIRV_TOOLS_EXPORT spv_result_t spvBinaryToText(const spv_const_context context,
                                                 spv_text* text,
                                                 spv_diagnostic* diagnostic);
 
+// A pointer to a function that accepts the next |length| characters of the
+// text produced by spvBinaryToTextStream.  The text is not null-terminated,
+// and is only valid during the call.  The function should return SPV_SUCCESS
+// if and only if disassembly should continue.
+typedef spv_result_t (*spv_text_sink_fn_t)(void* user_data, const char* text,
+                                           size_t length);
+
+// Decodes the given SPIR-V binary representation to its assembly text, like
+// spvBinaryToText, but passes the text to |sink| as it is produced, in chunks
+// of whole lines, instead of building all of it in memory.  The user_data
+// parameter is supplied as context to |sink|.  The option
+// SPV_BINARY_TO_TEXT_OPTION_PRINT is ignored.  If disassembly fails, or if
+// |sink| returns anything other than SPV_SUCCESS, that status code is returned
+// and no further text is produced, but the text already passed to |sink| is
+// not retracted.
+SPIRV_TOOLS_EXPORT spv_result_t spvBinaryToTextStream(
+    const spv_const_context context, const uint32_t* binary,
+    const size_t word_count, const uint32_t options, spv_text_sink_fn_t sink,
+    void* user_data, spv_diagnostic* diagnostic);
+
 // Frees a binary stream from memory. This is a no-op if binary is a null
 // pointer.
 SPIRV_TOOLS_EXPORT void spvBinaryDestroy(spv_binary binary);
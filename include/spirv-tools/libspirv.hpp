@@ -16,6 +16,7 @@
 #define INCLUDE_SPIRV_TOOLS_LIBSPIRV_HPP_
 
 #include <functional>
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +32,10 @@ using MessageConsumer = std::function<void(
     const spv_position_t& /* position */, const char* /* message */
     )>;
 
+// Pass observer.  The metrics are only alive for the specific invocation.  See
+// spv_pass_metrics_t.
+using PassObserver = std::function<void(const spv_pass_metrics_t&)>;
+
 // C++ RAII wrapper around the C context object spv_context.
 class Context {
  public:
@@ -121,6 +126,12 @@ class ValidatorOptions {
     spvValidatorOptionsSetAllowLocalSizeId(options_, val);
   }
 
+  // Sets the number of threads used to check function bodies concurrently.
+  // 1 (the default) disables threading and 0 uses all hardware threads.
+  void SetNumThreads(uint32_t num_threads) {
+    spvValidatorOptionsSetNumThreads(options_, num_threads);
+  }
+
   // Records whether or not the validator should relax the rules on pointer
   // usage in logical addressing mode.
   //
@@ -190,6 +201,31 @@ class OptimizerOptions {
                                                 preserve_spec_constants);
   }
 
+  // Records whether the instructions of the module should be allocated from
+  // an arena.
+  void set_arena_allocation(bool arena_allocation) {
+    spvOptimizerOptionsSetArenaAllocation(options_, arena_allocation);
+  }
+
+  // Records the directory of the on-disk cache of optimization results.  See
+  // spvOptimizerOptionsSetCacheDirectory.
+  void set_cache_directory(const std::string& directory) {
+    spvOptimizerOptionsSetCacheDirectory(options_, directory.c_str());
+  }
+
+  // Records the file of the analysis snapshot.  See
+  // spvOptimizerOptionsSetAnalysisSnapshot.
+  void set_analysis_snapshot(const std::string& path) {
+    spvOptimizerOptionsSetAnalysisSnapshot(options_, path.c_str());
+  }
+
+  // Sets the number of threads passes may use to analyze functions
+  // concurrently.  1 (the default) disables threading and 0 uses all hardware
+  // threads.
+  void set_num_threads(uint32_t num_threads) {
+    spvOptimizerOptionsSetNumThreads(options_, num_threads);
+  }
+
  private:
   spv_optimizer_options options_;
 };
@@ -221,6 +257,11 @@ class ReducerOptions {
     spvReducerOptionsSetTargetFunction(options_, target_function);
   }
 
+  // See spvReducerOptionsSetNumJobs.
+  void set_num_jobs(uint32_t num_jobs) {
+    spvReducerOptionsSetNumJobs(options_, num_jobs);
+  }
+
  private:
   spv_reducer_options options_;
 };
@@ -330,6 +371,14 @@ class SpirvTools {
   bool Disassemble(const uint32_t* binary, size_t binary_size,
                    std::string* text,
                    uint32_t options = kDefaultDisassembleOption) const;
+  // Disassembles the given SPIR-V |binary| with the given |options| and writes
+  // the assembly to |stream| as it is produced, without holding all of it in
+  // memory.  Returns true on successful disassembling.  If disassembling
+  // fails, or |stream| fails, part of the assembly may have been written.
+  // The option SPV_BINARY_TO_TEXT_OPTION_PRINT is ignored.
+  bool Disassemble(const uint32_t* binary, size_t binary_size,
+                   std::ostream* stream,
+                   uint32_t options = kDefaultDisassembleOption) const;
 
   // Validates the given SPIR-V |binary|. Returns true if no issues are found.
   // Otherwise, returns false and communicates issues via the message consumer
@@ -213,6 +213,24 @@ class Optimizer {
   // |out| output stream.
   Optimizer& SetTimeReport(std::ostream* out);
 
+  // Sets the option to print, after the last pass, how many times each
+  // analysis was built and how long that took, charged to the pass that last
+  // invalidated the analysis.  If |out| is null, then no output is generated.
+  // Otherwise, output is sent to the |out| output stream.
+  Optimizer& SetAnalysisReport(std::ostream* out);
+
+  // Sets the option to check, after each pass that changed the module, which
+  // of the analyses the pass invalidated are unchanged, and could have been
+  // declared preserved.  If |out| is null, then nothing is checked.
+  // Otherwise, the findings are sent to the |out| output stream.  This is
+  // slow, and meant for finding passes that cause needless analysis builds.
+  Optimizer& SetPreservedAnalysesAudit(std::ostream* out);
+
+  // Sets the function called with the measurements taken while running each
+  // pass that succeeded.  Measuring only happens when an observer is set.  An
+  // observer set through spvOptimizerOptionsSetPassObserver is called as well.
+  Optimizer& SetPassObserver(PassObserver observer);
+
   // Sets the option to validate the module after each pass.
   Optimizer& SetValidateAfterAll(bool validate);
 
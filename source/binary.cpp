@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <limits>
@@ -251,6 +252,12 @@ spv_result_t Parser::parse(const uint32_t* words, size_t num_words,
 spv_result_t Parser::parseModule() {
   if (!_.words) return diagnostic() << "Missing module.";
 
+  // The module is read in place, so it must be word aligned.  Callers that
+  // map files or carve modules out of larger buffers may not guarantee it.
+  if (reinterpret_cast<uintptr_t>(_.words) % alignof(uint32_t) != 0)
+    return diagnostic(SPV_ERROR_INVALID_POINTER)
+           << "Module is not aligned to a word boundary.";
+
   if (_.num_words < SPV_INDEX_INSTRUCTION)
     return diagnostic() << "Module has incomplete header: only " << _.num_words
                         << " words instead of " << SPV_INDEX_INSTRUCTION;
@@ -47,14 +47,22 @@ namespace {
 // representation.
 class Disassembler {
  public:
+  // If |sink| is not null, the text is passed to it as it is produced, with
+  // |sink_data| as its user data, and SPV_BINARY_TO_TEXT_OPTION_PRINT must not
+  // be set.
   Disassembler(const AssemblyGrammar& grammar, uint32_t options,
-               NameMapper name_mapper)
+               NameMapper name_mapper, spv_text_sink_fn_t sink = nullptr,
+               void* sink_data = nullptr)
       : print_(spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_PRINT, options)),
         text_(),
         out_(print_ ? out_stream() : out_stream(text_)),
         instruction_disassembler_(grammar, out_.get(), options, name_mapper),
         header_(!spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_NO_HEADER, options)),
-        byte_offset_(0) {}
+        byte_offset_(0),
+        sink_(sink),
+        sink_data_(sink_data) {
+    assert(!(print_ && sink_) && "Cannot both print and stream to a sink.");
+  }
 
   // Emits the assembly header for the module, and sets up internal state
   // so subsequent callbacks can handle the cases where the entire module
@@ -69,6 +77,10 @@ class Disassembler {
   // Returns SPV_SUCCESS on success.
   spv_result_t SaveTextResult(spv_text* text_result) const;
 
+  // Passes the text accumulated since the last call to the sink, and returns
+  // the status returned by the sink.
+  spv_result_t FlushToSink();
+
  private:
   const bool print_;  // Should we also print to the standard output stream?
   spv_endianness_t endian_;  // The detected endianness of the binary.
@@ -80,8 +92,15 @@ class Disassembler {
   bool inserted_decoration_space_ = false;
   bool inserted_debug_space_ = false;
   bool inserted_type_space_ = false;
+  spv_text_sink_fn_t sink_;  // Receives the text as it is produced, if set.
+  void* sink_data_;          // The user data for |sink_|.
 };
 
+// The number of characters of text that are accumulated before passing them
+// to a sink.  Only whole instructions are passed, so that is exceeded by the
+// size of the last instruction.
+const std::streamoff kSinkChunkSize = 16 * 1024;
+
 spv_result_t Disassembler::HandleHeader(spv_endianness_t endian,
                                         uint32_t version, uint32_t generator,
                                         uint32_t id_bound, uint32_t schema) {
@@ -110,15 +129,17 @@ spv_result_t Disassembler::HandleInstruction(
 
   byte_offset_ += inst.num_words * sizeof(uint32_t);
 
+  if (sink_ && text_.tellp() >= kSinkChunkSize) return FlushToSink();
   return SPV_SUCCESS;
 }
 
 spv_result_t Disassembler::SaveTextResult(spv_text* text_result) const {
   if (!print_) {
-    size_t length = text_.str().size();
+    const std::string accumulated = text_.str();
+    size_t length = accumulated.size();
     char* str = new char[length + 1];
     if (!str) return SPV_ERROR_OUT_OF_MEMORY;
-    strncpy(str, text_.str().c_str(), length + 1);
+    strncpy(str, accumulated.c_str(), length + 1);
     spv_text text = new spv_text_t();
     if (!text) {
       delete[] str;
@@ -131,6 +152,14 @@ spv_result_t Disassembler::SaveTextResult(spv_text* text_result) const {
   return SPV_SUCCESS;
 }
 
+spv_result_t Disassembler::FlushToSink() {
+  assert(sink_);
+  const std::string chunk = text_.str();
+  text_.str(std::string());
+  if (chunk.empty()) return SPV_SUCCESS;
+  return sink_(sink_data_, chunk.data(), chunk.size());
+}
+
 spv_result_t DisassembleHeader(void* user_data, spv_endianness_t endian,
                                uint32_t /* magic */, uint32_t version,
                                uint32_t generator, uint32_t id_bound,
@@ -530,10 +559,15 @@ std::string spvInstructionBinaryToText(const spv_target_env env,
 }
 }  // namespace spvtools
 
-spv_result_t spvBinaryToText(const spv_const_context context,
-                             const uint32_t* code, const size_t wordCount,
-                             const uint32_t options, spv_text* pText,
-                             spv_diagnostic* pDiagnostic) {
+namespace {
+
+// Disassembles the |wordCount| words at |code|.  If |sink| is null, stores the
+// text in *pText unless printing, and otherwise passes it to |sink|.
+spv_result_t BinaryToText(const spv_const_context context,
+                          const uint32_t* code, const size_t wordCount,
+                          const uint32_t options, spv_text* pText,
+                          spv_text_sink_fn_t sink, void* sink_data,
+                          spv_diagnostic* pDiagnostic) {
   spv_context_t hijack_context = *context;
   if (pDiagnostic) {
     *pDiagnostic = nullptr;
@@ -553,7 +587,8 @@ spv_result_t spvBinaryToText(const spv_const_context context,
   }
 
   // Now disassemble!
-  spvtools::Disassembler disassembler(grammar, options, name_mapper);
+  spvtools::Disassembler disassembler(grammar, options, name_mapper, sink,
+                                      sink_data);
   if (auto error =
           spvBinaryParse(&hijack_context, &disassembler, code, wordCount,
                          spvtools::DisassembleHeader,
@@ -561,5 +596,28 @@ spv_result_t spvBinaryToText(const spv_const_context context,
     return error;
   }
 
+  if (sink) return disassembler.FlushToSink();
   return disassembler.SaveTextResult(pText);
 }
+
+}  // namespace
+
+spv_result_t spvBinaryToText(const spv_const_context context,
+                             const uint32_t* code, const size_t wordCount,
+                             const uint32_t options, spv_text* pText,
+                             spv_diagnostic* pDiagnostic) {
+  return BinaryToText(context, code, wordCount, options, pText, nullptr,
+                      nullptr, pDiagnostic);
+}
+
+spv_result_t spvBinaryToTextStream(const spv_const_context context,
+                                   const uint32_t* code,
+                                   const size_t wordCount,
+                                   const uint32_t options,
+                                   spv_text_sink_fn_t sink, void* user_data,
+                                   spv_diagnostic* pDiagnostic) {
+  if (!sink) return SPV_ERROR_INVALID_POINTER;
+  return BinaryToText(context, code, wordCount,
+                      options & ~uint32_t(SPV_BINARY_TO_TEXT_OPTION_PRINT),
+                      nullptr, sink, user_data, pDiagnostic);
+}
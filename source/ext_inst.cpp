@@ -40,28 +40,37 @@
 #include "spv-amd-shader-trinary-minmax.insts.inc"
 
 static const spv_ext_inst_group_t kGroups_1_0[] = {
-    {SPV_EXT_INST_TYPE_GLSL_STD_450, ARRAY_SIZE(glsl_entries), glsl_entries},
-    {SPV_EXT_INST_TYPE_OPENCL_STD, ARRAY_SIZE(opencl_entries), opencl_entries},
+    {SPV_EXT_INST_TYPE_GLSL_STD_450, ARRAY_SIZE(glsl_entries), glsl_entries,
+     glsl_name_index},
+    {SPV_EXT_INST_TYPE_OPENCL_STD, ARRAY_SIZE(opencl_entries), opencl_entries,
+     opencl_name_index},
     {SPV_EXT_INST_TYPE_SPV_AMD_SHADER_EXPLICIT_VERTEX_PARAMETER,
      ARRAY_SIZE(spv_amd_shader_explicit_vertex_parameter_entries),
-     spv_amd_shader_explicit_vertex_parameter_entries},
+     spv_amd_shader_explicit_vertex_parameter_entries,
+     spv_amd_shader_explicit_vertex_parameter_name_index},
     {SPV_EXT_INST_TYPE_SPV_AMD_SHADER_TRINARY_MINMAX,
      ARRAY_SIZE(spv_amd_shader_trinary_minmax_entries),
-     spv_amd_shader_trinary_minmax_entries},
+     spv_amd_shader_trinary_minmax_entries,
+     spv_amd_shader_trinary_minmax_name_index},
     {SPV_EXT_INST_TYPE_SPV_AMD_GCN_SHADER,
-     ARRAY_SIZE(spv_amd_gcn_shader_entries), spv_amd_gcn_shader_entries},
+     ARRAY_SIZE(spv_amd_gcn_shader_entries), spv_amd_gcn_shader_entries,
+     spv_amd_gcn_shader_name_index},
     {SPV_EXT_INST_TYPE_SPV_AMD_SHADER_BALLOT,
-     ARRAY_SIZE(spv_amd_shader_ballot_entries), spv_amd_shader_ballot_entries},
+     ARRAY_SIZE(spv_amd_shader_ballot_entries), spv_amd_shader_ballot_entries,
+     spv_amd_shader_ballot_name_index},
     {SPV_EXT_INST_TYPE_DEBUGINFO, ARRAY_SIZE(debuginfo_entries),
-     debuginfo_entries},
+     debuginfo_entries, debuginfo_name_index},
     {SPV_EXT_INST_TYPE_OPENCL_DEBUGINFO_100,
-     ARRAY_SIZE(opencl_debuginfo_100_entries), opencl_debuginfo_100_entries},
+     ARRAY_SIZE(opencl_debuginfo_100_entries), opencl_debuginfo_100_entries,
+     opencl_debuginfo_100_name_index},
     {SPV_EXT_INST_TYPE_NONSEMANTIC_SHADER_DEBUGINFO_100,
      ARRAY_SIZE(nonsemantic_shader_debuginfo_100_entries),
-     nonsemantic_shader_debuginfo_100_entries},
+     nonsemantic_shader_debuginfo_100_entries,
+     nonsemantic_shader_debuginfo_100_name_index},
     {SPV_EXT_INST_TYPE_NONSEMANTIC_CLSPVREFLECTION,
      ARRAY_SIZE(nonsemantic_clspvreflection_entries),
-     nonsemantic_clspvreflection_entries},
+     nonsemantic_clspvreflection_entries,
+     nonsemantic_clspvreflection_name_index},
 };
 
 static const spv_ext_inst_table_t kTable_1_0 = {ARRAY_SIZE(kGroups_1_0),
@@ -174,12 +183,11 @@ spv_result_t spvExtInstTableNameLookup(const spv_ext_inst_table table,
   for (uint32_t groupIndex = 0; groupIndex < table->count; groupIndex++) {
     const auto& group = table->groups[groupIndex];
     if (type != group.type) continue;
-    for (uint32_t index = 0; index < group.count; index++) {
-      const auto& entry = group.entries[index];
-      if (!strcmp(name, entry.name)) {
-        *pEntry = &entry;
-        return SPV_SUCCESS;
-      }
+    const auto range = spvtools::EqualRangeOfName(
+        group.entries, group.nameIndex, group.count, name, strlen(name));
+    if (range.first != range.second) {
+      *pEntry = &group.entries[*range.first];
+      return SPV_SUCCESS;
     }
   }
 
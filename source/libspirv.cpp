@@ -108,6 +108,17 @@ bool SpirvTools::Disassemble(const uint32_t* binary, const size_t binary_size,
   return status == SPV_SUCCESS;
 }
 
+bool SpirvTools::Disassemble(const uint32_t* binary, const size_t binary_size,
+                             std::ostream* stream, uint32_t options) const {
+  auto write = [](void* user_data, const char* text, size_t length) {
+    std::ostream* out = static_cast<std::ostream*>(user_data);
+    out->write(text, static_cast<std::streamsize>(length));
+    return out->good() ? SPV_SUCCESS : SPV_ERROR_INTERNAL;
+  };
+  return spvBinaryToTextStream(impl_->context, binary, binary_size, options,
+                               write, stream, nullptr) == SPV_SUCCESS;
+}
+
 bool SpirvTools::Validate(const std::vector<uint32_t>& binary) const {
   return Validate(binary.data(), binary.size());
 }
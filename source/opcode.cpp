@@ -37,8 +37,9 @@ struct OpcodeDescPtrLen {
 
 #include "core.insts-unified1.inc"
 
-static const spv_opcode_table_t kOpcodeTable = {ARRAY_SIZE(kOpcodeTableEntries),
-                                                kOpcodeTableEntries};
+static const spv_opcode_table_t kOpcodeTable = {
+    ARRAY_SIZE(kOpcodeTableEntries), kOpcodeTableEntries,
+    kOpcodeTableNameIndex};
 
 // Represents a vendor tool entry in the SPIR-V XML Registry.
 struct VendorTool {
@@ -95,13 +96,11 @@ spv_result_t spvOpcodeTableNameLookup(spv_target_env env,
   if (!name || !pEntry) return SPV_ERROR_INVALID_POINTER;
   if (!table) return SPV_ERROR_INVALID_TABLE;
 
-  // TODO: This lookup of the Opcode table is suboptimal! Binary sort would be
-  // preferable but the table requires sorting on the Opcode name, but it's
-  // static const initialized and matches the order of the spec.
-  const size_t nameLength = strlen(name);
   const auto version = spvVersionForTargetEnv(env);
-  for (uint64_t opcodeIndex = 0; opcodeIndex < table->count; ++opcodeIndex) {
-    const spv_opcode_desc_t& entry = table->entries[opcodeIndex];
+  const auto range = spvtools::EqualRangeOfName(
+      table->entries, table->nameIndex, table->count, name, strlen(name));
+  for (auto it = range.first; it != range.second; ++it) {
+    const spv_opcode_desc_t& entry = table->entries[*it];
     // We considers the current opcode as available as long as
     // 1. The target environment satisfies the minimal requirement of the
     //    opcode; or
@@ -110,10 +109,8 @@ spv_result_t spvOpcodeTableNameLookup(spv_target_env env,
     // Note that the second rule assumes the extension enabling this instruction
     // is indeed requested in the SPIR-V code; checking that should be
     // validator's work.
-    if (((version >= entry.minVersion && version <= entry.lastVersion) ||
-         entry.numExtensions > 0u || entry.numCapabilities > 0u) &&
-        nameLength == strlen(entry.name) &&
-        !strncmp(name, entry.name, nameLength)) {
+    if ((version >= entry.minVersion && version <= entry.lastVersion) ||
+        entry.numExtensions > 0u || entry.numCapabilities > 0u) {
       // NOTE: Found out Opcode!
       *pEntry = &entry;
       return SPV_SUCCESS;
@@ -61,28 +61,26 @@ spv_result_t spvOperandTableNameLookup(spv_target_env env,
   for (uint64_t typeIndex = 0; typeIndex < table->count; ++typeIndex) {
     const auto& group = table->types[typeIndex];
     if (type != group.type) continue;
-    for (uint64_t index = 0; index < group.count; ++index) {
-      const auto& entry = group.entries[index];
-      // We consider the current operand as available as long as
-      // 1. The target environment satisfies the minimal requirement of the
-      //    operand; or
-      // 2. There is at least one extension enabling this operand; or
-      // 3. There is at least one capability enabling this operand.
-      //
-      // Note that the second rule assumes the extension enabling this operand
-      // is indeed requested in the SPIR-V code; checking that should be
-      // validator's work.
-      if (nameLength == strlen(entry.name) &&
-          !strncmp(entry.name, name, nameLength)) {
-        if ((version >= entry.minVersion && version <= entry.lastVersion) ||
-            entry.numExtensions > 0u || entry.numCapabilities > 0u) {
-          *pEntry = &entry;
-          return SPV_SUCCESS;
-        } else {
-          // if there is no extension/capability then the version is wrong
-          return SPV_ERROR_WRONG_VERSION;
-        }
-      }
+    const auto range = spvtools::EqualRangeOfName(
+        group.entries, group.nameIndex, group.count, name, nameLength);
+    if (range.first == range.second) continue;
+    const auto& entry = group.entries[*range.first];
+    // We consider the current operand as available as long as
+    // 1. The target environment satisfies the minimal requirement of the
+    //    operand; or
+    // 2. There is at least one extension enabling this operand; or
+    // 3. There is at least one capability enabling this operand.
+    //
+    // Note that the second rule assumes the extension enabling this operand
+    // is indeed requested in the SPIR-V code; checking that should be
+    // validator's work.
+    if ((version >= entry.minVersion && version <= entry.lastVersion) ||
+        entry.numExtensions > 0u || entry.numCapabilities > 0u) {
+      *pEntry = &entry;
+      return SPV_SUCCESS;
+    } else {
+      // if there is no extension/capability then the version is wrong
+      return SPV_ERROR_WRONG_VERSION;
     }
   }
 
@@ -188,11 +188,11 @@ void AggressiveDCEPass::ProcessLoad(Function* func, uint32_t varId) {
   // Only process locals
   if (!IsLocalVar(varId, func)) return;
   // Return if already processed
-  if (live_local_vars_.find(varId) != live_local_vars_.end()) return;
+  if (live_local_vars_.Get(varId)) return;
   // Mark all stores to varId as live
   AddStores(func, varId);
   // Cache varId as processed
-  live_local_vars_.insert(varId);
+  live_local_vars_.Set(varId);
 }
 
 void AggressiveDCEPass::AddBranch(uint32_t labelId, BasicBlock* bp) {
@@ -264,7 +264,7 @@ void AggressiveDCEPass::AddBreaksAndContinuesToWorklist(
 bool AggressiveDCEPass::AggressiveDCE(Function* func) {
   std::list<BasicBlock*> structured_order;
   cfg()->ComputeStructuredOrder(func, &*func->begin(), &structured_order);
-  live_local_vars_.clear();
+  live_local_vars_ = utils::BitVector();
   InitializeWorkList(func, structured_order);
   ProcessWorkList(func);
   return KillDeadInstructions(func, structured_order);
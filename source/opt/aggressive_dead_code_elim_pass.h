@@ -241,8 +241,8 @@ class AggressiveDCEPass : public MemPass {
   // Live Instructions
   utils::BitVector live_insts_;
 
-  // Live Local Variables
-  std::unordered_set<uint32_t> live_local_vars_;
+  // Ids of the live local variables
+  utils::BitVector live_local_vars_;
 
   // List of instructions to delete. Deletion is delayed until debug and
   // annotation instructions are processed.
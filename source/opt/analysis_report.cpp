@@ -0,0 +1,198 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/analysis_report.h"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "source/util/make_unique.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+// The analyses PreservedAnalysesAudit can compare.  The dominator trees are
+// derived from the control flow graph only, so they are the same whenever the
+// edges are.
+const IRContext::Analysis kAuditedAnalyses[] = {
+    IRContext::kAnalysisDefUse,
+    IRContext::kAnalysisInstrToBlockMapping,
+    IRContext::kAnalysisDecorations,
+    IRContext::kAnalysisCFG,
+    IRContext::kAnalysisDominatorAnalysis,
+    IRContext::kAnalysisNameMap,
+    IRContext::kAnalysisIdToFuncMapping,
+};
+
+}  // namespace
+
+void AnalysisAccounting::OnAnalysisBuilt(IRContext::Analysis analysis,
+                                         double seconds) {
+  auto it = invalidated_by_.find(analysis);
+  const std::string cause = it == invalidated_by_.end() ? "" : it->second;
+  Cost& cost = costs_[{cause, analysis}];
+  ++cost.num_builds;
+  cost.seconds += seconds;
+}
+
+void AnalysisAccounting::OnAnalysisInvalidated(IRContext::Analysis analysis) {
+  invalidated_by_[analysis] = current_pass_;
+}
+
+void AnalysisAccounting::Report(std::ostream* out) const {
+  using Entry = std::pair<std::pair<std::string, uint32_t>, Cost>;
+  std::vector<Entry> costs(costs_.begin(), costs_.end());
+  std::stable_sort(costs.begin(), costs.end(),
+                   [](const Entry& a, const Entry& b) {
+                     return a.second.seconds > b.second.seconds;
+                   });
+
+  *out << "Analysis builds, by the pass that invalidated the analysis:\n"
+       << std::setw(32) << std::left << "Pass" << std::setw(20) << "Analysis"
+       << std::setw(8) << std::right << "Builds" << std::setw(12) << "Seconds"
+       << "\n";
+  for (const auto& entry : costs) {
+    const std::string& pass =
+        entry.first.first.empty() ? "(first build)" : entry.first.first;
+    *out << std::setw(32) << std::left << pass << std::setw(20)
+         << IRContext::GetAnalysisName(
+                static_cast<IRContext::Analysis>(entry.first.second))
+         << std::setw(8) << std::right << entry.second.num_builds
+         << std::setw(12) << std::fixed << std::setprecision(6)
+         << entry.second.seconds << "\n";
+  }
+}
+
+PreservedAnalysesAudit::PreservedAnalysesAudit(IRContext* context, Pass* pass)
+    : context_(context), audited_(IRContext::kAnalysisNone) {
+  const IRContext::Analysis preserved = pass->GetPreservedAnalyses();
+  for (IRContext::Analysis analysis : kAuditedAnalyses) {
+    if (!(preserved & analysis)) audited_ |= analysis;
+  }
+
+  Module* module = context_->module();
+  if (audited_ & IRContext::kAnalysisDefUse) {
+    def_use_ = MakeUnique<analysis::DefUseManager>(module);
+  }
+  if (audited_ & IRContext::kAnalysisDecorations) {
+    decorations_ = MakeUnique<analysis::DecorationManager>(module);
+  }
+  if (audited_ &
+      (IRContext::kAnalysisCFG | IRContext::kAnalysisDominatorAnalysis)) {
+    edges_ = ComputeEdges();
+  }
+  if (audited_ & IRContext::kAnalysisInstrToBlockMapping) {
+    instr_to_block_ = ComputeInstrToBlock();
+  }
+  if (audited_ & IRContext::kAnalysisIdToFuncMapping) {
+    id_to_func_ = ComputeIdToFunc();
+  }
+  if (audited_ & IRContext::kAnalysisNameMap) names_ = ComputeNames();
+}
+
+PreservedAnalysesAudit::~PreservedAnalysesAudit() = default;
+
+std::vector<IRContext::Analysis> PreservedAnalysesAudit::UnchangedAnalyses()
+    const {
+  Module* module = context_->module();
+  const bool edges_unchanged =
+      (audited_ &
+       (IRContext::kAnalysisCFG | IRContext::kAnalysisDominatorAnalysis)) &&
+      edges_ == ComputeEdges();
+
+  std::vector<IRContext::Analysis> unchanged;
+  for (IRContext::Analysis analysis : kAuditedAnalyses) {
+    if (!(audited_ & analysis)) continue;
+    bool same = false;
+    switch (analysis) {
+      case IRContext::kAnalysisDefUse: {
+        analysis::DefUseManager def_use(module);
+        same = *def_use_ == def_use;
+        break;
+      }
+      case IRContext::kAnalysisDecorations: {
+        analysis::DecorationManager decorations(module);
+        same = *decorations_ == decorations;
+        break;
+      }
+      case IRContext::kAnalysisCFG:
+      case IRContext::kAnalysisDominatorAnalysis:
+        same = edges_unchanged;
+        break;
+      case IRContext::kAnalysisInstrToBlockMapping:
+        same = instr_to_block_ == ComputeInstrToBlock();
+        break;
+      case IRContext::kAnalysisIdToFuncMapping:
+        same = id_to_func_ == ComputeIdToFunc();
+        break;
+      case IRContext::kAnalysisNameMap:
+        same = names_ == ComputeNames();
+        break;
+      default:
+        break;
+    }
+    if (same) unchanged.push_back(analysis);
+  }
+  return unchanged;
+}
+
+PreservedAnalysesAudit::Edges PreservedAnalysesAudit::ComputeEdges() const {
+  Edges edges;
+  for (const Function& function : *context_->module()) {
+    for (const BasicBlock& block : function) {
+      std::vector<uint32_t>& successors = edges[block.id()];
+      block.ForEachSuccessorLabel([&successors](const uint32_t label) {
+        successors.push_back(label);
+      });
+    }
+  }
+  return edges;
+}
+
+std::unordered_map<const Instruction*, const BasicBlock*>
+PreservedAnalysesAudit::ComputeInstrToBlock() const {
+  std::unordered_map<const Instruction*, const BasicBlock*> instr_to_block;
+  for (const Function& function : *context_->module()) {
+    for (const BasicBlock& block : function) {
+      block.ForEachInst([&instr_to_block, &block](const Instruction* inst) {
+        instr_to_block[inst] = &block;
+      });
+    }
+  }
+  return instr_to_block;
+}
+
+std::map<uint32_t, const Function*> PreservedAnalysesAudit::ComputeIdToFunc()
+    const {
+  std::map<uint32_t, const Function*> id_to_func;
+  for (const Function& function : *context_->module()) {
+    id_to_func[function.result_id()] = &function;
+  }
+  return id_to_func;
+}
+
+std::multimap<uint32_t, const Instruction*>
+PreservedAnalysesAudit::ComputeNames() const {
+  std::multimap<uint32_t, const Instruction*> names;
+  for (const Instruction& inst : context_->module()->debugs2()) {
+    if (inst.opcode() == SpvOpName || inst.opcode() == SpvOpMemberName) {
+      names.insert({inst.GetSingleWordInOperand(0), &inst});
+    }
+  }
+  return names;
+}
+
+}  // namespace opt
+}  // namespace spvtools
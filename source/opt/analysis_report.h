@@ -0,0 +1,115 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_ANALYSIS_REPORT_H_
+#define SOURCE_OPT_ANALYSIS_REPORT_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "source/opt/decoration_manager.h"
+#include "source/opt/def_use_manager.h"
+#include "source/opt/ir_context.h"
+#include "source/opt/pass.h"
+
+namespace spvtools {
+namespace opt {
+
+// Accounts for the analyses built while a pipeline runs.  A build is charged
+// to the pass that last invalidated the analysis, since the build repeats work
+// that the pass threw away.  Analyses built for the first time are charged to
+// no pass.
+class AnalysisAccounting : public IRContext::AnalysisListener {
+ public:
+  AnalysisAccounting() = default;
+
+  // Charges the invalidations from now on to the pass named |pass_name|.
+  void SetCurrentPass(const char* pass_name) { current_pass_ = pass_name; }
+
+  void OnAnalysisBuilt(IRContext::Analysis analysis, double seconds) override;
+  void OnAnalysisInvalidated(IRContext::Analysis analysis) override;
+
+  // Writes the number of builds and the time they took for each pass and
+  // analysis to |out|, the most expensive first.
+  void Report(std::ostream* out) const;
+
+ private:
+  // The builds charged to a pass for one analysis.
+  struct Cost {
+    uint32_t num_builds = 0;
+    double seconds = 0;
+  };
+
+  std::string current_pass_;
+  // The pass that last invalidated each analysis.
+  std::unordered_map<uint32_t, std::string> invalidated_by_;
+  // The builds charged to each pass, by pass name and analysis.
+  std::map<std::pair<std::string, uint32_t>, Cost> costs_;
+};
+
+// Checks whether a pass could declare more preserved analyses.  Before the
+// pass runs, the audit takes a snapshot of the analyses the pass does not
+// preserve, among those it can compare.  After the pass, the analyses that are
+// still the same as their snapshot could have been preserved.
+//
+// Analyses refer to instructions by address, so an instruction deleted and
+// another created at the same address can go unnoticed.  Findings are hints to
+// check, not proofs.
+class PreservedAnalysesAudit {
+ public:
+  // Takes the snapshots of the analyses of |context| that |pass| does not
+  // preserve.
+  PreservedAnalysesAudit(IRContext* context, Pass* pass);
+  ~PreservedAnalysesAudit();
+
+  // Returns the analyses that |pass| does not preserve but that are the same
+  // as before it ran.
+  std::vector<IRContext::Analysis> UnchangedAnalyses() const;
+
+ private:
+  // The edges of the control flow graph, from each block label to the labels
+  // of its successors.
+  using Edges = std::map<uint32_t, std::vector<uint32_t>>;
+
+  // Returns the current edges of the control flow graph of |context_|.
+  Edges ComputeEdges() const;
+  // Returns the current map from instructions to their blocks.
+  std::unordered_map<const Instruction*, const BasicBlock*>
+  ComputeInstrToBlock() const;
+  // Returns the current map from function ids to functions.
+  std::map<uint32_t, const Function*> ComputeIdToFunc() const;
+  // Returns the current names of the ids, by id.
+  std::multimap<uint32_t, const Instruction*> ComputeNames() const;
+
+  IRContext* context_;
+  // The analyses that have a snapshot.
+  IRContext::Analysis audited_;
+  std::unique_ptr<analysis::DefUseManager> def_use_;
+  std::unique_ptr<analysis::DecorationManager> decorations_;
+  Edges edges_;
+  std::unordered_map<const Instruction*, const BasicBlock*> instr_to_block_;
+  std::map<uint32_t, const Function*> id_to_func_;
+  std::multimap<uint32_t, const Instruction*> names_;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_ANALYSIS_REPORT_H_
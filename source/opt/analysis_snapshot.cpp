@@ -0,0 +1,134 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/analysis_snapshot.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "source/opt/dominator_analysis.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+// Identifies an analysis snapshot, and the version of its format.
+//
+// A snapshot is the magic number, the version, the number of words of the
+// module and the module itself, followed by the number of trees and the
+// trees.  Each tree is the result id of its function, its kind, the number of
+// its edges and the edges as pairs of block ids, as DominatorTree::GetEdges
+// returns them.
+const uint32_t kSnapshotMagic = 0x53414e53;  // "SNAS"
+const uint32_t kSnapshotVersion = 1;
+
+// The kinds of trees in a snapshot.
+const uint32_t kDominatorTree = 0;
+const uint32_t kPostDominatorTree = 1;
+
+// Appends to |snapshot| the tree of kind |kind| of |function|, whose edges
+// are |edges|.
+void WriteTree(const Function& function, uint32_t kind,
+               const DominatorTree::EdgeList& edges,
+               std::vector<uint32_t>* snapshot) {
+  snapshot->push_back(function.result_id());
+  snapshot->push_back(kind);
+  snapshot->push_back(static_cast<uint32_t>(edges.size()));
+  for (const auto& edge : edges) {
+    snapshot->push_back(edge.first);
+    snapshot->push_back(edge.second);
+  }
+}
+
+}  // namespace
+
+void WriteAnalysisSnapshot(IRContext* context,
+                           const std::vector<uint32_t>& binary,
+                           std::vector<uint32_t>* snapshot) {
+  snapshot->clear();
+  snapshot->push_back(kSnapshotMagic);
+  snapshot->push_back(kSnapshotVersion);
+  snapshot->push_back(static_cast<uint32_t>(binary.size()));
+  snapshot->insert(snapshot->end(), binary.begin(), binary.end());
+
+  const size_t num_trees_index = snapshot->size();
+  snapshot->push_back(0);
+  uint32_t num_trees = 0;
+  for (const Function& function : *context->module()) {
+    WriteTree(function, kDominatorTree,
+              context->GetDominatorAnalysis(&function)->GetDomTree().GetEdges(),
+              snapshot);
+    WriteTree(
+        function, kPostDominatorTree,
+        context->GetPostDominatorAnalysis(&function)->GetDomTree().GetEdges(),
+        snapshot);
+    num_trees += 2;
+  }
+  (*snapshot)[num_trees_index] = num_trees;
+}
+
+bool LoadAnalysisSnapshot(IRContext* context, const uint32_t* binary,
+                          size_t binary_size, const uint32_t* snapshot,
+                          size_t snapshot_size) {
+  const uint32_t* const end = snapshot + snapshot_size;
+  const uint32_t* next = snapshot;
+  if (snapshot_size < 3 || next[0] != kSnapshotMagic ||
+      next[1] != kSnapshotVersion || next[2] != binary_size) {
+    return false;
+  }
+  next += 3;
+  if (static_cast<size_t>(end - next) < binary_size + 1 ||
+      !std::equal(binary, binary + binary_size, next)) {
+    return false;
+  }
+  next += binary_size;
+
+  std::unordered_map<uint32_t, const Function*> functions;
+  for (const Function& function : *context->module()) {
+    functions[function.result_id()] = &function;
+  }
+
+  const uint32_t num_trees = *next++;
+  DominatorTree::EdgeList edges;
+  bool installed = true;
+  for (uint32_t i = 0; installed && i < num_trees; ++i) {
+    installed = false;
+    if (end - next < 3) break;
+    const auto function = functions.find(next[0]);
+    const uint32_t kind = next[1];
+    const uint32_t num_edges = next[2];
+    next += 3;
+    if (function == functions.end() ||
+        static_cast<size_t>(end - next) / 2 < num_edges) {
+      break;
+    }
+    edges.clear();
+    for (uint32_t e = 0; e < num_edges; ++e, next += 2) {
+      edges.emplace_back(next[0], next[1]);
+    }
+    if (kind == kDominatorTree) {
+      installed = context->SetDominatorAnalysis(function->second, edges);
+    } else if (kind == kPostDominatorTree) {
+      installed = context->SetPostDominatorAnalysis(function->second, edges);
+    }
+  }
+  if (!installed || next != end) {
+    context->InvalidateAnalyses(IRContext::kAnalysisDominatorAnalysis);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace opt
+}  // namespace spvtools
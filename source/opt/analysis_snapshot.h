@@ -0,0 +1,57 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_ANALYSIS_SNAPSHOT_H_
+#define SOURCE_OPT_ANALYSIS_SNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "source/opt/ir_context.h"
+
+namespace spvtools {
+namespace opt {
+
+// An analysis snapshot records the analyses of a module that are costly to
+// compute, so that a later tool that loads the same module can install them
+// instead of computing them again.  It holds the dominator and postdominator
+// trees of every function.  The other analyses are built in a single pass
+// over the module, which is no slower than reading them back.
+//
+// A snapshot is a sequence of words that is read in place, so it can be
+// memory-mapped.  It holds a copy of the module it describes, and is only
+// used for a module with exactly the same words.  The trees themselves are
+// only checked to be trees of the blocks of their functions, so snapshots
+// must come from a trusted source: a snapshot with wrong trees makes passes
+// transform the module incorrectly.
+
+// Writes to |snapshot| the analyses of the module of |context|, whose binary
+// is |binary|.  The trees that are not yet computed are computed first.
+void WriteAnalysisSnapshot(IRContext* context,
+                           const std::vector<uint32_t>& binary,
+                           std::vector<uint32_t>* snapshot);
+
+// Installs in |context| the analyses of the |snapshot_size| words at
+// |snapshot|, if they are a snapshot of the module of |context|, whose binary
+// is the |binary_size| words at |binary|.  Returns false, leaving the analyses
+// to be computed on demand, if they are not.
+bool LoadAnalysisSnapshot(IRContext* context, const uint32_t* binary,
+                          size_t binary_size, const uint32_t* snapshot,
+                          size_t snapshot_size);
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_ANALYSIS_SNAPSHOT_H_
@@ -29,6 +29,7 @@
 #include "source/opt/instruction.h"
 #include "source/opt/instruction_list.h"
 #include "source/opt/iterator.h"
+#include "source/util/arena.h"
 
 namespace spvtools {
 namespace opt {
@@ -50,6 +51,13 @@ class BasicBlock {
 
   explicit BasicBlock(const BasicBlock& bb) = delete;
 
+  // Basic blocks are allocated from the arena current on the allocating
+  // thread, if any.  See utils::Arena.
+  static void* operator new(size_t size) {
+    return utils::Arena::Allocate(size);
+  }
+  static void operator delete(void* ptr) { utils::Arena::Deallocate(ptr); }
+
   // Creates a clone of the basic block in the given |context|
   //
   // The parent function will default to null and needs to be explicitly set by
@@ -132,6 +140,13 @@ class BasicBlock {
 
   // Runs the given function |f| on each instruction in this basic block, and
   // optionally on the debug line instructions that might precede them.
+  //
+  // As for the visitors of Instruction, |f| can be any callable, and the
+  // overloads taking a std::function forward to the templated ones.
+  template <typename F>
+  inline void ForEachInst(F&& f, bool run_on_debug_line_insts = false);
+  template <typename F>
+  inline void ForEachInst(F&& f, bool run_on_debug_line_insts = false) const;
   inline void ForEachInst(const std::function<void(Instruction*)>& f,
                           bool run_on_debug_line_insts = false);
   inline void ForEachInst(const std::function<void(const Instruction*)>& f,
@@ -140,6 +155,10 @@ class BasicBlock {
   // Runs the given function |f| on each instruction in this basic block, and
   // optionally on the debug line instructions that might precede them. If |f|
   // returns false, iteration is terminated and this function returns false.
+  template <typename F>
+  inline bool WhileEachInst(F&& f, bool run_on_debug_line_insts = false);
+  template <typename F>
+  inline bool WhileEachInst(F&& f, bool run_on_debug_line_insts = false) const;
   inline bool WhileEachInst(const std::function<bool(Instruction*)>& f,
                             bool run_on_debug_line_insts = false);
   inline bool WhileEachInst(const std::function<bool(const Instruction*)>& f,
@@ -147,12 +166,16 @@ class BasicBlock {
 
   // Runs the given function |f| on each Phi instruction in this basic block,
   // and optionally on the debug line instructions that might precede them.
+  template <typename F>
+  inline void ForEachPhiInst(F&& f, bool run_on_debug_line_insts = false);
   inline void ForEachPhiInst(const std::function<void(Instruction*)>& f,
                              bool run_on_debug_line_insts = false);
 
   // Runs the given function |f| on each Phi instruction in this basic block,
   // and optionally on the debug line instructions that might precede them. If
   // |f| returns false, iteration is terminated and this function return false.
+  template <typename F>
+  inline bool WhileEachPhiInst(F&& f, bool run_on_debug_line_insts = false);
   inline bool WhileEachPhiInst(const std::function<bool(Instruction*)>& f,
                                bool run_on_debug_line_insts = false);
 
@@ -255,8 +278,8 @@ inline void BasicBlock::AddInstructions(BasicBlock* bp) {
   (void)bEnd.MoveBefore(&bp->insts_);
 }
 
-inline bool BasicBlock::WhileEachInst(
-    const std::function<bool(Instruction*)>& f, bool run_on_debug_line_insts) {
+template <typename F>
+inline bool BasicBlock::WhileEachInst(F&& f, bool run_on_debug_line_insts) {
   if (label_) {
     if (!label_->WhileEachInst(f, run_on_debug_line_insts)) return false;
   }
@@ -273,9 +296,9 @@ inline bool BasicBlock::WhileEachInst(
   return true;
 }
 
-inline bool BasicBlock::WhileEachInst(
-    const std::function<bool(const Instruction*)>& f,
-    bool run_on_debug_line_insts) const {
+template <typename F>
+inline bool BasicBlock::WhileEachInst(F&& f,
+                                      bool run_on_debug_line_insts) const {
   if (label_) {
     if (!static_cast<const Instruction*>(label_.get())
              ->WhileEachInst(f, run_on_debug_line_insts))
@@ -289,8 +312,8 @@ inline bool BasicBlock::WhileEachInst(
   return true;
 }
 
-inline void BasicBlock::ForEachInst(const std::function<void(Instruction*)>& f,
-                                    bool run_on_debug_line_insts) {
+template <typename F>
+inline void BasicBlock::ForEachInst(F&& f, bool run_on_debug_line_insts) {
   WhileEachInst(
       [&f](Instruction* inst) {
         f(inst);
@@ -299,9 +322,9 @@ inline void BasicBlock::ForEachInst(const std::function<void(Instruction*)>& f,
       run_on_debug_line_insts);
 }
 
-inline void BasicBlock::ForEachInst(
-    const std::function<void(const Instruction*)>& f,
-    bool run_on_debug_line_insts) const {
+template <typename F>
+inline void BasicBlock::ForEachInst(F&& f,
+                                    bool run_on_debug_line_insts) const {
   WhileEachInst(
       [&f](const Instruction* inst) {
         f(inst);
@@ -310,8 +333,9 @@ inline void BasicBlock::ForEachInst(
       run_on_debug_line_insts);
 }
 
-inline bool BasicBlock::WhileEachPhiInst(
-    const std::function<bool(Instruction*)>& f, bool run_on_debug_line_insts) {
+template <typename F>
+inline bool BasicBlock::WhileEachPhiInst(F&& f,
+                                         bool run_on_debug_line_insts) {
   if (insts_.empty()) {
     return true;
   }
@@ -326,8 +350,8 @@ inline bool BasicBlock::WhileEachPhiInst(
   return true;
 }
 
-inline void BasicBlock::ForEachPhiInst(
-    const std::function<void(Instruction*)>& f, bool run_on_debug_line_insts) {
+template <typename F>
+inline void BasicBlock::ForEachPhiInst(F&& f, bool run_on_debug_line_insts) {
   WhileEachPhiInst(
       [&f](Instruction* inst) {
         f(inst);
@@ -336,6 +360,44 @@ inline void BasicBlock::ForEachPhiInst(
       run_on_debug_line_insts);
 }
 
+inline bool BasicBlock::WhileEachInst(
+    const std::function<bool(Instruction*)>& f, bool run_on_debug_line_insts) {
+  return WhileEachInst<const std::function<bool(Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline bool BasicBlock::WhileEachInst(
+    const std::function<bool(const Instruction*)>& f,
+    bool run_on_debug_line_insts) const {
+  return WhileEachInst<const std::function<bool(const Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline void BasicBlock::ForEachInst(const std::function<void(Instruction*)>& f,
+                                    bool run_on_debug_line_insts) {
+  ForEachInst<const std::function<void(Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline void BasicBlock::ForEachInst(
+    const std::function<void(const Instruction*)>& f,
+    bool run_on_debug_line_insts) const {
+  ForEachInst<const std::function<void(const Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline bool BasicBlock::WhileEachPhiInst(
+    const std::function<bool(Instruction*)>& f, bool run_on_debug_line_insts) {
+  return WhileEachPhiInst<const std::function<bool(Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline void BasicBlock::ForEachPhiInst(
+    const std::function<void(Instruction*)>& f, bool run_on_debug_line_insts) {
+  ForEachPhiInst<const std::function<void(Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
 }  // namespace opt
 }  // namespace spvtools
 
@@ -20,6 +20,7 @@
 #include "source/opt/ir_context.h"
 #include "source/opt/ir_loader.h"
 #include "source/table.h"
+#include "source/util/arena.h"
 #include "source/util/make_unique.h"
 
 namespace spvtools {
@@ -57,17 +58,27 @@ std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
                                             MessageConsumer consumer,
                                             const uint32_t* binary,
                                             const size_t size,
-                                            bool extra_line_tracking) {
+                                            bool extra_line_tracking,
+                                            bool use_arena,
+                                            bool defer_functions) {
   auto context = spvContextCreate(env);
   SetContextMessageConsumer(context, consumer);
 
   auto irContext = MakeUnique<opt::IRContext>(env, consumer);
+  if (use_arena) irContext->EnableArenaAllocation();
   opt::IrLoader loader(consumer, irContext->module());
   loader.SetExtraLineTracking(extra_line_tracking);
+  loader.SetDeferFunctions(defer_functions);
 
-  spv_result_t status = spvBinaryParse(context, &loader, binary, size,
-                                       SetSpvHeader, SetSpvInst, nullptr);
-  loader.EndModule();
+  spv_result_t status;
+  {
+    utils::ArenaScope arena_scope(irContext->arena());
+    status = spvBinaryParse(context, &loader, binary, size, SetSpvHeader,
+                            SetSpvInst, nullptr);
+    if (!loader.EndModule() && status == SPV_SUCCESS) {
+      status = SPV_ERROR_INVALID_BINARY;
+    }
+  }
 
   spvContextDestroy(context);
 
@@ -29,11 +29,17 @@ namespace spvtools {
 // decoded according to the given target |env|. Returns nullptr if errors occur
 // and sends the errors to |consumer|.  When |extra_line_tracking| is true,
 // extra OpLine instructions are injected to better presere line numbers while
-// later transforms mutate the module.
+// later transforms mutate the module.  When |use_arena| is true, the
+// instructions and basic blocks of the module are allocated in bulk from an
+// arena owned by the returned context.  When |defer_functions| is true, the
+// functions are only built when they are first accessed.  See
+// Module::HasDeferredFunctions.
 std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
                                             MessageConsumer consumer,
                                             const uint32_t* binary, size_t size,
-                                            bool extra_line_tracking);
+                                            bool extra_line_tracking,
+                                            bool use_arena = false,
+                                            bool defer_functions = false);
 
 // Like above, with extra line tracking turned on.
 std::unique_ptr<opt::IRContext> BuildModule(spv_target_env env,
@@ -14,6 +14,7 @@
 
 #include "source/opt/cfg.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -39,6 +40,9 @@ CFG::CFG(Module* module)
           new Instruction(module->context(), SpvOpLabel, 0, 0, {}))),
       pseudo_exit_block_(std::unique_ptr<Instruction>(new Instruction(
           module->context(), SpvOpLabel, 0, kMaxResultId, {}))) {
+  const uint32_t id_bound = std::min(module->IdBound(), kDefaultMaxIdBound);
+  id2block_.reserve(id_bound);
+  label2preds_.reserve(id_bound);
   for (auto& fn : *module) {
     for (auto& blk : fn) {
       RegisterBlock(&blk);
@@ -250,7 +254,9 @@ BasicBlock* CFG::SplitLoopHeader(BasicBlock* bb) {
   // |new_header|.
   if (latch_block == bb) {
     if (new_header->ContinueBlockId() == bb->id()) {
-      new_header->GetLoopMergeInst()->SetInOperand(1, {new_header_id});
+      Instruction* loop_merge = new_header->GetLoopMergeInst();
+      loop_merge->SetInOperand(1, {new_header_id});
+      context->AnalyzeUses(loop_merge);
     }
     latch_block = new_header;
   }
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "source/opt/basic_block.h"
+#include "source/util/dense_id_map.h"
 
 namespace spvtools {
 namespace opt {
@@ -177,10 +178,10 @@ class CFG {
   BasicBlock pseudo_exit_block_;
 
   // Map from block's label id to its predecessor blocks ids
-  std::unordered_map<uint32_t, std::vector<uint32_t>> label2preds_;
+  utils::DenseIdMap<std::vector<uint32_t>> label2preds_;
 
   // Map from block's label id to block.
-  std::unordered_map<uint32_t, BasicBlock*> id2block_;
+  utils::DenseIdMap<BasicBlock*> id2block_;
 };
 
 }  // namespace opt
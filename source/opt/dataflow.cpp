@@ -21,11 +21,7 @@ namespace spvtools {
 namespace opt {
 
 bool DataFlowAnalysis::Enqueue(Instruction* inst) {
-  bool& is_enqueued = on_worklist_[inst];
-  if (is_enqueued) return false;
-  is_enqueued = true;
-  worklist_.push(inst);
-  return true;
+  return worklist_.Push(inst);
 }
 
 DataFlowAnalysis::VisitResult DataFlowAnalysis::RunOnce(
@@ -33,9 +29,7 @@ DataFlowAnalysis::VisitResult DataFlowAnalysis::RunOnce(
   InitializeWorklist(function, is_first_iteration);
   VisitResult ret = VisitResult::kResultFixed;
   while (!worklist_.empty()) {
-    Instruction* top = worklist_.front();
-    worklist_.pop();
-    on_worklist_[top] = false;
+    Instruction* top = worklist_.Pop();
     VisitResult result = Visit(top);
     if (result == VisitResult::kResultChanged) {
       EnqueueSuccessors(top);
@@ -15,12 +15,11 @@
 #ifndef SOURCE_OPT_DATAFLOW_H_
 #define SOURCE_OPT_DATAFLOW_H_
 
-#include <queue>
-#include <unordered_map>
 #include <vector>
 
 #include "source/opt/instruction.h"
 #include "source/opt/ir_context.h"
+#include "source/opt/worklist.h"
 
 namespace spvtools {
 namespace opt {
@@ -83,7 +82,6 @@ class DataFlowAnalysis {
   VisitResult RunOnce(Function* function, bool is_first_iteration);
 
   IRContext& context_;
-  std::unordered_map<Instruction*, bool> on_worklist_;
   // The worklist, which contains the list of instructions to be visited.
   //
   // The choice of data structure was influenced by the data in "Iterative
@@ -97,7 +95,7 @@ class DataFlowAnalysis {
   // example in worklist initialization. Also, as the paper claims that sorting
   // successors does not improve runtime, we can use a single queue which is
   // modified during iteration.
-  std::queue<Instruction*> worklist_;
+  InstructionWorklist worklist_;
 };
 
 // A generic data flow analysis, specialized for forward analysis.
@@ -22,6 +22,7 @@
 
 #include "source/opt/instruction.h"
 #include "source/opt/module.h"
+#include "source/util/dense_id_map.h"
 
 namespace spvtools {
 namespace opt {
@@ -198,7 +199,7 @@ class DecorationManager {
   // referencing that id, be it directly (SpvOpDecorate, SpvOpMemberDecorate
   // and SpvOpDecorateId), or indirectly (SpvOpGroupDecorate,
   // SpvOpMemberGroupDecorate).
-  std::unordered_map<uint32_t, TargetData> id_to_decoration_insts_;
+  utils::DenseIdMap<TargetData> id_to_decoration_insts_;
   // The enclosing module.
   Module* module_;
 };
@@ -14,6 +14,8 @@
 
 #include "source/opt/def_use_manager.h"
 
+#include <algorithm>
+
 namespace spvtools {
 namespace opt {
 namespace analysis {
@@ -113,76 +115,46 @@ bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
 
 bool DefUseManager::WhileEachUser(
     const Instruction* def, const std::function<bool(Instruction*)>& f) const {
-  // Ensure that |def| has been registered.
-  assert(def && (!def->HasResultId() || def == GetDef(def->result_id())) &&
-         "Definition is not registered.");
-  if (!def->HasResultId()) return true;
-
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    if (!f(iter->user)) return false;
-  }
-  return true;
+  return WhileEachUser<const std::function<bool(Instruction*)>&>(def, f);
 }
 
 bool DefUseManager::WhileEachUser(
     uint32_t id, const std::function<bool(Instruction*)>& f) const {
-  return WhileEachUser(GetDef(id), f);
+  return WhileEachUser<const std::function<bool(Instruction*)>&>(id, f);
 }
 
 void DefUseManager::ForEachUser(
     const Instruction* def, const std::function<void(Instruction*)>& f) const {
-  WhileEachUser(def, [&f](Instruction* user) {
-    f(user);
-    return true;
-  });
+  ForEachUser<const std::function<void(Instruction*)>&>(def, f);
 }
 
 void DefUseManager::ForEachUser(
     uint32_t id, const std::function<void(Instruction*)>& f) const {
-  ForEachUser(GetDef(id), f);
+  ForEachUser<const std::function<void(Instruction*)>&>(id, f);
 }
 
 bool DefUseManager::WhileEachUse(
     const Instruction* def,
     const std::function<bool(Instruction*, uint32_t)>& f) const {
-  // Ensure that |def| has been registered.
-  assert(def && (!def->HasResultId() || def == GetDef(def->result_id())) &&
-         "Definition is not registered.");
-  if (!def->HasResultId()) return true;
-
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    Instruction* user = iter->user;
-    for (uint32_t idx = 0; idx != user->NumOperands(); ++idx) {
-      const Operand& op = user->GetOperand(idx);
-      if (op.type != SPV_OPERAND_TYPE_RESULT_ID && spvIsIdType(op.type)) {
-        if (def->result_id() == op.words[0]) {
-          if (!f(user, idx)) return false;
-        }
-      }
-    }
-  }
-  return true;
+  return WhileEachUse<const std::function<bool(Instruction*, uint32_t)>&>(def,
+                                                                          f);
 }
 
 bool DefUseManager::WhileEachUse(
     uint32_t id, const std::function<bool(Instruction*, uint32_t)>& f) const {
-  return WhileEachUse(GetDef(id), f);
+  return WhileEachUse<const std::function<bool(Instruction*, uint32_t)>&>(id,
+                                                                          f);
 }
 
 void DefUseManager::ForEachUse(
     const Instruction* def,
     const std::function<void(Instruction*, uint32_t)>& f) const {
-  WhileEachUse(def, [&f](Instruction* user, uint32_t index) {
-    f(user, index);
-    return true;
-  });
+  ForEachUse<const std::function<void(Instruction*, uint32_t)>&>(def, f);
 }
 
 void DefUseManager::ForEachUse(
     uint32_t id, const std::function<void(Instruction*, uint32_t)>& f) const {
-  ForEachUse(GetDef(id), f);
+  ForEachUse<const std::function<void(Instruction*, uint32_t)>&>(id, f);
 }
 
 uint32_t DefUseManager::NumUsers(const Instruction* def) const {
@@ -220,6 +192,7 @@ std::vector<Instruction*> DefUseManager::GetAnnotations(uint32_t id) const {
 
 void DefUseManager::AnalyzeDefUse(Module* module) {
   if (!module) return;
+  id_to_def_.reserve(std::min(module->IdBound(), kDefaultMaxIdBound));
   // Analyze all the defs before any uses to catch forward references.
   module->ForEachInst(
       std::bind(&DefUseManager::AnalyzeInstDef, this, std::placeholders::_1),
@@ -21,6 +21,7 @@
 
 #include "source/opt/instruction.h"
 #include "source/opt/module.h"
+#include "source/util/dense_id_map.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
@@ -96,7 +97,7 @@ struct UserEntryLess {
 // A class for analyzing and managing defs and uses in an Module.
 class DefUseManager {
  public:
-  using IdToDefMap = std::unordered_map<uint32_t, Instruction*>;
+  using IdToDefMap = utils::DenseIdMap<Instruction*>;
 
   // Constructs a def-use manager from the given |module|. All internal messages
   // will be communicated to the outside via the given message |consumer|. This
@@ -132,6 +133,13 @@ class DefUseManager {
   // only be visited once.
   //
   // |def| (or |id|) must be registered as a definition.
+  //
+  // |f| can be any callable, which the compiler can inline into the loop.  The
+  // overloads taking a std::function forward to the templated ones.
+  template <typename F>
+  void ForEachUser(const Instruction* def, F&& f) const;
+  template <typename F>
+  void ForEachUser(uint32_t id, F&& f) const;
   void ForEachUser(const Instruction* def,
                    const std::function<void(Instruction*)>& f) const;
   void ForEachUser(uint32_t id,
@@ -145,6 +153,10 @@ class DefUseManager {
   // be only be visited once.
   //
   // |def| (or |id|) must be registered as a definition.
+  template <typename F>
+  bool WhileEachUser(const Instruction* def, F&& f) const;
+  template <typename F>
+  bool WhileEachUser(uint32_t id, F&& f) const;
   bool WhileEachUser(const Instruction* def,
                      const std::function<bool(Instruction*)>& f) const;
   bool WhileEachUser(uint32_t id,
@@ -157,6 +169,10 @@ class DefUseManager {
   // visited separately.
   //
   // |def| (or |id|) must be registered as a definition.
+  template <typename F>
+  void ForEachUse(const Instruction* def, F&& f) const;
+  template <typename F>
+  void ForEachUse(uint32_t id, F&& f) const;
   void ForEachUse(
       const Instruction* def,
       const std::function<void(Instruction*, uint32_t operand_index)>& f) const;
@@ -172,6 +188,10 @@ class DefUseManager {
   // visited separately.
   //
   // |def| (or |id|) must be registered as a definition.
+  template <typename F>
+  bool WhileEachUse(const Instruction* def, F&& f) const;
+  template <typename F>
+  bool WhileEachUse(uint32_t id, F&& f) const;
   bool WhileEachUse(
       const Instruction* def,
       const std::function<bool(Instruction*, uint32_t operand_index)>& f) const;
@@ -210,6 +230,17 @@ class DefUseManager {
   friend bool CompareAndPrintDifferences(const DefUseManager&,
                                          const DefUseManager&);
 
+  // Returns true if |lhs| and |rhs| record the same definitions and uses.
+  // Unlike CompareAndPrintDifferences, prints nothing.
+  friend bool operator==(const DefUseManager& lhs, const DefUseManager& rhs) {
+    return lhs.id_to_def_ == rhs.id_to_def_ &&
+           lhs.id_to_users_ == rhs.id_to_users_ &&
+           lhs.inst_to_used_ids_ == rhs.inst_to_used_ids_;
+  }
+  friend bool operator!=(const DefUseManager& lhs, const DefUseManager& rhs) {
+    return !(lhs == rhs);
+  }
+
   // If |inst| has not already been analysed, then analyses its definition and
   // uses.
   void UpdateDefUse(Instruction* inst);
@@ -245,6 +276,78 @@ class DefUseManager {
   InstToUsedIdsMap inst_to_used_ids_;
 };
 
+template <typename F>
+bool DefUseManager::WhileEachUser(const Instruction* def, F&& f) const {
+  // Ensure that |def| has been registered.
+  assert(def && (!def->HasResultId() || def == GetDef(def->result_id())) &&
+         "Definition is not registered.");
+  if (!def->HasResultId()) return true;
+
+  auto end = id_to_users_.end();
+  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
+    if (!f(iter->user)) return false;
+  }
+  return true;
+}
+
+template <typename F>
+bool DefUseManager::WhileEachUser(uint32_t id, F&& f) const {
+  return WhileEachUser(GetDef(id), f);
+}
+
+template <typename F>
+void DefUseManager::ForEachUser(const Instruction* def, F&& f) const {
+  WhileEachUser(def, [&f](Instruction* user) {
+    f(user);
+    return true;
+  });
+}
+
+template <typename F>
+void DefUseManager::ForEachUser(uint32_t id, F&& f) const {
+  ForEachUser(GetDef(id), f);
+}
+
+template <typename F>
+bool DefUseManager::WhileEachUse(const Instruction* def, F&& f) const {
+  // Ensure that |def| has been registered.
+  assert(def && (!def->HasResultId() || def == GetDef(def->result_id())) &&
+         "Definition is not registered.");
+  if (!def->HasResultId()) return true;
+
+  auto end = id_to_users_.end();
+  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
+    Instruction* user = iter->user;
+    for (uint32_t idx = 0; idx != user->NumOperands(); ++idx) {
+      const Operand& op = user->GetOperand(idx);
+      if (op.type != SPV_OPERAND_TYPE_RESULT_ID && spvIsIdType(op.type)) {
+        if (def->result_id() == op.words[0]) {
+          if (!f(user, idx)) return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <typename F>
+bool DefUseManager::WhileEachUse(uint32_t id, F&& f) const {
+  return WhileEachUse(GetDef(id), f);
+}
+
+template <typename F>
+void DefUseManager::ForEachUse(const Instruction* def, F&& f) const {
+  WhileEachUse(def, [&f](Instruction* user, uint32_t index) {
+    f(user, index);
+    return true;
+  });
+}
+
+template <typename F>
+void DefUseManager::ForEachUse(uint32_t id, F&& f) const {
+  ForEachUse(GetDef(id), f);
+}
+
 }  // namespace analysis
 }  // namespace opt
 }  // namespace spvtools
@@ -14,8 +14,6 @@
 
 #include "source/opt/dominator_analysis.h"
 
-#include <unordered_set>
-
 #include "source/opt/ir_context.h"
 
 namespace spvtools {
@@ -24,15 +22,12 @@ namespace opt {
 BasicBlock* DominatorAnalysisBase::CommonDominator(BasicBlock* b1,
                                                    BasicBlock* b2) const {
   if (!b1 || !b2) return nullptr;
+  if (b1 == b2) return b1;
 
-  std::unordered_set<BasicBlock*> seen;
+  // Dominance queries take constant time, so walk up from |b1| to the first
+  // block that dominates |b2|.
   BasicBlock* block = b1;
-  while (block && seen.insert(block).second) {
-    block = ImmediateDominator(block);
-  }
-
-  block = b2;
-  while (block && !seen.count(block)) {
+  while (block && !Dominates(block, b2)) {
     block = ImmediateDominator(block);
   }
 
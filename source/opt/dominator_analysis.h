@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <map>
+#include <vector>
 
 #include "source/opt/dominator_tree.h"
 
@@ -33,6 +34,12 @@ class DominatorAnalysisBase {
     tree_.InitializeTree(cfg, f);
   }
 
+  // Builds the tree for |f| from |edges|.  See DominatorTree::InitializeTree.
+  inline bool InitializeTree(const CFG& cfg, const Function* f,
+                             const DominatorTree::EdgeList& edges) {
+    return tree_.InitializeTree(cfg, f, edges);
+  }
+
   // Returns true if BasicBlock |a| dominates BasicBlock |b|.
   inline bool Dominates(const BasicBlock* a, const BasicBlock* b) const {
     if (!a || !b) return false;
@@ -48,6 +55,12 @@ class DominatorAnalysisBase {
   // Returns true if instruction |a| dominates instruction |b|.
   bool Dominates(Instruction* a, Instruction* b) const;
 
+  // Returns true if the BasicBlock with id |a| dominates every BasicBlock with
+  // an id in |bs|.
+  inline bool DominatesAll(uint32_t a, const std::vector<uint32_t>& bs) const {
+    return tree_.DominatesAll(a, bs);
+  }
+
   // Returns true if BasicBlock |a| strictly dominates BasicBlock |b|.
   inline bool StrictlyDominates(const BasicBlock* a,
                                 const BasicBlock* b) const {
@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include <iostream>
+#include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "source/cfa.h"
 #include "source/opt/dominator_tree.h"
@@ -237,11 +240,22 @@ bool DominatorTree::StrictlyDominates(const DominatorTreeNode* a,
 
 bool DominatorTree::Dominates(uint32_t a, uint32_t b) const {
   // Check that both of the inputs are actual nodes.
-  const DominatorTreeNode* a_node = GetTreeNode(a);
-  const DominatorTreeNode* b_node = GetTreeNode(b);
-  if (!a_node || !b_node) return false;
+  const uint32_t a_index = NodeIndex(a);
+  const uint32_t b_index = NodeIndex(b);
+  if (a_index == kNoNode || b_index == kNoNode) return false;
 
-  return Dominates(a_node, b_node);
+  return DominatesIndex(a_index, b_index);
+}
+
+bool DominatorTree::DominatesAll(uint32_t a,
+                                 const std::vector<uint32_t>& bs) const {
+  const uint32_t a_index = NodeIndex(a);
+  if (a_index == kNoNode) return bs.empty();
+  for (uint32_t b : bs) {
+    const uint32_t b_index = NodeIndex(b);
+    if (b_index == kNoNode || !DominatesIndex(a_index, b_index)) return false;
+  }
+  return true;
 }
 
 bool DominatorTree::Dominates(const DominatorTreeNode* a,
@@ -264,10 +278,8 @@ BasicBlock* DominatorTree::ImmediateDominator(const BasicBlock* A) const {
 
 BasicBlock* DominatorTree::ImmediateDominator(uint32_t a) const {
   // Check that A is a valid node in the tree.
-  auto a_itr = nodes_.find(a);
-  if (a_itr == nodes_.end()) return nullptr;
-
-  const DominatorTreeNode* node = &a_itr->second;
+  const DominatorTreeNode* node = GetTreeNode(a);
+  if (node == nullptr) return nullptr;
 
   if (node->parent_ == nullptr) {
     return nullptr;
@@ -277,18 +289,18 @@ BasicBlock* DominatorTree::ImmediateDominator(uint32_t a) const {
 }
 
 DominatorTreeNode* DominatorTree::GetOrInsertNode(BasicBlock* bb) {
-  DominatorTreeNode* dtn = nullptr;
-
-  std::map<uint32_t, DominatorTreeNode>::iterator node_iter =
-      nodes_.find(bb->id());
-  if (node_iter == nodes_.end()) {
-    dtn = &nodes_.emplace(std::make_pair(bb->id(), DominatorTreeNode{bb}))
-               .first->second;
-  } else {
-    dtn = &node_iter->second;
+  uint32_t index = NodeIndex(bb->id());
+  if (index == kNoNode) {
+    index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back(bb);
+    intervals_.push_back({-1, -1});
+    if (bb->id() == placeholder_id_) {
+      placeholder_index_ = index;
+    } else {
+      node_index_.insert({bb->id(), index});
+    }
   }
-
-  return dtn;
+  return &nodes_[index];
 }
 
 void DominatorTree::GetDominatorEdges(
@@ -335,11 +347,66 @@ void DominatorTree::InitializeTree(const CFG& cfg, const Function* f) {
 
   const BasicBlock* placeholder_start_node =
       postdominator_ ? cfg.pseudo_exit_block() : cfg.pseudo_entry_block();
+  placeholder_id_ = placeholder_start_node->id();
 
   // Get the immediate dominator for each node.
   std::vector<std::pair<BasicBlock*, BasicBlock*>> edges;
   GetDominatorEdges(f, placeholder_start_node, &edges);
+  BuildTree(edges);
+}
+
+bool DominatorTree::InitializeTree(const CFG& cfg, const Function* f,
+                                   const EdgeList& edges) {
+  ClearTree();
+
+  if (f->cbegin() == f->cend()) {
+    return edges.empty();
+  }
 
+  BasicBlock* placeholder_start_node = const_cast<BasicBlock*>(
+      postdominator_ ? cfg.pseudo_exit_block() : cfg.pseudo_entry_block());
+  placeholder_id_ = placeholder_start_node->id();
+
+  std::unordered_map<uint32_t, BasicBlock*> blocks;
+  blocks[placeholder_id_] = placeholder_start_node;
+  for (const BasicBlock& bb : *f) {
+    blocks[bb.id()] = const_cast<BasicBlock*>(&bb);
+  }
+
+  // Every node must be listed once, after its parent, so that the edges form
+  // a tree.
+  std::unordered_set<uint32_t> listed;
+  std::vector<std::pair<BasicBlock*, BasicBlock*>> block_edges;
+  block_edges.reserve(edges.size());
+  for (const auto& edge : edges) {
+    auto node = blocks.find(edge.first);
+    auto parent = blocks.find(edge.second);
+    if (node == blocks.end() || parent == blocks.end() ||
+        !listed.insert(edge.first).second ||
+        (edge.first != edge.second && listed.count(edge.second) == 0)) {
+      ClearTree();
+      return false;
+    }
+    block_edges.emplace_back(node->second, parent->second);
+  }
+  BuildTree(block_edges);
+  return true;
+}
+
+DominatorTree::EdgeList DominatorTree::GetEdges() const {
+  EdgeList edges;
+  edges.reserve(nodes_.size());
+  for (const DominatorTreeNode* root : roots_) {
+    for (auto it = root->df_cbegin(); it != root->df_cend(); ++it) {
+      const uint32_t id = it->id();
+      edges.emplace_back(id, it->parent_ ? it->parent_->id() : id);
+    }
+  }
+  return edges;
+}
+
+void DominatorTree::BuildTree(
+    const std::vector<std::pair<BasicBlock*, BasicBlock*>>& edges) {
   // Transform the vector<pair> into the tree structure which we can use to
   // efficiently query dominance.
   for (auto edge : edges) {
@@ -372,6 +439,10 @@ void DominatorTree::ResetDFNumbering() {
   auto getSucc = [](const DominatorTreeNode* node) { return &node->children_; };
 
   for (auto root : roots_) DepthFirstSearch(root, getSucc, preFunc, postFunc);
+
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    intervals_[i] = {nodes_[i].dfs_num_pre_, nodes_[i].dfs_num_post_};
+  }
 }
 
 void DominatorTree::DumpTreeAsDot(std::ostream& out_stream) const {
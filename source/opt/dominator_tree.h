@@ -17,12 +17,14 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <map>
+#include <deque>
+#include <limits>
 #include <utility>
 #include <vector>
 
 #include "source/opt/cfg.h"
 #include "source/opt/tree_iterator.h"
+#include "source/util/dense_id_map.h"
 
 namespace spvtools {
 namespace opt {
@@ -90,10 +92,12 @@ struct DominatorTreeNode {
 
 // A class representing a tree of BasicBlocks in a given function, where each
 // node is dominated by its parent.
+//
+// The nodes are numbered densely in the order they are added, and the tree
+// finds the number of a block from its id with an indexed load, so dominance
+// queries on block ids take constant time.
 class DominatorTree {
  public:
-  // Map OpLabel ids to dominator tree nodes
-  using DominatorTreeNodeMap = std::map<uint32_t, DominatorTreeNode>;
   using iterator = TreeDFIterator<DominatorTreeNode>;
   using const_iterator = TreeDFIterator<const DominatorTreeNode>;
   using post_iterator = PostOrderTreeDFIterator<DominatorTreeNode>;
@@ -104,8 +108,18 @@ class DominatorTree {
   using roots_iterator = DominatorTreeNodeList::iterator;
   using roots_const_iterator = DominatorTreeNodeList::const_iterator;
 
-  DominatorTree() : postdominator_(false) {}
-  explicit DominatorTree(bool post) : postdominator_(post) {}
+  // The nodes of a tree by block id, each paired with the id of its immediate
+  // dominator, or with its own id for a root.
+  using EdgeList = std::vector<std::pair<uint32_t, uint32_t>>;
+
+  DominatorTree()
+      : placeholder_id_(kNoNode),
+        placeholder_index_(kNoNode),
+        postdominator_(false) {}
+  explicit DominatorTree(bool post)
+      : placeholder_id_(kNoNode),
+        placeholder_index_(kNoNode),
+        postdominator_(post) {}
 
   // Depth first iterators.
   // Traverse the dominator tree in a depth first pre-order.
@@ -160,6 +174,16 @@ class DominatorTree {
   // existing data in the dominator tree will be overwritten
   void InitializeTree(const CFG& cfg, const Function* f);
 
+  // Builds the tree of the function |f| from |edges|, as returned by GetEdges
+  // for a tree of the same kind of a function with the same blocks, without
+  // computing dominators.  Returns false and leaves the tree empty if |edges|
+  // is not a tree of the blocks of |f| listed parents first.
+  bool InitializeTree(const CFG& cfg, const Function* f, const EdgeList& edges);
+
+  // Returns the edges of the tree, with the nodes of each root in depth first
+  // pre-order, so that InitializeTree rebuilds the same tree from them.
+  EdgeList GetEdges() const;
+
   // Check if the basic block |a| dominates the basic block |b|.
   bool Dominates(const BasicBlock* a, const BasicBlock* b) const;
 
@@ -169,6 +193,10 @@ class DominatorTree {
   // Check if the dominator tree node |a| dominates the dominator tree node |b|.
   bool Dominates(const DominatorTreeNode* a, const DominatorTreeNode* b) const;
 
+  // Check if the basic block id |a| dominates every basic block id in |bs|.
+  // |a| is looked up once, so this is cheaper than one query per element.
+  bool DominatesAll(uint32_t a, const std::vector<uint32_t>& bs) const;
+
   // Check if the basic block |a| strictly dominates the basic block |b|.
   bool StrictlyDominates(const BasicBlock* a, const BasicBlock* b) const;
 
@@ -205,7 +233,11 @@ class DominatorTree {
   // Clean up the tree.
   void ClearTree() {
     nodes_.clear();
+    intervals_.clear();
+    node_index_.clear();
     roots_.clear();
+    placeholder_id_ = kNoNode;
+    placeholder_index_ = kNoNode;
   }
 
   // Applies the std::function |func| to all nodes in the dominator tree.
@@ -253,20 +285,14 @@ class DominatorTree {
   // Returns the DominatorTreeNode associated with the basic block id |id|.
   // If the id |id| is unknown to the dominator tree, it returns null.
   inline DominatorTreeNode* GetTreeNode(uint32_t id) {
-    DominatorTreeNodeMap::iterator node_iter = nodes_.find(id);
-    if (node_iter == nodes_.end()) {
-      return nullptr;
-    }
-    return &node_iter->second;
+    const uint32_t index = NodeIndex(id);
+    return index == kNoNode ? nullptr : &nodes_[index];
   }
   // Returns the DominatorTreeNode associated with the basic block id |id|.
   // If the id |id| is unknown to the dominator tree, it returns null.
   inline const DominatorTreeNode* GetTreeNode(uint32_t id) const {
-    DominatorTreeNodeMap::const_iterator node_iter = nodes_.find(id);
-    if (node_iter == nodes_.end()) {
-      return nullptr;
-    }
-    return &node_iter->second;
+    const uint32_t index = NodeIndex(id);
+    return index == kNoNode ? nullptr : &nodes_[index];
   }
 
   // Adds the basic block |bb| to the tree structure if it doesn't already
@@ -277,6 +303,32 @@ class DominatorTree {
   void ResetDFNumbering();
 
  private:
+  // Marks the absence of a node.
+  static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+  // The preorder and postorder indexes of a node, as in DominatorTreeNode.
+  struct DFSInterval {
+    int pre;
+    int post;
+  };
+
+  // Returns the number of the node for the basic block id |id|, or kNoNode if
+  // there is none.
+  uint32_t NodeIndex(uint32_t id) const {
+    // The placeholder block of a post-dominator tree has an id past the id
+    // bound, which would size |node_index_| for every possible id.
+    if (id == placeholder_id_) return placeholder_index_;
+    auto it = node_index_.find(id);
+    return it == node_index_.end() ? kNoNode : it->second;
+  }
+
+  // Returns true if the node numbered |a| dominates the node numbered |b|.
+  bool DominatesIndex(uint32_t a, uint32_t b) const {
+    if (a == b) return true;
+    return intervals_[a].pre < intervals_[b].pre &&
+           intervals_[a].post > intervals_[b].post;
+  }
+
   // Wrapper function which gets the list of pairs of each BasicBlocks to its
   // immediately  dominating BasicBlock and stores the result in the edges
   // parameter.
@@ -289,11 +341,28 @@ class DominatorTree {
       const Function* f, const BasicBlock* dummy_start_node,
       std::vector<std::pair<BasicBlock*, BasicBlock*>>* edges);
 
+  // Builds the tree from |edges|, as returned by GetDominatorEdges.
+  void BuildTree(const std::vector<std::pair<BasicBlock*, BasicBlock*>>& edges);
+
   // The roots of the tree.
   std::vector<DominatorTreeNode*> roots_;
 
-  // Pairs each basic block id to the tree node containing that basic block.
-  DominatorTreeNodeMap nodes_;
+  // The nodes of the tree, by number.  A deque, so that adding a node does
+  // not move the others.
+  std::deque<DominatorTreeNode> nodes_;
+
+  // The preorder and postorder indexes of the nodes, by number.  They are
+  // copies of those in |nodes_|, kept together so that dominance queries
+  // touch less memory.
+  std::vector<DFSInterval> intervals_;
+
+  // The number of the node of each basic block id, except the placeholder.
+  utils::DenseIdMap<uint32_t> node_index_;
+
+  // The id of the placeholder block the tree was built from, and the number
+  // of its node.
+  uint32_t placeholder_id_;
+  uint32_t placeholder_index_;
 
   // True if this is a post dominator tree.
   bool postdominator_;
@@ -21,7 +21,9 @@ namespace opt {
 Pass::Status FreezeSpecConstantValuePass::Process() {
   bool modified = false;
   auto ctx = context();
-  ctx->module()->ForEachInst([&modified, ctx](Instruction* inst) {
+  // Spec constants and their decorations are all declared before the
+  // functions.
+  auto freeze = [&modified, ctx](Instruction* inst) {
     switch (inst->opcode()) {
       case SpvOp::SpvOpSpecConstant:
         inst->SetOpcode(SpvOp::SpvOpConstant);
@@ -45,7 +47,19 @@ Pass::Status FreezeSpecConstantValuePass::Process() {
       default:
         break;
     }
-  });
+  };
+  Module* module = ctx->module();
+  for (auto it = module->annotation_begin(); it != module->annotation_end();) {
+    Instruction* inst = &*it;
+    ++it;
+    freeze(inst);
+  }
+  for (auto it = module->types_values_begin();
+       it != module->types_values_end();) {
+    Instruction* inst = &*it;
+    ++it;
+    freeze(inst);
+  }
   return modified ? Status::SuccessWithChange : Status::SuccessWithoutChange;
 }
 
@@ -27,6 +27,7 @@ class FreezeSpecConstantValuePass : public Pass {
  public:
   const char* name() const override { return "freeze-spec-const"; }
   Status Process() override;
+  bool NeedsFunctions() const override { return false; }
 };
 
 }  // namespace opt
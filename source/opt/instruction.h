@@ -31,6 +31,7 @@
 #include "source/opcode.h"
 #include "source/operand.h"
 #include "source/opt/reflect.h"
+#include "source/util/arena.h"
 #include "source/util/ilist_node.h"
 #include "source/util/small_vector.h"
 #include "source/util/string_utils.h"
@@ -226,6 +227,13 @@ class Instruction : public utils::IntrusiveNodeBase<Instruction> {
 
   ~Instruction() override = default;
 
+  // Instructions are allocated from the arena current on the allocating
+  // thread, if any.  See utils::Arena.
+  static void* operator new(size_t size) {
+    return utils::Arena::Allocate(size);
+  }
+  static void operator delete(void* ptr) { utils::Arena::Deallocate(ptr); }
+
   // Returns a newly allocated instruction that has the same operands, result,
   // and type as |this|.  The new instruction is not linked into any list.
   // It is the responsibility of the caller to make sure that the storage is
@@ -370,9 +378,17 @@ class Instruction : public utils::IntrusiveNodeBase<Instruction> {
   // line-related debug instructions.
   inline void ToNop();
 
+  // The visitors below take any callable |f|, which the compiler can inline
+  // into the loop.  The overloads taking a std::function are kept for the
+  // callers that already have one, and forward to the others.
+
   // Runs the given function |f| on this instruction and optionally on the
   // preceding debug line instructions.  The function will always be run
   // if this is itself a debug line instruction.
+  template <typename F>
+  inline void ForEachInst(F&& f, bool run_on_debug_line_insts = false);
+  template <typename F>
+  inline void ForEachInst(F&& f, bool run_on_debug_line_insts = false) const;
   inline void ForEachInst(const std::function<void(Instruction*)>& f,
                           bool run_on_debug_line_insts = false);
   inline void ForEachInst(const std::function<void(const Instruction*)>& f,
@@ -382,6 +398,10 @@ class Instruction : public utils::IntrusiveNodeBase<Instruction> {
   // preceding debug line instructions.  The function will always be run
   // if this is itself a debug line instruction. If |f| returns false,
   // iteration is terminated and this function returns false.
+  template <typename F>
+  inline bool WhileEachInst(F&& f, bool run_on_debug_line_insts = false);
+  template <typename F>
+  inline bool WhileEachInst(F&& f, bool run_on_debug_line_insts = false) const;
   inline bool WhileEachInst(const std::function<bool(Instruction*)>& f,
                             bool run_on_debug_line_insts = false);
   inline bool WhileEachInst(const std::function<bool(const Instruction*)>& f,
@@ -390,26 +410,46 @@ class Instruction : public utils::IntrusiveNodeBase<Instruction> {
   // Runs the given function |f| on all operand ids.
   //
   // |f| should not transform an ID into 0, as 0 is an invalid ID.
+  template <typename F>
+  inline void ForEachId(F&& f);
+  template <typename F>
+  inline void ForEachId(F&& f) const;
   inline void ForEachId(const std::function<void(uint32_t*)>& f);
   inline void ForEachId(const std::function<void(const uint32_t*)>& f) const;
 
   // Runs the given function |f| on all "in" operand ids.
+  template <typename F>
+  inline void ForEachInId(F&& f);
+  template <typename F>
+  inline void ForEachInId(F&& f) const;
   inline void ForEachInId(const std::function<void(uint32_t*)>& f);
   inline void ForEachInId(const std::function<void(const uint32_t*)>& f) const;
 
   // Runs the given function |f| on all "in" operand ids. If |f| returns false,
   // iteration is terminated and this function returns false.
+  template <typename F>
+  inline bool WhileEachInId(F&& f);
+  template <typename F>
+  inline bool WhileEachInId(F&& f) const;
   inline bool WhileEachInId(const std::function<bool(uint32_t*)>& f);
   inline bool WhileEachInId(
       const std::function<bool(const uint32_t*)>& f) const;
 
   // Runs the given function |f| on all "in" operands.
+  template <typename F>
+  inline void ForEachInOperand(F&& f);
+  template <typename F>
+  inline void ForEachInOperand(F&& f) const;
   inline void ForEachInOperand(const std::function<void(uint32_t*)>& f);
   inline void ForEachInOperand(
       const std::function<void(const uint32_t*)>& f) const;
 
   // Runs the given function |f| on all "in" operands. If |f| returns false,
   // iteration is terminated and this function return false.
+  template <typename F>
+  inline bool WhileEachInOperand(F&& f);
+  template <typename F>
+  inline bool WhileEachInOperand(F&& f) const;
   inline bool WhileEachInOperand(const std::function<bool(uint32_t*)>& f);
   inline bool WhileEachInOperand(
       const std::function<bool(const uint32_t*)>& f) const;
@@ -747,8 +787,8 @@ inline void Instruction::ToNop() {
   operands_.clear();
 }
 
-inline bool Instruction::WhileEachInst(
-    const std::function<bool(Instruction*)>& f, bool run_on_debug_line_insts) {
+template <typename F>
+inline bool Instruction::WhileEachInst(F&& f, bool run_on_debug_line_insts) {
   if (run_on_debug_line_insts) {
     for (auto& dbg_line : dbg_line_insts_) {
       if (!f(&dbg_line)) return false;
@@ -757,9 +797,9 @@ inline bool Instruction::WhileEachInst(
   return f(this);
 }
 
-inline bool Instruction::WhileEachInst(
-    const std::function<bool(const Instruction*)>& f,
-    bool run_on_debug_line_insts) const {
+template <typename F>
+inline bool Instruction::WhileEachInst(F&& f,
+                                       bool run_on_debug_line_insts) const {
   if (run_on_debug_line_insts) {
     for (auto& dbg_line : dbg_line_insts_) {
       if (!f(&dbg_line)) return false;
@@ -768,8 +808,8 @@ inline bool Instruction::WhileEachInst(
   return f(this);
 }
 
-inline void Instruction::ForEachInst(const std::function<void(Instruction*)>& f,
-                                     bool run_on_debug_line_insts) {
+template <typename F>
+inline void Instruction::ForEachInst(F&& f, bool run_on_debug_line_insts) {
   WhileEachInst(
       [&f](Instruction* inst) {
         f(inst);
@@ -778,9 +818,9 @@ inline void Instruction::ForEachInst(const std::function<void(Instruction*)>& f,
       run_on_debug_line_insts);
 }
 
-inline void Instruction::ForEachInst(
-    const std::function<void(const Instruction*)>& f,
-    bool run_on_debug_line_insts) const {
+template <typename F>
+inline void Instruction::ForEachInst(F&& f,
+                                     bool run_on_debug_line_insts) const {
   WhileEachInst(
       [&f](const Instruction* inst) {
         f(inst);
@@ -789,19 +829,20 @@ inline void Instruction::ForEachInst(
       run_on_debug_line_insts);
 }
 
-inline void Instruction::ForEachId(const std::function<void(uint32_t*)>& f) {
+template <typename F>
+inline void Instruction::ForEachId(F&& f) {
   for (auto& operand : operands_)
     if (spvIsIdType(operand.type)) f(&operand.words[0]);
 }
 
-inline void Instruction::ForEachId(
-    const std::function<void(const uint32_t*)>& f) const {
+template <typename F>
+inline void Instruction::ForEachId(F&& f) const {
   for (const auto& operand : operands_)
     if (spvIsIdType(operand.type)) f(&operand.words[0]);
 }
 
-inline bool Instruction::WhileEachInId(
-    const std::function<bool(uint32_t*)>& f) {
+template <typename F>
+inline bool Instruction::WhileEachInId(F&& f) {
   for (auto& operand : operands_) {
     if (spvIsInIdType(operand.type) && !f(&operand.words[0])) {
       return false;
@@ -810,8 +851,8 @@ inline bool Instruction::WhileEachInId(
   return true;
 }
 
-inline bool Instruction::WhileEachInId(
-    const std::function<bool(const uint32_t*)>& f) const {
+template <typename F>
+inline bool Instruction::WhileEachInId(F&& f) const {
   for (const auto& operand : operands_) {
     if (spvIsInIdType(operand.type) && !f(&operand.words[0])) {
       return false;
@@ -820,23 +861,24 @@ inline bool Instruction::WhileEachInId(
   return true;
 }
 
-inline void Instruction::ForEachInId(const std::function<void(uint32_t*)>& f) {
+template <typename F>
+inline void Instruction::ForEachInId(F&& f) {
   WhileEachInId([&f](uint32_t* id) {
     f(id);
     return true;
   });
 }
 
-inline void Instruction::ForEachInId(
-    const std::function<void(const uint32_t*)>& f) const {
+template <typename F>
+inline void Instruction::ForEachInId(F&& f) const {
   WhileEachInId([&f](const uint32_t* id) {
     f(id);
     return true;
   });
 }
 
-inline bool Instruction::WhileEachInOperand(
-    const std::function<bool(uint32_t*)>& f) {
+template <typename F>
+inline bool Instruction::WhileEachInOperand(F&& f) {
   for (auto& operand : operands_) {
     switch (operand.type) {
       case SPV_OPERAND_TYPE_RESULT_ID:
@@ -850,8 +892,8 @@ inline bool Instruction::WhileEachInOperand(
   return true;
 }
 
-inline bool Instruction::WhileEachInOperand(
-    const std::function<bool(const uint32_t*)>& f) const {
+template <typename F>
+inline bool Instruction::WhileEachInOperand(F&& f) const {
   for (const auto& operand : operands_) {
     switch (operand.type) {
       case SPV_OPERAND_TYPE_RESULT_ID:
@@ -865,22 +907,96 @@ inline bool Instruction::WhileEachInOperand(
   return true;
 }
 
-inline void Instruction::ForEachInOperand(
-    const std::function<void(uint32_t*)>& f) {
+template <typename F>
+inline void Instruction::ForEachInOperand(F&& f) {
   WhileEachInOperand([&f](uint32_t* operand) {
     f(operand);
     return true;
   });
 }
 
-inline void Instruction::ForEachInOperand(
-    const std::function<void(const uint32_t*)>& f) const {
+template <typename F>
+inline void Instruction::ForEachInOperand(F&& f) const {
   WhileEachInOperand([&f](const uint32_t* operand) {
     f(operand);
     return true;
   });
 }
 
+inline bool Instruction::WhileEachInst(
+    const std::function<bool(Instruction*)>& f, bool run_on_debug_line_insts) {
+  return WhileEachInst<const std::function<bool(Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline bool Instruction::WhileEachInst(
+    const std::function<bool(const Instruction*)>& f,
+    bool run_on_debug_line_insts) const {
+  return WhileEachInst<const std::function<bool(const Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline void Instruction::ForEachInst(const std::function<void(Instruction*)>& f,
+                                     bool run_on_debug_line_insts) {
+  ForEachInst<const std::function<void(Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline void Instruction::ForEachInst(
+    const std::function<void(const Instruction*)>& f,
+    bool run_on_debug_line_insts) const {
+  ForEachInst<const std::function<void(const Instruction*)>&>(
+      f, run_on_debug_line_insts);
+}
+
+inline void Instruction::ForEachId(const std::function<void(uint32_t*)>& f) {
+  ForEachId<const std::function<void(uint32_t*)>&>(f);
+}
+
+inline void Instruction::ForEachId(
+    const std::function<void(const uint32_t*)>& f) const {
+  ForEachId<const std::function<void(const uint32_t*)>&>(f);
+}
+
+inline bool Instruction::WhileEachInId(
+    const std::function<bool(uint32_t*)>& f) {
+  return WhileEachInId<const std::function<bool(uint32_t*)>&>(f);
+}
+
+inline bool Instruction::WhileEachInId(
+    const std::function<bool(const uint32_t*)>& f) const {
+  return WhileEachInId<const std::function<bool(const uint32_t*)>&>(f);
+}
+
+inline void Instruction::ForEachInId(const std::function<void(uint32_t*)>& f) {
+  ForEachInId<const std::function<void(uint32_t*)>&>(f);
+}
+
+inline void Instruction::ForEachInId(
+    const std::function<void(const uint32_t*)>& f) const {
+  ForEachInId<const std::function<void(const uint32_t*)>&>(f);
+}
+
+inline bool Instruction::WhileEachInOperand(
+    const std::function<bool(uint32_t*)>& f) {
+  return WhileEachInOperand<const std::function<bool(uint32_t*)>&>(f);
+}
+
+inline bool Instruction::WhileEachInOperand(
+    const std::function<bool(const uint32_t*)>& f) const {
+  return WhileEachInOperand<const std::function<bool(const uint32_t*)>&>(f);
+}
+
+inline void Instruction::ForEachInOperand(
+    const std::function<void(uint32_t*)>& f) {
+  ForEachInOperand<const std::function<void(uint32_t*)>&>(f);
+}
+
+inline void Instruction::ForEachInOperand(
+    const std::function<void(const uint32_t*)>& f) const {
+  ForEachInOperand<const std::function<void(const uint32_t*)>&>(f);
+}
+
 inline bool Instruction::HasLabels() const {
   switch (opcode_) {
     case SpvOpSelectionMerge:
@@ -21,6 +21,8 @@
 #include "source/opt/log.h"
 #include "source/opt/mem_pass.h"
 #include "source/opt/reflect.h"
+#include "source/util/bitutils.h"
+#include "source/util/parallel.h"
 
 namespace {
 
@@ -46,6 +48,9 @@ void IRContext::BuildInvalidAnalyses(IRContext::Analysis set) {
   if (set & kAnalysisDefUse) {
     BuildDefUseManager();
   }
+  if (set & kAnalysisCombinators) {
+    InitializeCombinators();
+  }
   if (set & kAnalysisInstrToBlockMapping) {
     BuildInstrToBlockMapping();
   }
@@ -93,6 +98,49 @@ void IRContext::BuildInvalidAnalyses(IRContext::Analysis set) {
   }
 }
 
+const char* IRContext::GetAnalysisName(Analysis analysis) {
+  switch (analysis) {
+    case kAnalysisDefUse:
+      return "def-use";
+    case kAnalysisInstrToBlockMapping:
+      return "instr-to-block";
+    case kAnalysisDecorations:
+      return "decorations";
+    case kAnalysisCombinators:
+      return "combinators";
+    case kAnalysisCFG:
+      return "cfg";
+    case kAnalysisDominatorAnalysis:
+      return "dominators";
+    case kAnalysisLoopAnalysis:
+      return "loops";
+    case kAnalysisNameMap:
+      return "names";
+    case kAnalysisScalarEvolution:
+      return "scalar-evolution";
+    case kAnalysisRegisterPressure:
+      return "register-pressure";
+    case kAnalysisValueNumberTable:
+      return "value-numbers";
+    case kAnalysisStructuredCFG:
+      return "structured-cfg";
+    case kAnalysisBuiltinVarId:
+      return "builtin-vars";
+    case kAnalysisIdToFuncMapping:
+      return "id-to-function";
+    case kAnalysisConstants:
+      return "constants";
+    case kAnalysisTypes:
+      return "types";
+    case kAnalysisDebugInfo:
+      return "debug-info";
+    default:
+      break;
+  }
+  assert(false && "Not a single analysis.");
+  return "";
+}
+
 void IRContext::InvalidateAnalysesExceptFor(
     IRContext::Analysis preserved_analyses) {
   uint32_t analyses_to_invalidate = valid_analyses_ & (~preserved_analyses);
@@ -160,6 +208,18 @@ void IRContext::InvalidateAnalyses(IRContext::Analysis analyses_to_invalidate) {
     debug_info_mgr_.reset(nullptr);
   }
 
+  const Analysis invalidated =
+      Analysis(valid_analyses_ & analyses_to_invalidate);
+  num_analyses_invalidated_ +=
+      static_cast<uint32_t>(utils::CountSetBits(uint32_t(invalidated)));
+  if (analysis_listener_) {
+    for (Analysis analysis = kAnalysisBegin; analysis < kAnalysisEnd;
+         analysis <<= 1) {
+      if (invalidated & analysis) {
+        analysis_listener_->OnAnalysisInvalidated(analysis);
+      }
+    }
+  }
   valid_analyses_ = Analysis(valid_analyses_ & ~analyses_to_invalidate);
 }
 
@@ -713,14 +773,13 @@ void IRContext::AddCombinatorsForExtension(Instruction* extension) {
 }
 
 void IRContext::InitializeCombinators() {
+  ScopedAnalysisBuild build(this, kAnalysisCombinators);
   get_feature_mgr()->GetCapabilities()->ForEach(
       [this](SpvCapability cap) { AddCombinatorsForCapability(cap); });
 
   for (auto& extension : module()->ext_inst_imports()) {
     AddCombinatorsForExtension(&extension);
   }
-
-  valid_analyses_ |= kAnalysisCombinators;
 }
 
 void IRContext::RemoveFromIdToName(const Instruction* inst) {
@@ -926,6 +985,22 @@ bool IRContext::ProcessCallTreeFromRoots(ProcessFunction& pfn,
   return modified;
 }
 
+void IRContext::AnalyzeFunctionsInParallel(
+    const std::vector<Function*>& functions, Analysis analyses,
+    const std::function<void(Function*, size_t)>& analyze) {
+  BuildInvalidAnalyses(analyses);
+  // Instructions build the feature manager on demand, as in
+  // Instruction::IsScalarizable, and passes may have reset it without
+  // invalidating any analysis, so it is built before the workers start.
+  get_feature_mgr();
+  const uint32_t num_threads =
+      num_threads_ == 0 ? utils::HardwareConcurrency() : num_threads_;
+  utils::ParallelFor(functions.size(), num_threads,
+                     [&functions, &analyze](size_t i) {
+                       analyze(functions[i], i);
+                     });
+}
+
 void IRContext::CollectCallTreeFromRoots(unsigned entryId,
                                          std::unordered_set<uint32_t>* funcs) {
   std::queue<uint32_t> roots;
@@ -1001,6 +1076,32 @@ PostDominatorAnalysis* IRContext::GetPostDominatorAnalysis(const Function* f) {
   return &post_dominator_trees_[f];
 }
 
+bool IRContext::SetDominatorAnalysis(const Function* f,
+                                     const DominatorTree::EdgeList& edges) {
+  if (!AreAnalysesValid(kAnalysisDominatorAnalysis)) {
+    ResetDominatorAnalysis();
+  }
+
+  if (!dominator_trees_[f].InitializeTree(*cfg(), f, edges)) {
+    dominator_trees_.erase(f);
+    return false;
+  }
+  return true;
+}
+
+bool IRContext::SetPostDominatorAnalysis(const Function* f,
+                                         const DominatorTree::EdgeList& edges) {
+  if (!AreAnalysesValid(kAnalysisDominatorAnalysis)) {
+    ResetDominatorAnalysis();
+  }
+
+  if (!post_dominator_trees_[f].InitializeTree(*cfg(), f, edges)) {
+    post_dominator_trees_.erase(f);
+    return false;
+  }
+  return true;
+}
+
 bool IRContext::CheckCFG() {
   std::unordered_map<uint32_t, std::vector<uint32_t>> real_preds;
   if (!AreAnalysesValid(kAnalysisCFG)) {
@@ -16,6 +16,7 @@
 #define SOURCE_OPT_IR_CONTEXT_H_
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -42,6 +43,7 @@
 #include "source/opt/struct_cfg_analysis.h"
 #include "source/opt/type_manager.h"
 #include "source/opt/value_number_table.h"
+#include "source/util/arena.h"
 #include "source/util/make_unique.h"
 #include "source/util/string_utils.h"
 
@@ -86,6 +88,19 @@ class IRContext {
 
   using ProcessFunction = std::function<bool(Function*)>;
 
+  // Receives the analysis events of a context, for instrumentation.
+  class AnalysisListener {
+   public:
+    virtual ~AnalysisListener() = default;
+
+    // Called after |analysis| was built, which took |seconds|.  The time
+    // includes that of the analyses built in turn, which are reported first.
+    virtual void OnAnalysisBuilt(Analysis analysis, double seconds) = 0;
+
+    // Called when |analysis|, which was valid, is invalidated.
+    virtual void OnAnalysisInvalidated(Analysis analysis) = 0;
+  };
+
   friend inline Analysis operator|(Analysis lhs, Analysis rhs);
   friend inline Analysis& operator|=(Analysis& lhs, Analysis rhs);
   friend inline Analysis operator<<(Analysis a, int shift);
@@ -106,7 +121,8 @@ class IRContext {
         id_to_name_(nullptr),
         max_id_bound_(kDefaultMaxIdBound),
         preserve_bindings_(false),
-        preserve_spec_constants_(false) {
+        preserve_spec_constants_(false),
+        num_threads_(1) {
     SetContextMessageConsumer(syntax_context_, consumer_);
     module_->SetContext(this);
   }
@@ -124,7 +140,8 @@ class IRContext {
         id_to_name_(nullptr),
         max_id_bound_(kDefaultMaxIdBound),
         preserve_bindings_(false),
-        preserve_spec_constants_(false) {
+        preserve_spec_constants_(false),
+        num_threads_(1) {
     SetContextMessageConsumer(syntax_context_, consumer_);
     module_->SetContext(this);
     InitializeCombinators();
@@ -134,6 +151,16 @@ class IRContext {
 
   Module* module() const { return module_.get(); }
 
+  // Creates the arena of this context, if it does not have one yet.  The arena
+  // is only used for allocations made while it is current; see
+  // utils::ArenaScope.  Objects allocated from it may outlive the context.
+  void EnableArenaAllocation() {
+    if (!arena_) arena_ = utils::Arena::Create();
+  }
+
+  // Returns the arena of this context, or nullptr if it does not have one.
+  utils::Arena* arena() const { return arena_.get(); }
+
   // Returns a vector of pointers to constant-creation instructions in this
   // context.
   inline std::vector<Instruction*> GetConstants();
@@ -418,6 +445,26 @@ class IRContext {
   // Returns true if all of the given analyses are valid.
   bool AreAnalysesValid(Analysis set) { return (set & valid_analyses_) == set; }
 
+  // Returns the number of analyses built since the context was created.  The
+  // dominator, loop and builtin analyses count when they are reset, since
+  // their results are then computed on demand.
+  uint32_t num_analyses_built() const { return num_analyses_built_; }
+
+  // Returns the number of valid analyses invalidated since the context was
+  // created.
+  uint32_t num_analyses_invalidated() const {
+    return num_analyses_invalidated_;
+  }
+
+  // Sets the listener of the analysis events of this context.  Null, the
+  // default, removes it.  The context does not own |listener|.
+  void SetAnalysisListener(AnalysisListener* listener) {
+    analysis_listener_ = listener;
+  }
+
+  // Returns a short name for |analysis|, which must be a single analysis.
+  static const char* GetAnalysisName(Analysis analysis);
+
   // Replaces all uses of |before| id with |after| id. Returns true if any
   // replacement happens. This method does not kill the definition of the
   // |before| id. If |after| is the same as |before|, does nothing and returns
@@ -470,7 +517,8 @@ class IRContext {
   }
 
   // Returns true if |inst| is a combinator in the current context.
-  // |combinator_ops_| is built if it has not been already.
+  // |combinator_ops_| is built if it has not been already.  Once it is built,
+  // this only reads it, so it can be called from several threads.
   inline bool IsCombinatorInstruction(const Instruction* inst) {
     if (!AreAnalysesValid(kAnalysisCombinators)) {
       InitializeCombinators();
@@ -478,13 +526,14 @@ class IRContext {
     const uint32_t kExtInstSetIdInIndx = 0;
     const uint32_t kExtInstInstructionInIndx = 1;
 
-    if (inst->opcode() != SpvOpExtInst) {
-      return combinator_ops_[0].count(inst->opcode()) != 0;
-    } else {
-      uint32_t set = inst->GetSingleWordInOperand(kExtInstSetIdInIndx);
-      uint32_t op = inst->GetSingleWordInOperand(kExtInstInstructionInIndx);
-      return combinator_ops_[set].count(op) != 0;
+    uint32_t set = 0;
+    uint32_t op = inst->opcode();
+    if (inst->opcode() == SpvOpExtInst) {
+      set = inst->GetSingleWordInOperand(kExtInstSetIdInIndx);
+      op = inst->GetSingleWordInOperand(kExtInstInstructionInIndx);
     }
+    const auto ops = combinator_ops_.find(set);
+    return ops != combinator_ops_.end() && ops->second.count(op) != 0;
   }
 
   // Returns a pointer to the CFG for all the functions in |module_|.
@@ -504,6 +553,18 @@ class IRContext {
   // Gets the postdominator analysis for function |f|.
   PostDominatorAnalysis* GetPostDominatorAnalysis(const Function* f);
 
+  // Sets the dominator analysis of function |f| to the tree with |edges|, as
+  // returned by DominatorTree::GetEdges for the dominator tree of a function
+  // with the same blocks, instead of computing it on demand.  Returns false,
+  // leaving the analysis of |f| to be computed on demand, if |edges| is not a
+  // tree of the blocks of |f|.
+  bool SetDominatorAnalysis(const Function* f,
+                            const DominatorTree::EdgeList& edges);
+
+  // Like SetDominatorAnalysis, for the postdominator analysis.
+  bool SetPostDominatorAnalysis(const Function* f,
+                                const DominatorTree::EdgeList& edges);
+
   // Remove the dominator tree of |f| from the cache.
   inline void RemoveDominatorAnalysis(const Function* f) {
     dominator_trees_.erase(f);
@@ -575,6 +636,11 @@ class IRContext {
     preserve_spec_constants_ = should_preserve_spec_constants;
   }
 
+  // The number of threads AnalyzeFunctionsInParallel may use, or 0 for one per
+  // hardware thread.
+  uint32_t num_threads() const { return num_threads_; }
+  void set_num_threads(uint32_t num_threads) { num_threads_ = num_threads; }
+
   // Return id of input variable only decorated with |builtin|, if in module.
   // Create variable and return its id otherwise. If builtin not currently
   // supported, return 0.
@@ -617,6 +683,18 @@ class IRContext {
   bool ProcessCallTreeFromRoots(ProcessFunction& pfn,
                                 std::queue<uint32_t>* roots);
 
+  // Calls |analyze| with every function in |functions| and its index, on up to
+  // num_threads() threads, and returns once every call has finished.  The
+  // analyses in |analyses| are built first.  The calls run concurrently, so
+  // they must not change the module or any analysis, must only use the
+  // analyses in |analyses|, and must only write to state private to their
+  // index.  The feature manager is also built first.  Function-local passes
+  // use this to find what to change in each function, and then make the
+  // changes on the calling thread.
+  void AnalyzeFunctionsInParallel(
+      const std::vector<Function*>& functions, Analysis analyses,
+      const std::function<void(Function*, size_t)>& analyze);
+
   // Emits a error message to the message consumer indicating the error
   // described by |message| occurred in |inst|.
   void EmitErrorMessage(std::string message, Instruction* inst);
@@ -626,14 +704,42 @@ class IRContext {
   bool IsReachable(const opt::BasicBlock& bb);
 
  private:
+  // Marks an analysis as valid once the scope building it ends, and reports
+  // the time the build took to the analysis listener.
+  class ScopedAnalysisBuild {
+   public:
+    ScopedAnalysisBuild(IRContext* context, Analysis analysis)
+        : context_(context), analysis_(analysis) {
+      if (context_->analysis_listener_) {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+    ~ScopedAnalysisBuild() {
+      context_->valid_analyses_ = context_->valid_analyses_ | analysis_;
+      ++context_->num_analyses_built_;
+      if (context_->analysis_listener_) {
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_;
+        context_->analysis_listener_->OnAnalysisBuilt(analysis_,
+                                                      elapsed.count());
+      }
+    }
+
+   private:
+    IRContext* context_;
+    Analysis analysis_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
   // Builds the def-use manager from scratch, even if it was already valid.
   void BuildDefUseManager() {
+    ScopedAnalysisBuild build(this, kAnalysisDefUse);
     def_use_mgr_ = MakeUnique<analysis::DefUseManager>(module());
-    valid_analyses_ = valid_analyses_ | kAnalysisDefUse;
   }
 
   // Builds the instruction-block map for the whole module.
   void BuildInstrToBlockMapping() {
+    ScopedAnalysisBuild build(this, kAnalysisInstrToBlockMapping);
     instr_to_block_.clear();
     for (auto& fn : *module_) {
       for (auto& block : fn) {
@@ -642,95 +748,94 @@ class IRContext {
         });
       }
     }
-    valid_analyses_ = valid_analyses_ | kAnalysisInstrToBlockMapping;
   }
 
   // Builds the instruction-function map for the whole module.
   void BuildIdToFuncMapping() {
+    ScopedAnalysisBuild build(this, kAnalysisIdToFuncMapping);
     id_to_func_.clear();
     for (auto& fn : *module_) {
       id_to_func_[fn.result_id()] = &fn;
     }
-    valid_analyses_ = valid_analyses_ | kAnalysisIdToFuncMapping;
   }
 
   void BuildDecorationManager() {
+    ScopedAnalysisBuild build(this, kAnalysisDecorations);
     decoration_mgr_ = MakeUnique<analysis::DecorationManager>(module());
-    valid_analyses_ = valid_analyses_ | kAnalysisDecorations;
   }
 
   void BuildCFG() {
+    ScopedAnalysisBuild build(this, kAnalysisCFG);
     cfg_ = MakeUnique<CFG>(module());
-    valid_analyses_ = valid_analyses_ | kAnalysisCFG;
   }
 
   void BuildScalarEvolutionAnalysis() {
+    ScopedAnalysisBuild build(this, kAnalysisScalarEvolution);
     scalar_evolution_analysis_ = MakeUnique<ScalarEvolutionAnalysis>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisScalarEvolution;
   }
 
   // Builds the liveness analysis from scratch, even if it was already valid.
   void BuildRegPressureAnalysis() {
+    ScopedAnalysisBuild build(this, kAnalysisRegisterPressure);
     reg_pressure_ = MakeUnique<LivenessAnalysis>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisRegisterPressure;
   }
 
   // Builds the value number table analysis from scratch, even if it was already
   // valid.
   void BuildValueNumberTable() {
+    ScopedAnalysisBuild build(this, kAnalysisValueNumberTable);
     vn_table_ = MakeUnique<ValueNumberTable>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisValueNumberTable;
   }
 
   // Builds the structured CFG analysis from scratch, even if it was already
   // valid.
   void BuildStructuredCFGAnalysis() {
+    ScopedAnalysisBuild build(this, kAnalysisStructuredCFG);
     struct_cfg_analysis_ = MakeUnique<StructuredCFGAnalysis>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisStructuredCFG;
   }
 
   // Builds the constant manager from scratch, even if it was already
   // valid.
   void BuildConstantManager() {
+    ScopedAnalysisBuild build(this, kAnalysisConstants);
     constant_mgr_ = MakeUnique<analysis::ConstantManager>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisConstants;
   }
 
   // Builds the type manager from scratch, even if it was already
   // valid.
   void BuildTypeManager() {
+    ScopedAnalysisBuild build(this, kAnalysisTypes);
     type_mgr_ = MakeUnique<analysis::TypeManager>(consumer(), this);
-    valid_analyses_ = valid_analyses_ | kAnalysisTypes;
   }
 
   // Builds the debug information manager from scratch, even if it was
   // already valid.
   void BuildDebugInfoManager() {
+    ScopedAnalysisBuild build(this, kAnalysisDebugInfo);
     debug_info_mgr_ = MakeUnique<analysis::DebugInfoManager>(this);
-    valid_analyses_ = valid_analyses_ | kAnalysisDebugInfo;
   }
 
   // Removes all computed dominator and post-dominator trees. This will force
   // the context to rebuild the trees on demand.
   void ResetDominatorAnalysis() {
+    ScopedAnalysisBuild build(this, kAnalysisDominatorAnalysis);
     // Clear the cache.
     dominator_trees_.clear();
     post_dominator_trees_.clear();
-    valid_analyses_ = valid_analyses_ | kAnalysisDominatorAnalysis;
   }
 
   // Removes all computed loop descriptors.
   void ResetLoopAnalysis() {
+    ScopedAnalysisBuild build(this, kAnalysisLoopAnalysis);
     // Clear the cache.
     loop_descriptors_.clear();
-    valid_analyses_ = valid_analyses_ | kAnalysisLoopAnalysis;
   }
 
   // Removes all computed loop descriptors.
   void ResetBuiltinAnalysis() {
+    ScopedAnalysisBuild build(this, kAnalysisBuiltinVarId);
     // Clear the cache.
     builtin_var_id_map_.clear();
-    valid_analyses_ = valid_analyses_ | kAnalysisBuiltinVarId;
   }
 
   // Analyzes the features in the owned module. Builds the manager if required.
@@ -780,6 +885,10 @@ class IRContext {
   // The module being processed within this IR context.
   std::unique_ptr<Module> module_;
 
+  // The arena holding the instructions and basic blocks of |module_| that were
+  // created while it was current, or nullptr if arena allocation is not used.
+  utils::Arena::Ptr arena_;
+
   // A message consumer for diagnostics.
   MessageConsumer consumer_;
 
@@ -808,6 +917,11 @@ class IRContext {
 
   // A bitset indicating which analyzes are currently valid.
   Analysis valid_analyses_;
+  // The number of analyses built and invalidated so far.
+  uint32_t num_analyses_built_ = 0;
+  uint32_t num_analyses_invalidated_ = 0;
+  // The listener of the analysis events, if any.
+  AnalysisListener* analysis_listener_ = nullptr;
 
   // Opcodes of shader capability core executable instructions
   // without side-effect.
@@ -861,6 +975,9 @@ class IRContext {
   // Whether all specialization constants within |module_|
   // should be preserved.
   bool preserve_spec_constants_;
+
+  // The number of threads AnalyzeFunctionsInParallel may use.
+  uint32_t num_threads_;
 };
 
 inline IRContext::Analysis operator|(IRContext::Analysis lhs,
@@ -1149,6 +1266,7 @@ void IRContext::UpdateDefUse(Instruction* inst) {
 }
 
 void IRContext::BuildIdToNameMap() {
+  ScopedAnalysisBuild build(this, kAnalysisNameMap);
   id_to_name_ = MakeUnique<std::multimap<uint32_t, Instruction*>>();
   for (Instruction& debug_inst : debugs2()) {
     if (debug_inst.opcode() == SpvOpMemberName ||
@@ -1156,7 +1274,6 @@ void IRContext::BuildIdToNameMap() {
       id_to_name_->insert({debug_inst.GetSingleWordInOperand(0), &debug_inst});
     }
   }
-  valid_analyses_ = valid_analyses_ | kAnalysisNameMap;
 }
 
 IteratorRange<std::multimap<uint32_t, Instruction*>::iterator>
@@ -14,14 +14,17 @@
 
 #include "source/opt/ir_loader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "DebugInfo.h"
 #include "OpenCLDebugInfo100.h"
 #include "source/ext_inst.h"
+#include "source/operand.h"
 #include "source/opt/ir_context.h"
 #include "source/opt/log.h"
 #include "source/opt/reflect.h"
+#include "source/util/arena.h"
 #include "source/util/make_unique.h"
 
 static const uint32_t kExtInstSetIndex = 4;
@@ -51,8 +54,61 @@ bool IsLineInst(const spv_parsed_instruction_t* inst) {
          ext_inst_key == NonSemanticShaderDebugInfo100DebugNoLine;
 }
 
+void DeferredFunctions::AddInstruction(const spv_parsed_instruction_t& inst) {
+  records_.push_back({inst, words_.size(), operands_.size()});
+  words_.insert(words_.end(), inst.words, inst.words + inst.num_words);
+  operands_.insert(operands_.end(), inst.operands,
+                   inst.operands + inst.num_operands);
+  for (uint16_t i = 0; i < inst.num_operands; ++i) {
+    const spv_parsed_operand_t& operand = inst.operands[i];
+    if (spvIsIdType(operand.type)) {
+      max_id_ = std::max(max_id_, inst.words[operand.offset]);
+    }
+  }
+
+  const auto opcode = static_cast<SpvOp>(inst.opcode);
+  if (opcode == SpvOpNop || IsLineInst(&inst) ||
+      (opcode == SpvOpExtInst && spvExtInstIsDebugInfo(inst.ext_inst_type))) {
+    must_load_with_module_ = true;
+  }
+}
+
+bool DeferredFunctions::Load(Module* module) const {
+  IRContext* context = module->context();
+  IrLoader loader(context->consumer(), module);
+  loader.SetExtraLineTracking(extra_line_tracking_);
+  utils::ArenaScope arena_scope(context->arena());
+
+  bool succeeded = true;
+  for (const Record& record : records_) {
+    spv_parsed_instruction_t inst = record.inst;
+    inst.words = &words_[record.first_word];
+    inst.operands =
+        inst.num_operands ? &operands_[record.first_operand] : nullptr;
+    if (!loader.AddInstruction(&inst)) {
+      succeeded = false;
+      break;
+    }
+  }
+  loader.EndModule();
+  return succeeded;
+}
+
+void DeferredFunctions::ToBinary(std::vector<uint32_t>* binary) const {
+  binary->insert(binary->end(), words_.begin(), words_.end());
+}
+
 bool IrLoader::AddInstruction(const spv_parsed_instruction_t* inst) {
   ++inst_index_;
+  if (defer_functions_ && !deferred_functions_ &&
+      inst->opcode == SpvOpFunction && !module()->ContainsDebugInfo()) {
+    deferred_functions_ = MakeUnique<DeferredFunctions>(extra_line_tracking_);
+  }
+  if (deferred_functions_) {
+    deferred_functions_->AddInstruction(*inst);
+    return true;
+  }
+
   if (IsLineInst(inst)) {
     module()->SetContainsDebugInfo();
     last_line_inst_.reset();
@@ -341,7 +397,15 @@ bool IrLoader::AddInstruction(const spv_parsed_instruction_t* inst) {
 
 // Resolves internal references among the module, functions, basic blocks, etc.
 // This function should be called after adding all instructions.
-void IrLoader::EndModule() {
+bool IrLoader::EndModule() {
+  if (deferred_functions_) {
+    std::unique_ptr<DeferredFunctions> deferred =
+        std::move(deferred_functions_);
+    if (deferred->MustLoadWithModule()) return deferred->Load(module_);
+    module_->SetDeferredFunctions(std::move(deferred));
+    return true;
+  }
+
   if (block_ && function_) {
     // We're in the middle of a basic block, but the terminator is missing.
     // Register the block anyway.  This lets us write tests with less
@@ -362,6 +426,7 @@ void IrLoader::EndModule() {
 
   // Copy any trailing Op*Line instruction into the module
   module_->SetTrailingDbgLineInfo(std::move(dbg_line_info_));
+  return true;
 }
 
 }  // namespace opt
@@ -27,6 +27,55 @@
 namespace spvtools {
 namespace opt {
 
+// The functions of a module as they were read from its binary, kept so that
+// their in-memory IR is only built if something accesses it.  The parsed
+// instructions are copied, so the binary is not needed afterwards.
+class DeferredFunctions {
+ public:
+  explicit DeferredFunctions(bool extra_line_tracking)
+      : extra_line_tracking_(extra_line_tracking) {}
+
+  // Records the parsed instruction |inst|.
+  void AddInstruction(const spv_parsed_instruction_t& inst);
+
+  // Builds the recorded functions and adds them to |module|.  Returns false if
+  // the instructions do not form valid functions; the functions built until
+  // then are still added.
+  bool Load(Module* module) const;
+
+  // Appends the recorded instructions to |binary|, as they were read.
+  void ToBinary(std::vector<uint32_t>* binary) const;
+
+  // Returns true if the functions must be built along with the rest of the
+  // module.  This is the case when they contain OpNop, which ToBinary would
+  // not drop, or debug line or scope instructions, which the loader tracks
+  // across the whole module.
+  bool MustLoadWithModule() const { return must_load_with_module_; }
+
+  // Returns the largest id mentioned by the recorded instructions.
+  uint32_t max_id() const { return max_id_; }
+
+  // Returns the number of recorded instructions.
+  size_t num_insts() const { return records_.size(); }
+
+ private:
+  // A recorded instruction.  The words and operands of |inst| are stored in
+  // |words_| and |operands_| from the given positions on, and its pointers
+  // are only set when it is loaded.
+  struct Record {
+    spv_parsed_instruction_t inst;
+    size_t first_word;
+    size_t first_operand;
+  };
+
+  std::vector<Record> records_;
+  std::vector<uint32_t> words_;
+  std::vector<spv_parsed_operand_t> operands_;
+  uint32_t max_id_ = 0;
+  bool must_load_with_module_ = false;
+  bool extra_line_tracking_;
+};
+
 // Loader class for constructing SPIR-V in-memory IR representation. Methods in
 // this class are designed to work with the interface for spvBinaryParse() in
 // libspirv.h so that we can leverage the syntax checks implemented behind it.
@@ -60,13 +109,20 @@ class IrLoader {
   // Finalizes the module construction. This must be called after the module
   // header has been set and all instructions have been added.  This is
   // forgiving in the case of a missing terminator instruction on a basic block,
-  // or a missing OpFunctionEnd.  Resolves internal bookkeeping.
-  void EndModule();
+  // or a missing OpFunctionEnd.  Resolves internal bookkeeping.  Returns
+  // false if the functions were deferred but had to be built now and are not
+  // valid.
+  bool EndModule();
 
   // Sets whether extra OpLine instructions should be injected to better
   // track line information.
   void SetExtraLineTracking(bool flag) { extra_line_tracking_ = flag; }
 
+  // Sets whether building the functions of the module should be deferred
+  // until they are accessed.  See Module::HasDeferredFunctions.  Modules with
+  // debug line or scope information are always built completely.
+  void SetDeferFunctions(bool flag) { defer_functions_ = flag; }
+
  private:
   // Consumer for communicating messages to outside.
   const MessageConsumer& consumer_;
@@ -93,6 +149,11 @@ class IrLoader {
   // instructions will be injected to help track line info more robustly during
   // transformations.
   bool extra_line_tracking_ = true;
+
+  // When true, the instructions from the first OpFunction on are recorded in
+  // |deferred_functions_| instead of being built.
+  bool defer_functions_ = false;
+  std::unique_ptr<DeferredFunctions> deferred_functions_;
 };
 
 }  // namespace opt
@@ -23,19 +23,60 @@ Pass::Status LocalRedundancyEliminationPass::Process() {
   bool modified = false;
   ValueNumberTable vnTable(context());
 
+  std::vector<Function*> functions;
   for (auto& func : *get_module()) {
-    for (auto& bb : func) {
-      // Keeps track of all ids that contain a given value number. We keep
-      // track of multiple values because they could have the same value, but
-      // different decorations.
-      std::map<uint32_t, uint32_t> value_to_ids;
-      if (EliminateRedundanciesInBB(&bb, vnTable, &value_to_ids))
-        modified = true;
+    functions.push_back(&func);
+  }
+
+  // The value numbers are computed before anything is deleted, and a block
+  // only keeps the first id of each value, so the redundant instructions of
+  // every function can be found concurrently before any of them is deleted.
+  std::vector<std::vector<Redundancy>> redundancies(functions.size());
+  context()->AnalyzeFunctionsInParallel(
+      functions, IRContext::kAnalysisNone,
+      [this, &vnTable, &redundancies](Function* function, size_t i) {
+        FindRedundancies(function, vnTable, &redundancies[i]);
+      });
+
+  for (const auto& function_redundancies : redundancies) {
+    for (const Redundancy& redundancy : function_redundancies) {
+      Instruction* inst = redundancy.first;
+      context()->KillNamesAndDecorates(inst);
+      context()->ReplaceAllUsesWith(inst->result_id(), redundancy.second);
+      context()->KillInst(inst);
+      modified = true;
     }
   }
   return (modified ? Status::SuccessWithChange : Status::SuccessWithoutChange);
 }
 
+void LocalRedundancyEliminationPass::FindRedundancies(
+    Function* function, const ValueNumberTable& vnTable,
+    std::vector<Redundancy>* redundancies) const {
+  for (auto& bb : *function) {
+    // Keeps track of all ids that contain a given value number. We keep
+    // track of multiple values because they could have the same value, but
+    // different decorations.
+    std::map<uint32_t, uint32_t> value_to_ids;
+    bb.ForEachInst([&vnTable, &value_to_ids, redundancies](Instruction* inst) {
+      if (inst->result_id() == 0) {
+        return;
+      }
+
+      uint32_t value = vnTable.GetValueNumber(inst);
+
+      if (value == 0) {
+        return;
+      }
+
+      auto candidate = value_to_ids.insert({value, inst->result_id()});
+      if (!candidate.second) {
+        redundancies->emplace_back(inst, candidate.first->second);
+      }
+    });
+  }
+}
+
 bool LocalRedundancyEliminationPass::EliminateRedundanciesInBB(
     BasicBlock* block, const ValueNumberTable& vnTable,
     std::map<uint32_t, uint32_t>* value_to_ids) {
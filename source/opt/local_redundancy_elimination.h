@@ -16,6 +16,8 @@
 #define SOURCE_OPT_LOCAL_REDUNDANCY_ELIMINATION_H_
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "source/opt/ir_context.h"
 #include "source/opt/pass.h"
@@ -60,6 +62,18 @@ class LocalRedundancyEliminationPass : public Pass {
   bool EliminateRedundanciesInBB(BasicBlock* block,
                                  const ValueNumberTable& vnTable,
                                  std::map<uint32_t, uint32_t>* value_to_ids);
+
+ private:
+  // An instruction whose value is computed earlier in its block, and the id
+  // that computes it first.
+  using Redundancy = std::pair<Instruction*, uint32_t>;
+
+  // Appends to |redundancies| the instructions of |function| that
+  // EliminateRedundanciesInBB would delete, in the order it would delete them.
+  // Only reads |function| and |vnTable|, so it may run on several functions
+  // at once.
+  void FindRedundancies(Function* function, const ValueNumberTable& vnTable,
+                        std::vector<Redundancy>* redundancies) const;
 };
 
 }  // namespace opt
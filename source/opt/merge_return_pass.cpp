@@ -694,11 +694,12 @@ void MergeReturnPass::MergeReturnBlocks(
 
     // Register the phi def and mark instructions for use updates.
     get_def_use_mgr()->AnalyzeInstDefUse(&*phiIter);
-    get_def_use_mgr()->AnalyzeInstDef(&*ret);
+    get_def_use_mgr()->AnalyzeInstDefUse(&*ret);
   } else {
     std::unique_ptr<Instruction> return_inst(
         new Instruction(context(), SpvOpReturn));
     ret_block_iter->AddInstruction(std::move(return_inst));
+    get_def_use_mgr()->AnalyzeInstDefUse(ret_block_iter->terminator());
   }
 
   // Replace returns with branches
@@ -20,6 +20,8 @@
 
 #include "source/operand.h"
 #include "source/opt/ir_context.h"
+#include "source/opt/ir_loader.h"
+#include "source/opt/log.h"
 #include "source/opt/reflect.h"
 
 namespace spvtools {
@@ -83,8 +85,32 @@ void Module::AddGlobalValue(SpvOp opcode, uint32_t result_id,
   AddGlobalValue(std::move(newGlobal));
 }
 
+Module::Module() : header_({}), contains_debug_info_(false) {}
+
+Module::~Module() = default;
+
+void Module::SetDeferredFunctions(
+    std::unique_ptr<DeferredFunctions> functions) {
+  assert(functions_.empty() && "Functions were already built.");
+  deferred_functions_ = std::move(functions);
+}
+
+void Module::LoadDeferredFunctions() const {
+  // The loader adds the functions through the accessors of the module, so the
+  // deferred functions are taken out first.  Building them does not change
+  // the module as seen through its interface, which is why const accessors
+  // may do it.
+  std::unique_ptr<DeferredFunctions> deferred = std::move(deferred_functions_);
+  if (!deferred->Load(const_cast<Module*>(this))) {
+    failed_to_build_functions_ = true;
+    Error(context_->consumer(), nullptr, {},
+          "The functions of the module are not valid");
+  }
+}
+
 void Module::ForEachInst(const std::function<void(Instruction*)>& f,
                          bool run_on_debug_line_insts) {
+  MaterializeFunctions();
 #define DELEGATE(list) list.ForEachInst(f, run_on_debug_line_insts)
   DELEGATE(capabilities_);
   DELEGATE(extensions_);
@@ -109,6 +135,23 @@ void Module::ForEachInst(const std::function<void(Instruction*)>& f,
 
 void Module::ForEachInst(const std::function<void(const Instruction*)>& f,
                          bool run_on_debug_line_insts) const {
+  ForEachInstBeforeFunctions(f, run_on_debug_line_insts);
+  MaterializeFunctions();
+  for (auto& i : functions_) {
+    static_cast<const Function*>(i.get())->ForEachInst(
+        f, run_on_debug_line_insts,
+        /* run_on_non_semantic_insts = */ true);
+  }
+  if (run_on_debug_line_insts) {
+    for (auto& i : trailing_dbg_line_info_) {
+      i.ForEachInst(f, run_on_debug_line_insts);
+    }
+  }
+}
+
+void Module::ForEachInstBeforeFunctions(
+    const std::function<void(const Instruction*)>& f,
+    bool run_on_debug_line_insts) const {
 #define DELEGATE(i) i.ForEachInst(f, run_on_debug_line_insts)
   for (auto& i : capabilities_) DELEGATE(i);
   for (auto& i : extensions_) DELEGATE(i);
@@ -127,14 +170,6 @@ void Module::ForEachInst(const std::function<void(const Instruction*)>& f,
   for (auto& i : annotations_) DELEGATE(i);
   for (auto& i : types_values_) DELEGATE(i);
   for (auto& i : ext_inst_debuginfo_) DELEGATE(i);
-  for (auto& i : functions_) {
-    static_cast<const Function*>(i.get())->ForEachInst(
-        f, run_on_debug_line_insts,
-        /* run_on_non_semantic_insts = */ true);
-  }
-  if (run_on_debug_line_insts) {
-    for (auto& i : trailing_dbg_line_info_) DELEGATE(i);
-  }
 #undef DELEGATE
 }
 
@@ -230,7 +265,14 @@ void Module::ToBinary(std::vector<uint32_t>* binary, bool skip_nop) const {
       last_line_inst = i;
     }
   };
-  ForEachInst(write_inst, true);
+  if (deferred_functions_) {
+    // The functions were not built, so they are written as they were read.
+    // They cannot contain anything |write_inst| would change.
+    ForEachInstBeforeFunctions(write_inst, true);
+    deferred_functions_->ToBinary(binary);
+  } else {
+    ForEachInst(write_inst, true);
+  }
 
   // We create new instructions for DebugScope and DebugNoLine. The bound must
   // be updated.
@@ -240,19 +282,36 @@ void Module::ToBinary(std::vector<uint32_t>* binary, bool skip_nop) const {
 uint32_t Module::ComputeIdBound() const {
   uint32_t highest = 0;
 
-  ForEachInst(
-      [&highest](const Instruction* inst) {
-        for (const auto& operand : *inst) {
-          if (spvIsIdType(operand.type)) {
-            highest = std::max(highest, operand.words[0]);
-          }
-        }
-      },
-      true /* scan debug line insts as well */);
+  auto scan = [&highest](const Instruction* inst) {
+    for (const auto& operand : *inst) {
+      if (spvIsIdType(operand.type)) {
+        highest = std::max(highest, operand.words[0]);
+      }
+    }
+  };
+  if (deferred_functions_) {
+    // The ids of the functions were recorded when they were read.
+    ForEachInstBeforeFunctions(scan, true /* scan debug line insts as well */);
+    highest = std::max(highest, deferred_functions_->max_id());
+  } else {
+    ForEachInst(scan, true /* scan debug line insts as well */);
+  }
 
   return highest + 1;
 }
 
+size_t Module::NumInsts() const {
+  size_t num_insts = 0;
+  auto count = [&num_insts](const Instruction*) { ++num_insts; };
+  if (deferred_functions_) {
+    ForEachInstBeforeFunctions(count, false);
+    num_insts += deferred_functions_->num_insts();
+  } else {
+    ForEachInst(count, false);
+  }
+  return num_insts;
+}
+
 bool Module::HasExplicitCapability(uint32_t cap) {
   for (auto& ci : capabilities_) {
     uint32_t tcap = ci.GetSingleWordOperand(0);
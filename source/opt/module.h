@@ -28,6 +28,7 @@
 namespace spvtools {
 namespace opt {
 
+class DeferredFunctions;
 class IRContext;
 
 // A struct for containing the module header information.
@@ -49,7 +50,8 @@ class Module {
   using const_inst_iterator = InstructionList::const_iterator;
 
   // Creates an empty module with zero'd header.
-  Module() : header_({}), contains_debug_info_(false) {}
+  Module();
+  ~Module();
 
   // Sets the header to the given |header|.
   void SetHeader(const ModuleHeader& header) { header_ = header; }
@@ -122,6 +124,25 @@ class Module {
   // Appends a function to this module.
   inline void AddFunction(std::unique_ptr<Function> f);
 
+  // Sets the functions of the module to |functions|, which are only built
+  // when something accesses them: the function iterators, AddFunction and
+  // ForEachInst build them first.  ToBinary and ComputeIdBound do not, and
+  // use the functions as they were read.  Errors in the functions are only
+  // reported to the consumer of the context when they are built, after which
+  // FailedToBuildFunctions returns true.  The module must not have any
+  // function yet.
+  //
+  // Building the functions is not thread-safe, so the first access must not
+  // race with any other.
+  void SetDeferredFunctions(std::unique_ptr<DeferredFunctions> functions);
+
+  // Returns true if the functions of the module were not built yet.
+  bool HasDeferredFunctions() const { return deferred_functions_ != nullptr; }
+
+  // Returns true if building the deferred functions failed because they are
+  // not valid.  The functions built until the error are in the module.
+  bool FailedToBuildFunctions() const { return failed_to_build_functions_; }
+
   // Sets |contains_debug_info_| as true.
   inline void SetContainsDebugInfo();
   inline bool ContainsDebugInfo() { return contains_debug_info_; }
@@ -241,8 +262,14 @@ class Module {
   inline IteratorRange<const_inst_iterator> types_values() const;
 
   // Iterators for functions contained in this module.
-  iterator begin() { return iterator(&functions_, functions_.begin()); }
-  iterator end() { return iterator(&functions_, functions_.end()); }
+  iterator begin() {
+    MaterializeFunctions();
+    return iterator(&functions_, functions_.begin());
+  }
+  iterator end() {
+    MaterializeFunctions();
+    return iterator(&functions_, functions_.end());
+  }
   const_iterator begin() const { return cbegin(); }
   const_iterator end() const { return cend(); }
   inline const_iterator cbegin() const;
@@ -262,6 +289,10 @@ class Module {
   // Returns 1 more than the maximum Id value mentioned in the module.
   uint32_t ComputeIdBound() const;
 
+  // Returns the number of instructions in the module, not counting debug line
+  // instructions.
+  size_t NumInsts() const;
+
   // Returns true if module has capability |cap|
   bool HasExplicitCapability(uint32_t cap);
 
@@ -289,6 +320,19 @@ class Module {
   }
 
  private:
+  // Builds the deferred functions, if there are any.
+  void MaterializeFunctions() const {
+    if (deferred_functions_) LoadDeferredFunctions();
+  }
+  void LoadDeferredFunctions() const;
+
+  // Invokes function |f| on the instructions in this module that come before
+  // the functions, and optionally on the debug line instructions that precede
+  // them.
+  void ForEachInstBeforeFunctions(
+      const std::function<void(const Instruction*)>& f,
+      bool run_on_debug_line_insts) const;
+
   ModuleHeader header_;  // Module header
 
   // The following fields respect the "Logical Layout of a Module" in
@@ -311,6 +355,10 @@ class Module {
   // Type declarations, constants, and global variable declarations.
   InstructionList types_values_;
   std::vector<std::unique_ptr<Function>> functions_;
+  // The functions as they were read, until they are built.
+  mutable std::unique_ptr<DeferredFunctions> deferred_functions_;
+  // Whether building |deferred_functions_| failed.
+  mutable bool failed_to_build_functions_ = false;
 
   // If the module ends with Op*Line instruction, they will not be attached to
   // any instruction.  We record them here, so they will not be lost.
@@ -380,6 +428,7 @@ inline void Module::AddGlobalValue(std::unique_ptr<Instruction> v) {
 }
 
 inline void Module::AddFunction(std::unique_ptr<Function> f) {
+  MaterializeFunctions();
   functions_.emplace_back(std::move(f));
 }
 
@@ -536,10 +585,12 @@ inline IteratorRange<Module::const_inst_iterator> Module::types_values() const {
 }
 
 inline Module::const_iterator Module::cbegin() const {
+  MaterializeFunctions();
   return const_iterator(&functions_, functions_.cbegin());
 }
 
 inline Module::const_iterator Module::cend() const {
+  MaterializeFunctions();
   return const_iterator(&functions_, functions_.cend());
 }
 
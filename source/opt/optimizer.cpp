@@ -15,12 +15,16 @@
 #include "spirv-tools/optimizer.hpp"
 
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "source/opt/analysis_snapshot.h"
 #include "source/opt/build_module.h"
 #include "source/opt/graphics_robust_access_pass.h"
 #include "source/opt/log.h"
@@ -28,6 +32,7 @@
 #include "source/opt/passes.h"
 #include "source/spirv_optimizer_options.h"
 #include "source/util/make_unique.h"
+#include "source/util/result_cache.h"
 #include "source/util/string_utils.h"
 
 namespace spvtools {
@@ -56,12 +61,64 @@ Optimizer::PassToken& Optimizer::PassToken::operator=(PassToken&& that) {
 Optimizer::PassToken::~PassToken() {}
 
 struct Optimizer::Impl {
-  explicit Impl(spv_target_env env) : target_env(env), pass_manager() {}
+  explicit Impl(spv_target_env env)
+      : target_env(env),
+        pass_manager(),
+        pass_flags(),
+        flag_depth(0),
+        has_unflagged_passes(false) {}
+
+  // Attributes the passes registered during its lifetime to |flag|, unless
+  // they are already attributed to an enclosing flag.
+  class FlagScope {
+   public:
+    FlagScope(Impl* impl, const std::string& flag) : impl_(impl) {
+      if (impl_->flag_depth++ == 0) impl_->pass_flags.push_back(flag);
+    }
+    ~FlagScope() { --impl_->flag_depth; }
+
+   private:
+    Impl* impl_;
+  };
+
+  // Returns a description of everything but the module that determines the
+  // result of Run with |opt_options|, for keying the result cache.
+  std::string CacheConfig(const spv_optimizer_options opt_options) const;
 
   spv_target_env target_env;      // Target environment.
   opt::PassManager pass_manager;  // Internal implementation pass manager.
+
+  // The flags, or recipe names, that the registered passes were created from.
+  std::vector<std::string> pass_flags;
+  // The number of FlagScopes alive.
+  uint32_t flag_depth;
+  // Whether a pass was registered directly rather than through a flag or a
+  // recipe.  The configuration of such a pass is unknown, so results are not
+  // cached.
+  bool has_unflagged_passes;
+  // The observer set through SetPassObserver.
+  PassObserver pass_observer;
 };
 
+std::string Optimizer::Impl::CacheConfig(
+    const spv_optimizer_options opt_options) const {
+  std::ostringstream config;
+  config << "version " << spvSoftwareVersionDetailsString() << "\n"
+         << "target-env " << target_env << "\n";
+  for (const std::string& flag : pass_flags) config << flag << "\n";
+
+  config << "run-validator " << opt_options->run_validator_ << "\n"
+         << "max-id-bound " << opt_options->max_id_bound_ << "\n"
+         << "preserve-bindings " << opt_options->preserve_bindings_ << "\n"
+         << "preserve-spec-constants " << opt_options->preserve_spec_constants_
+         << "\n";
+  if (opt_options->run_validator_) {
+    // The validator options decide whether a module is rejected.
+    config << spvValidatorOptionsCacheConfig(opt_options->val_options_);
+  }
+  return config.str();
+}
+
 Optimizer::Optimizer(spv_target_env env) : impl_(new Impl(env)) {
   assert(env != SPV_ENV_WEBGPU_0);
 }
@@ -81,6 +138,7 @@ const MessageConsumer& Optimizer::consumer() const {
 }
 
 Optimizer& Optimizer::RegisterPass(PassToken&& p) {
+  if (impl_->flag_depth == 0) impl_->has_unflagged_passes = true;
   // Change to use the pass manager's consumer.
   p.impl_->pass->SetMessageConsumer(consumer());
   impl_->pass_manager.AddPass(std::move(p.impl_->pass));
@@ -109,6 +167,7 @@ Optimizer& Optimizer::RegisterPass(PassToken&& p) {
 // problem.  The optimization we use are all used to either do copy propagation
 // or enable more copy propagation.
 Optimizer& Optimizer::RegisterLegalizationPasses() {
+  Impl::FlagScope flag_scope(impl_.get(), "--legalize-hlsl");
   return
       // Wrap OpKill instructions so all other code can be inlined.
       RegisterPass(CreateWrapOpKillPass())
@@ -160,6 +219,7 @@ Optimizer& Optimizer::RegisterLegalizationPasses() {
 }
 
 Optimizer& Optimizer::RegisterPerformancePasses() {
+  Impl::FlagScope flag_scope(impl_.get(), "-O");
   return RegisterPass(CreateWrapOpKillPass())
       .RegisterPass(CreateDeadBranchElimPass())
       .RegisterPass(CreateMergeReturnPass())
@@ -207,6 +267,7 @@ Optimizer& Optimizer::RegisterPerformancePasses() {
 }
 
 Optimizer& Optimizer::RegisterSizePasses() {
+  Impl::FlagScope flag_scope(impl_.get(), "-Os");
   return RegisterPass(CreateWrapOpKillPass())
       .RegisterPass(CreateDeadBranchElimPass())
       .RegisterPass(CreateMergeReturnPass())
@@ -271,6 +332,7 @@ bool Optimizer::RegisterPassFromFlag(const std::string& flag) {
   if (!FlagHasValidForm(flag)) {
     return false;
   }
+  Impl::FlagScope flag_scope(impl_.get(), flag);
 
   // Split flags of the form --pass_name=pass_args.
   auto p = utils::SplitFlagArgs(flag);
@@ -561,6 +623,38 @@ void Optimizer::SetTargetEnv(const spv_target_env env) {
   impl_->target_env = env;
 }
 
+namespace {
+
+// Reads the words of the file named |path| into |words|.  Returns false if it
+// cannot be read.
+bool ReadWords(const std::string& path, std::vector<uint32_t>* words) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) return false;
+  const std::streamoff size = file.tellg();
+  if (size < 0 || size % sizeof(uint32_t) != 0) return false;
+  words->resize(static_cast<size_t>(size) / sizeof(uint32_t));
+  file.seekg(0);
+  return static_cast<bool>(
+      file.read(reinterpret_cast<char*>(words->data()), size));
+}
+
+// Writes |words| to the file named |path|.  A file that cannot be written
+// completely is removed.  Returns false if it cannot be written.
+bool WriteWords(const std::string& path, const std::vector<uint32_t>& words) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) return false;
+  file.write(reinterpret_cast<const char*>(words.data()),
+             static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+  file.close();
+  if (!file) {
+    std::remove(path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 bool Optimizer::Run(const uint32_t* original_binary,
                     const size_t original_binary_size,
                     std::vector<uint32_t>* optimized_binary) const {
@@ -584,6 +678,20 @@ bool Optimizer::Run(const uint32_t* original_binary,
                     const size_t original_binary_size,
                     std::vector<uint32_t>* optimized_binary,
                     const spv_optimizer_options opt_options) const {
+  // A cached result would skip the passes, and with them any output that was
+  // requested about them, so the cache is not used when such output is.
+  const bool reports_on_passes = impl_->pass_manager.ReportsOnPasses() ||
+                                 impl_->pass_observer ||
+                                 opt_options->pass_observer_;
+  std::unique_ptr<utils::ResultCacheEntry> cache_entry;
+  if (!opt_options->cache_directory_.empty() && !impl_->has_unflagged_passes &&
+      !reports_on_passes) {
+    cache_entry = MakeUnique<utils::ResultCacheEntry>(
+        opt_options->cache_directory_, impl_->CacheConfig(opt_options),
+        original_binary, original_binary_size);
+    if (cache_entry->Load(optimized_binary)) return true;
+  }
+
   spvtools::SpirvTools tools(impl_->target_env);
   tools.SetMessageConsumer(impl_->pass_manager.consumer());
   if (opt_options->run_validator_ &&
@@ -592,16 +700,44 @@ bool Optimizer::Run(const uint32_t* original_binary,
     return false;
   }
 
-  std::unique_ptr<opt::IRContext> context = BuildModule(
-      impl_->target_env, consumer(), original_binary, original_binary_size);
+  // When no pass looks at the functions, they are copied through as read.
+  const bool defer_functions = !impl_->pass_manager.NeedsFunctions();
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(impl_->target_env, consumer(), original_binary,
+                  original_binary_size, /* extra_line_tracking = */ true,
+                  opt_options->arena_allocation_, defer_functions);
   if (context == nullptr) return false;
 
   context->set_max_id_bound(opt_options->max_id_bound_);
   context->set_preserve_bindings(opt_options->preserve_bindings_);
   context->set_preserve_spec_constants(opt_options->preserve_spec_constants_);
+  context->set_num_threads(opt_options->num_threads_);
+
+  // The snapshot holds trees of the functions, so it is only read when they
+  // are built.
+  const std::string& snapshot_path = opt_options->analysis_snapshot_;
+  if (!snapshot_path.empty() && !defer_functions) {
+    std::vector<uint32_t> snapshot;
+    if (ReadWords(snapshot_path, &snapshot)) {
+      opt::LoadAnalysisSnapshot(context.get(), original_binary,
+                                original_binary_size, snapshot.data(),
+                                snapshot.size());
+    }
+  }
 
   impl_->pass_manager.SetValidatorOptions(&opt_options->val_options_);
   impl_->pass_manager.SetTargetEnv(impl_->target_env);
+  PassObserver observer = impl_->pass_observer;
+  if (opt_options->pass_observer_) {
+    spv_pass_observer_fn_t c_observer = opt_options->pass_observer_;
+    void* user_data = opt_options->pass_observer_data_;
+    observer = [observer, c_observer,
+                user_data](const spv_pass_metrics_t& metrics) {
+      if (observer) observer(metrics);
+      c_observer(user_data, &metrics);
+    };
+  }
+  impl_->pass_manager.SetPassObserver(std::move(observer));
   auto status = impl_->pass_manager.Run(context.get());
 
   if (status == opt::Pass::Status::Failure) {
@@ -641,6 +777,22 @@ bool Optimizer::Run(const uint32_t* original_binary,
   optimized_binary->clear();
   context->module()->ToBinary(optimized_binary, /* skip_nop = */ true);
 
+  if (!snapshot_path.empty()) {
+    std::vector<uint32_t> snapshot;
+    opt::WriteAnalysisSnapshot(context.get(), *optimized_binary, &snapshot);
+    if (context->module()->FailedToBuildFunctions()) return false;
+    if (!WriteWords(snapshot_path, snapshot)) {
+      Errorf(consumer(), nullptr, {},
+             "Could not write the analysis snapshot %s",
+             snapshot_path.c_str());
+      return false;
+    }
+  }
+
+  // Only a run that succeeded is cached, so that a failure is not turned
+  // into a cache hit.
+  if (cache_entry) cache_entry->Store(*optimized_binary);
+
   return true;
 }
 
@@ -654,6 +806,21 @@ Optimizer& Optimizer::SetTimeReport(std::ostream* out) {
   return *this;
 }
 
+Optimizer& Optimizer::SetAnalysisReport(std::ostream* out) {
+  impl_->pass_manager.SetAnalysisReport(out);
+  return *this;
+}
+
+Optimizer& Optimizer::SetPreservedAnalysesAudit(std::ostream* out) {
+  impl_->pass_manager.SetPreservedAnalysesAudit(out);
+  return *this;
+}
+
+Optimizer& Optimizer::SetPassObserver(PassObserver observer) {
+  impl_->pass_observer = std::move(observer);
+  return *this;
+}
+
 Optimizer& Optimizer::SetValidateAfterAll(bool validate) {
   impl_->pass_manager.SetValidateAfterAll(validate);
   return *this;
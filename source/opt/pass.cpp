@@ -43,8 +43,16 @@ Pass::Status Pass::Run(IRContext* ctx) {
   if (status == Status::SuccessWithChange) {
     ctx->InvalidateAnalysesExceptFor(GetPreservedAnalyses());
   }
-  if (!(status == Status::Failure || ctx->IsConsistent()))
+  if (!(status == Status::Failure || ctx->IsConsistent())) {
+    // Name the pass that claimed to preserve an analysis it did not keep up
+    // to date, since the assert alone does not say which one it was.
+    if (ctx->consumer()) {
+      std::string message = "An analysis is out of date after pass ";
+      message += name();
+      ctx->consumer()(SPV_MSG_INTERNAL_ERROR, "", {0, 0, 0}, message.c_str());
+    }
     assert(false && "An analysis in the context is out of date.");
+  }
   return status;
 }
 
@@ -113,6 +113,11 @@ class Pass {
     return IRContext::kAnalysisNone;
   }
 
+  // Returns true if the pass reads or changes the functions of the module.
+  // Passes that only work on the sections before the functions return false,
+  // so that a pipeline made of them does not build the functions at all.
+  virtual bool NeedsFunctions() const { return true; }
+
   // Return type id for |ptrInst|'s pointee
   uint32_t GetPointeeTypeId(const Instruction* ptrInst) const;
 
@@ -14,17 +14,122 @@
 
 #include "source/opt/pass_manager.h"
 
+#include <chrono>
+#include <ctime>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "source/opt/analysis_report.h"
 #include "source/opt/ir_context.h"
+#include "source/util/make_unique.h"
 #include "source/util/timer.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
 
 namespace opt {
+namespace {
+
+// Takes the measurements reported to a pass observer around the run of one
+// pass.
+class PassMeasurement {
+ public:
+  // Starts measuring a pass named |pass_name| that is about to run on
+  // |context|.
+  PassMeasurement(IRContext* context, const char* pass_name)
+      : context_(context),
+#if defined(SPIRV_TIMER_ENABLED)
+        timer_(nullptr, /* measure_mem_usage = */ true),
+#endif
+        analyses_built_(context->num_analyses_built()),
+        analyses_invalidated_(context->num_analyses_invalidated()) {
+    metrics_.pass_name = pass_name;
+    metrics_.num_insts_before = context->module()->NumInsts();
+#if defined(SPIRV_TIMER_ENABLED)
+    timer_.Start();
+#else
+    wall_start_ = std::chrono::steady_clock::now();
+    cpu_start_ = std::clock();
+#endif
+  }
+
+  // Stops measuring after the pass returned |status|, and returns the
+  // measurements.
+  const spv_pass_metrics_t& Finish(Pass::Status status) {
+#if defined(SPIRV_TIMER_ENABLED)
+    timer_.Stop();
+    metrics_.wall_time = timer_.WallTime();
+    metrics_.cpu_time = timer_.CPUTime();
+    metrics_.peak_rss_delta = timer_.RSS();
+#else
+    metrics_.wall_time = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - wall_start_)
+                             .count();
+    const std::clock_t cpu_end = std::clock();
+    metrics_.cpu_time =
+        cpu_start_ == std::clock_t(-1) || cpu_end == std::clock_t(-1)
+            ? -1
+            : static_cast<double>(cpu_end - cpu_start_) / CLOCKS_PER_SEC;
+    metrics_.peak_rss_delta = -1;
+#endif
+    metrics_.num_insts_after = context_->module()->NumInsts();
+    metrics_.num_analyses_built =
+        context_->num_analyses_built() - analyses_built_;
+    metrics_.num_analyses_invalidated =
+        context_->num_analyses_invalidated() - analyses_invalidated_;
+    metrics_.changed = status == Pass::Status::SuccessWithChange;
+    return metrics_;
+  }
+
+ private:
+  IRContext* context_;
+#if defined(SPIRV_TIMER_ENABLED)
+  utils::Timer timer_;
+#else
+  std::chrono::steady_clock::time_point wall_start_;
+  std::clock_t cpu_start_;
+#endif
+  uint32_t analyses_built_;
+  uint32_t analyses_invalidated_;
+  spv_pass_metrics_t metrics_ = {};
+};
+
+// Charges the analysis builds of a run to passes while it lasts, and reports
+// them when it ends, however it ends.
+class ScopedAnalysisReport {
+ public:
+  // Starts accounting for the builds of |context| if |out| is not null.
+  ScopedAnalysisReport(IRContext* context, std::ostream* out)
+      : context_(context), out_(out) {
+    if (out_) context_->SetAnalysisListener(&accounting_);
+  }
+
+  ~ScopedAnalysisReport() {
+    if (!out_) return;
+    context_->SetAnalysisListener(nullptr);
+    accounting_.Report(out_);
+  }
+
+  // Charges the invalidations from now on to the pass named |pass_name|.
+  void SetCurrentPass(const char* pass_name) {
+    accounting_.SetCurrentPass(pass_name);
+  }
+
+ private:
+  IRContext* context_;
+  std::ostream* out_;
+  AnalysisAccounting accounting_;
+};
+
+}  // namespace
+
+bool PassManager::NeedsFunctions() const {
+  for (const auto& pass : passes_) {
+    if (pass->NeedsFunctions()) return true;
+  }
+  return false;
+}
 
 Pass::Status PassManager::Run(IRContext* context) {
   auto status = Pass::Status::SuccessWithoutChange;
@@ -52,11 +157,34 @@ Pass::Status PassManager::Run(IRContext* context) {
   };
 
   SPIRV_TIMER_DESCRIPTION(time_report_stream_, /* measure_mem_usage = */ true);
+  ScopedAnalysisReport analysis_report(context, analysis_report_stream_);
   for (auto& pass : passes_) {
     print_disassembly("; IR before pass ", pass.get());
+    analysis_report.SetCurrentPass(pass->name());
+    std::unique_ptr<PreservedAnalysesAudit> audit;
+    if (audit_stream_) {
+      audit = MakeUnique<PreservedAnalysesAudit>(context, pass.get());
+    }
     SPIRV_TIMER_SCOPED(time_report_stream_, (pass ? pass->name() : ""), true);
+    std::unique_ptr<PassMeasurement> measurement;
+    if (pass_observer_) {
+      measurement = MakeUnique<PassMeasurement>(context, pass->name());
+    }
     const auto one_status = pass->Run(context);
     if (one_status == Pass::Status::Failure) return one_status;
+    // A pass that builds deferred functions which are not valid worked on a
+    // partial module.
+    if (context->module()->FailedToBuildFunctions()) {
+      return Pass::Status::Failure;
+    }
+    if (measurement) pass_observer_(measurement->Finish(one_status));
+    if (audit && one_status == Pass::Status::SuccessWithChange) {
+      for (IRContext::Analysis analysis : audit->UnchangedAnalyses()) {
+        *audit_stream_ << pass->name() << ": the "
+                       << IRContext::GetAnalysisName(analysis)
+                       << " analysis is unchanged and could be preserved\n";
+      }
+    }
     if (one_status == Pass::Status::SuccessWithChange) status = one_status;
 
     if (validate_after_all_) {
@@ -44,6 +44,8 @@ class PassManager {
       : consumer_(nullptr),
         print_all_stream_(nullptr),
         time_report_stream_(nullptr),
+        analysis_report_stream_(nullptr),
+        audit_stream_(nullptr),
         target_env_(SPV_ENV_UNIVERSAL_1_2),
         val_options_(nullptr),
         validate_after_all_(false) {}
@@ -67,6 +69,10 @@ class PassManager {
   // Returns the message consumer.
   inline const MessageConsumer& consumer() const;
 
+  // Returns true if any of the passes added reads or changes the functions of
+  // the module.  See Pass::NeedsFunctions.
+  bool NeedsFunctions() const;
+
   // Runs all passes on the given |module|. Returns Status::Failure if errors
   // occur when processing using one of the registered passes. All passes
   // registered after the error-reporting pass will be skipped. Returns the
@@ -92,6 +98,39 @@ class PassManager {
     return *this;
   }
 
+  // Sets the option to print, after the last pass, how many times each
+  // analysis was built and how long that took, charged to the pass that last
+  // invalidated the analysis.  Output is written to |out| if that is not null.
+  // No output is generated if |out| is null.
+  PassManager& SetAnalysisReport(std::ostream* out) {
+    analysis_report_stream_ = out;
+    return *this;
+  }
+
+  // Sets the option to check, after each pass that changed the module, which
+  // of the analyses the pass did not declare preserved are unchanged, and
+  // could have been.  See PreservedAnalysesAudit.  Findings are written to
+  // |out| if that is not null.  Nothing is checked if |out| is null.
+  PassManager& SetPreservedAnalysesAudit(std::ostream* out) {
+    audit_stream_ = out;
+    return *this;
+  }
+
+  // Sets the function called with the measurements taken while running each
+  // pass that succeeded.  Nothing is measured if |observer| is empty.
+  PassManager& SetPassObserver(PassObserver observer) {
+    pass_observer_ = std::move(observer);
+    return *this;
+  }
+
+  // Returns true if running the passes reports on them beyond the resulting
+  // module: printing, timing, auditing, observing or validating each pass.
+  bool ReportsOnPasses() const {
+    return print_all_stream_ || time_report_stream_ ||
+           analysis_report_stream_ || audit_stream_ || pass_observer_ ||
+           validate_after_all_;
+  }
+
   // Sets the target environment for validation.
   PassManager& SetTargetEnv(spv_target_env env) {
     target_env_ = env;
@@ -121,6 +160,14 @@ class PassManager {
   // The output stream to write the resource utilization of each pass. If this
   // is null, no output is generated.
   std::ostream* time_report_stream_;
+  // The output stream to write the analysis builds to.  If this is null, no
+  // output is generated.
+  std::ostream* analysis_report_stream_;
+  // The output stream to write the findings of the preserved analyses audit
+  // to.  If this is null, the audit does not run.
+  std::ostream* audit_stream_;
+  // The function called with the measurements of each pass, if any.
+  PassObserver pass_observer_;
   // The target environment.
   spv_target_env target_env_;
   // The validator options (used when validating each pass).
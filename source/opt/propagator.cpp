@@ -33,7 +33,7 @@ void SSAPropagator::AddControlEdge(const Edge& edge) {
 
   // If the edge had not already been marked executable, add the destination
   // basic block to the work list.
-  blocks_.push(dest_bb);
+  blocks_.Push(dest_bb);
 }
 
 void SSAPropagator::AddSSAEdges(Instruction* instr) {
@@ -52,7 +52,7 @@ void SSAPropagator::AddSSAEdges(Instruction* instr) {
         }
 
         if (ShouldSimulateAgain(use_instr)) {
-          ssa_edge_uses_.push(use_instr);
+          ssa_edge_uses_.Push(use_instr);
         }
       });
 }
@@ -79,7 +79,7 @@ bool SSAPropagator::SetStatus(Instruction* inst, PropStatus status) {
          "Invalid lattice transition");
 
   bool status_changed = !has_old_status || (old_status != status);
-  if (status_changed) statuses_[inst] = status;
+  if (status_changed) statuses_[inst->unique_id()] = status;
 
   return status_changed;
 }
@@ -207,6 +207,8 @@ bool SSAPropagator::Simulate(BasicBlock* block) {
 }
 
 void SSAPropagator::Initialize(Function* fn) {
+  blocks_.Reset(ctx_->cfg(), fn);
+
   // Compute predecessor and successor blocks for every block in |fn|'s CFG.
   // TODO(dnovillo): Move this to CFG and always build them. Alternately,
   // move it to IRContext and build CFG preds/succs on-demand.
@@ -244,17 +246,13 @@ bool SSAPropagator::Run(Function* fn) {
     // Simulate all blocks first. Simulating blocks will add SSA edges to
     // follow after all the blocks have been simulated.
     if (!blocks_.empty()) {
-      auto block = blocks_.front();
-      changed |= Simulate(block);
-      blocks_.pop();
+      changed |= Simulate(blocks_.Pop());
       continue;
     }
 
     // Simulate edges from the SSA queue.
     if (!ssa_edge_uses_.empty()) {
-      Instruction* instr = ssa_edge_uses_.front();
-      changed |= Simulate(instr);
-      ssa_edge_uses_.pop();
+      changed |= Simulate(ssa_edge_uses_.Pop());
     }
   }
 
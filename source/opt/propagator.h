@@ -16,8 +16,6 @@
 #define SOURCE_OPT_PROPAGATOR_H_
 
 #include <functional>
-#include <queue>
-#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -25,6 +23,9 @@
 
 #include "source/opt/ir_context.h"
 #include "source/opt/module.h"
+#include "source/opt/worklist.h"
+#include "source/util/bit_vector.h"
+#include "source/util/dense_id_map.h"
 
 namespace spvtools {
 namespace opt {
@@ -200,12 +201,14 @@ class SSAPropagator {
 
   // Returns true if |inst| has a recorded status. This will be true once |inst|
   // has been simulated once.
-  bool HasStatus(Instruction* inst) const { return statuses_.count(inst); }
+  bool HasStatus(Instruction* inst) const {
+    return statuses_.count(inst->unique_id());
+  }
 
   // Returns the current propagation status of |inst|. Assumes
   // |HasStatus(inst)| returns true.
   PropStatus Status(Instruction* inst) const {
-    return statuses_.find(inst)->second;
+    return statuses_.at(inst->unique_id());
   }
 
   // Records the propagation status |status| for |inst|. Returns true if the
@@ -228,31 +231,38 @@ class SSAPropagator {
 
   // Returns true if |instr| should be simulated again.
   bool ShouldSimulateAgain(Instruction* instr) const {
-    return do_not_simulate_.find(instr) == do_not_simulate_.end();
+    return !do_not_simulate_.Get(instr->unique_id());
   }
 
   // Add |instr| to the set of instructions not to simulate again.
-  void DontSimulateAgain(Instruction* instr) { do_not_simulate_.insert(instr); }
+  void DontSimulateAgain(Instruction* instr) {
+    do_not_simulate_.Set(instr->unique_id());
+  }
 
   // Returns true if |block| has been simulated already.
   bool BlockHasBeenSimulated(BasicBlock* block) const {
-    return simulated_blocks_.find(block) != simulated_blocks_.end();
+    return simulated_blocks_.Get(block->id());
   }
 
   // Marks block |block| as simulated.
   void MarkBlockSimulated(BasicBlock* block) {
-    simulated_blocks_.insert(block);
+    simulated_blocks_.Set(block->id());
   }
 
   // Marks |edge| as executable.  Returns false if the edge was already marked
   // as executable.
   bool MarkEdgeExecutable(const Edge& edge) {
-    return executable_edges_.insert(edge).second;
+    return executable_edges_.insert(EdgeKey(edge)).second;
   }
 
   // Returns true if |edge| has been marked as executable.
   bool IsEdgeExecutable(const Edge& edge) const {
-    return executable_edges_.find(edge) != executable_edges_.end();
+    return executable_edges_.count(EdgeKey(edge)) != 0;
+  }
+
+  // Returns the key of |edge| in |executable_edges_|.
+  static uint64_t EdgeKey(const Edge& edge) {
+    return (uint64_t(edge.source->id()) << 32) | edge.dest->id();
   }
 
   // Returns a pointer to the def-use manager for |ctx_|.
@@ -279,17 +289,18 @@ class SSAPropagator {
 
   // SSA def-use edges to traverse. Each entry is a destination statement for an
   // SSA def-use edge as returned by |def_use_manager_|.
-  std::queue<Instruction*> ssa_edge_uses_;
+  InstructionWorklist ssa_edge_uses_;
 
-  // Blocks to simulate.
-  std::queue<BasicBlock*> blocks_;
+  // Blocks to simulate, handed out in reverse post-order so that the values
+  // flowing into a block are usually known by the time it is simulated.
+  BlockWorklist blocks_;
 
-  // Blocks simulated during propagation.
-  std::unordered_set<BasicBlock*> simulated_blocks_;
+  // Ids of the blocks simulated during propagation.
+  utils::BitVector simulated_blocks_;
 
-  // Set of instructions that should not be simulated again because they have
-  // been found to be in the kVarying state.
-  std::unordered_set<Instruction*> do_not_simulate_;
+  // Unique ids of the instructions that should not be simulated again because
+  // they have been found to be in the kVarying state.
+  utils::BitVector do_not_simulate_;
 
   // Map between a basic block and its predecessor edges.
   // TODO(dnovillo): Move this to CFG and always build them. Alternately,
@@ -301,11 +312,12 @@ class SSAPropagator {
   // move it to IRContext and build CFG preds/succs on-demand.
   std::unordered_map<BasicBlock*, std::vector<Edge>> bb_succs_;
 
-  // Set of executable CFG edges.
-  std::set<Edge> executable_edges_;
+  // Set of executable CFG edges, as the ids of their source and destination
+  // blocks.  See EdgeKey.
+  std::unordered_set<uint64_t> executable_edges_;
 
-  // Tracks instruction propagation status.
-  std::unordered_map<Instruction*, SSAPropagator::PropStatus> statuses_;
+  // Tracks instruction propagation status, by unique id.
+  utils::DenseIdMap<SSAPropagator::PropStatus> statuses_;
 };
 
 std::ostream& operator<<(std::ostream& str,
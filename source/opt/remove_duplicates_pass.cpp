@@ -26,9 +26,25 @@
 #include "source/opt/decoration_manager.h"
 #include "source/opt/ir_context.h"
 #include "source/opt/reflect.h"
+#include "source/util/hash_combine.h"
 
 namespace spvtools {
 namespace opt {
+namespace {
+
+// Returns a hash of the opcode and in-operands of |inst|, which is the same
+// for any two decorations that AreDecorationsTheSame() considers equal.
+size_t HashDecoration(const Instruction& inst) {
+  size_t hash = utils::hash_combine(0, uint32_t(inst.opcode()));
+  for (uint32_t i = 0; i < inst.NumInOperands(); ++i) {
+    for (uint32_t word : inst.GetInOperand(i).words) {
+      hash = utils::hash_combine(hash, word);
+    }
+  }
+  return hash;
+}
+
+}  // namespace
 
 Pass::Status RemoveDuplicatesPass::Process() {
   bool modified = RemoveDuplicateCapabilities();
@@ -97,8 +113,15 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 
   analysis::TypeManager type_manager(context()->consumer(), context());
 
-  std::vector<Instruction*> visited_types;
-  std::vector<analysis::ForwardPointer> visited_forward_pointers;
+  // The types seen so far, indexed by their structural hash, each with the id
+  // of the instruction that declared it.
+  std::unordered_map<const analysis::Type*, SpvId, analysis::HashTypePointer,
+                     analysis::CompareTypePointers>
+      visited_types;
+  // The forward pointers seen so far, bucketed by the hash of the pointer
+  // they declare.
+  std::unordered_map<size_t, std::vector<analysis::ForwardPointer>>
+      visited_forward_pointers;
   std::vector<Instruction*> to_delete;
   for (auto* i = &*context()->types_values_begin(); i; i = i->NextNode()) {
     const bool is_i_forward_pointer = i->opcode() == SpvOpTypeForwardPointer;
@@ -110,47 +133,39 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 
     if (!is_i_forward_pointer) {
       // Is the current type equal to one of the types we have already visited?
-      SpvId id_to_keep = 0u;
-      analysis::Type* i_type = type_manager.GetType(i->result_id());
+      const analysis::Type* i_type = type_manager.GetType(i->result_id());
       assert(i_type);
-      // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-      // ResultIdTrie from unify_const_pass.cpp for this.
-      for (auto j : visited_types) {
-        analysis::Type* j_type = type_manager.GetType(j->result_id());
-        assert(j_type);
-        if (*i_type == *j_type) {
-          id_to_keep = j->result_id();
-          break;
-        }
-      }
+      auto res = visited_types.emplace(i_type, i->result_id());
 
-      if (id_to_keep == 0u) {
+      if (res.second) {
         // This is a never seen before type, keep it around.
-        visited_types.emplace_back(i);
-      } else {
-        // The same type has already been seen before, remove this one.
-        context()->KillNamesAndDecorates(i->result_id());
-        context()->ReplaceAllUsesWith(i->result_id(), id_to_keep);
-        modified = true;
-        to_delete.emplace_back(i);
+        continue;
       }
+
+      // The same type has already been seen before, remove this one.
+      const SpvId id_to_keep = res.first->second;
+      context()->KillNamesAndDecorates(i->result_id());
+      context()->ReplaceAllUsesWith(i->result_id(), id_to_keep);
+      modified = true;
+      to_delete.emplace_back(i);
     } else {
       analysis::ForwardPointer i_type(
           i->GetSingleWordInOperand(0u),
           (SpvStorageClass)i->GetSingleWordInOperand(1u));
-      i_type.SetTargetPointer(
-          type_manager.GetType(i_type.target_id())->AsPointer());
-
-      // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-      // ResultIdTrie from unify_const_pass.cpp for this.
+      const analysis::Pointer* target_pointer =
+          type_manager.GetType(i_type.target_id())->AsPointer();
+      i_type.SetTargetPointer(target_pointer);
+
+      // Forward pointers compare by the pointer they declare rather than by
+      // its id, so that is what they are bucketed by.
+      std::vector<analysis::ForwardPointer>& bucket =
+          visited_forward_pointers[target_pointer->HashValue()];
       const bool found_a_match =
-          std::find(std::begin(visited_forward_pointers),
-                    std::end(visited_forward_pointers),
-                    i_type) != std::end(visited_forward_pointers);
+          std::find(bucket.begin(), bucket.end(), i_type) != bucket.end();
 
       if (!found_a_match) {
         // This is a never seen before type, keep it around.
-        visited_forward_pointers.emplace_back(i_type);
+        bucket.emplace_back(i_type);
       } else {
         // The same type has already been seen before, remove this one.
         modified = true;
@@ -178,16 +193,19 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes() const {
 bool RemoveDuplicatesPass::RemoveDuplicateDecorations() const {
   bool modified = false;
 
-  std::vector<const Instruction*> visited_decorations;
+  // The decorations seen so far, bucketed by a hash of their opcode and
+  // operands, which AreDecorationsTheSame() compares.
+  std::unordered_map<size_t, std::vector<const Instruction*>>
+      visited_decorations;
 
   analysis::DecorationManager decoration_manager(context()->module());
   for (auto* i = &*context()->annotation_begin(); i;) {
     // Is the current decoration equal to one of the decorations we have
     // already visited?
     bool already_visited = false;
-    // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-    // ResultIdTrie from unify_const_pass.cpp for this.
-    for (const Instruction* j : visited_decorations) {
+    std::vector<const Instruction*>& bucket =
+        visited_decorations[HashDecoration(*i)];
+    for (const Instruction* j : bucket) {
       if (decoration_manager.AreDecorationsTheSame(&*i, j, false)) {
         already_visited = true;
         break;
@@ -196,7 +214,7 @@ bool RemoveDuplicatesPass::RemoveDuplicateDecorations() const {
 
     if (!already_visited) {
       // This is a never seen before decoration, keep it around.
-      visited_decorations.emplace_back(&*i);
+      bucket.emplace_back(&*i);
       i = i->NextNode();
     } else {
       // The same decoration has already been seen before, remove this one.
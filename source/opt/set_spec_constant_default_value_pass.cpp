@@ -18,9 +18,9 @@
 #include <cctype>
 #include <cstring>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
-#include "source/opt/def_use_manager.h"
 #include "source/opt/ir_context.h"
 #include "source/opt/type_manager.h"
 #include "source/opt/types.h"
@@ -148,13 +148,32 @@ bool CanHaveSpecIdDecoration(const Instruction& inst) {
   }
 }
 
+// Maps the result ids of the annotations and of the types and values of a
+// module to their defining instructions.  SpecId decorations and the
+// decoration groups they are applied through are all found there, so the
+// functions of the module are not looked at.
+using GlobalDefs = std::unordered_map<uint32_t, Instruction*>;
+
+// Returns the definitions of the annotations and the types and values of
+// |context|.
+GlobalDefs GetGlobalDefs(IRContext* context) {
+  GlobalDefs defs;
+  for (Instruction& inst : context->annotations()) {
+    if (inst.result_id() != 0) defs[inst.result_id()] = &inst;
+  }
+  for (Instruction& inst : context->types_values()) {
+    if (inst.result_id() != 0) defs[inst.result_id()] = &inst;
+  }
+  return defs;
+}
+
 // Given a decoration group defining instruction that is decorated with SpecId
 // decoration, finds the spec constant defining instruction which is the real
 // target of the SpecId decoration. Returns the spec constant defining
 // instruction if such an instruction is found, otherwise returns a nullptr.
 Instruction* GetSpecIdTargetFromDecorationGroup(
-    const Instruction& decoration_group_defining_inst,
-    analysis::DefUseManager* def_use_mgr) {
+    const Instruction& decoration_group_defining_inst, IRContext* context,
+    const GlobalDefs& defs) {
   // Find the OpGroupDecorate instruction which consumes the given decoration
   // group. Note that the given decoration group has SpecId decoration, which
   // is unique for different spec constants. So the decoration group cannot be
@@ -162,16 +181,15 @@ Instruction* GetSpecIdTargetFromDecorationGroup(
   // the first OpGroupDecoration instruction that uses the given decoration
   // group.
   Instruction* group_decorate_inst = nullptr;
-  if (def_use_mgr->WhileEachUser(&decoration_group_defining_inst,
-                                 [&group_decorate_inst](Instruction* user) {
-                                   if (user->opcode() ==
-                                       SpvOp::SpvOpGroupDecorate) {
-                                     group_decorate_inst = user;
-                                     return false;
-                                   }
-                                   return true;
-                                 }))
-    return nullptr;
+  for (Instruction& inst : context->annotations()) {
+    if (inst.opcode() == SpvOp::SpvOpGroupDecorate &&
+        inst.GetSingleWordInOperand(0) ==
+            decoration_group_defining_inst.result_id()) {
+      group_decorate_inst = &inst;
+      break;
+    }
+  }
+  if (!group_decorate_inst) return nullptr;
 
   // Scan through the target ids of the OpGroupDecorate instruction. There
   // should be only one spec constant target consumes the SpecId decoration.
@@ -184,12 +202,12 @@ Instruction* GetSpecIdTargetFromDecorationGroup(
   for (uint32_t i = 1; i < group_decorate_inst->NumInOperands(); i++) {
     // All the operands of a OpGroupDecorate instruction should be of type
     // SPV_OPERAND_TYPE_ID.
+    // A target that is not among |defs| is defined in a function, so it is
+    // not a spec constant.
     uint32_t candidate_id = group_decorate_inst->GetSingleWordInOperand(i);
-    Instruction* candidate_inst = def_use_mgr->GetDef(candidate_id);
-
-    if (!candidate_inst) {
-      continue;
-    }
+    auto candidate = defs.find(candidate_id);
+    if (candidate == defs.end()) return nullptr;
+    Instruction* candidate_inst = candidate->second;
 
     if (!target_inst) {
       // If the spec constant target has not been found yet, check if the
@@ -228,6 +246,7 @@ Pass::Status SetSpecConstantDefaultValuePass::Process() {
   // The in-operand index of the default value in a OpSpecConstant instruction.
   const uint32_t kOpSpecConstantLiteralInOperandIndex = 0;
 
+  const GlobalDefs defs = GetGlobalDefs(context());
   bool modified = false;
   // Scan through all the annotation instructions to find 'OpDecorate SpecId'
   // instructions. Then extract the decoration target of those instructions.
@@ -254,15 +273,14 @@ Pass::Status SetSpecConstantDefaultValuePass::Process() {
     // Find the spec constant defining instruction. Note that the
     // target_id might be a decoration group id.
     Instruction* spec_inst = nullptr;
-    if (Instruction* target_inst = get_def_use_mgr()->GetDef(target_id)) {
-      if (target_inst->opcode() == SpvOp::SpvOpDecorationGroup) {
-        spec_inst =
-            GetSpecIdTargetFromDecorationGroup(*target_inst, get_def_use_mgr());
-      } else {
-        spec_inst = target_inst;
-      }
+    auto target = defs.find(target_id);
+    if (target == defs.end()) continue;
+    Instruction* target_inst = target->second;
+    if (target_inst->opcode() == SpvOp::SpvOpDecorationGroup) {
+      spec_inst =
+          GetSpecIdTargetFromDecorationGroup(*target_inst, context(), defs);
     } else {
-      continue;
+      spec_inst = target_inst;
     }
     if (!spec_inst) continue;
 
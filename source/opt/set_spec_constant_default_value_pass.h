@@ -59,6 +59,7 @@ class SetSpecConstantDefaultValuePass : public Pass {
 
   const char* name() const override { return "set-spec-const-default-value"; }
   Status Process() override;
+  bool NeedsFunctions() const override { return false; }
 
   // Parses the given null-terminated C string to get a mapping from Spec Id to
   // default value strings. Returns a unique pointer of the mapping from spec
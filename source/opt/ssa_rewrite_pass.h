@@ -307,6 +307,10 @@ class SSARewritePass : public MemPass {
 
   const char* name() const override { return "ssa-rewrite"; }
   Status Process() override;
+
+  IRContext::Analysis GetPreservedAnalyses() override {
+    return IRContext::kAnalysisDefUse | IRContext::kAnalysisInstrToBlockMapping;
+  }
 };
 
 }  // namespace opt
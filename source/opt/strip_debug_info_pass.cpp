@@ -92,11 +92,14 @@ Pass::Status StripDebugInfoPass::Process() {
 
   for (auto* inst : to_kill) context()->KillInst(inst);
 
-  // clear OpLine information
-  context()->module()->ForEachInst([&modified](Instruction* inst) {
-    modified |= !inst->dbg_line_insts().empty();
-    inst->dbg_line_insts().clear();
-  });
+  // clear OpLine information.  The functions of a module are only deferred
+  // when it has no line instructions, so they are left unbuilt.
+  if (!get_module()->HasDeferredFunctions()) {
+    context()->module()->ForEachInst([&modified](Instruction* inst) {
+      modified |= !inst->dbg_line_insts().empty();
+      inst->dbg_line_insts().clear();
+    });
+  }
 
   if (!get_module()->trailing_dbg_line_info().empty()) {
     modified = true;
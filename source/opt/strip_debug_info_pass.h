@@ -27,6 +27,7 @@ class StripDebugInfoPass : public Pass {
  public:
   const char* name() const override { return "strip-debug"; }
   Status Process() override;
+  bool NeedsFunctions() const override { return false; }
 };
 
 }  // namespace opt
@@ -65,6 +65,16 @@ bool CompareTwoVectors(const U32VecVec a, const U32VecVec b) {
   return true;
 }
 
+// Returns |hash| combined with a hash of |decorations| that does not depend on
+// their order, as CompareTwoVectors does not.
+size_t HashDecorations(size_t hash, const U32VecVec& decorations) {
+  size_t sum = 0;
+  for (const auto& d : decorations) {
+    sum += hash_combine(0, d);
+  }
+  return hash_combine(hash, sum);
+}
+
 }  // anonymous namespace
 
 std::string Type::GetDecorationStr() const {
@@ -197,9 +207,7 @@ size_t Type::ComputeHashValue(size_t hash, SeenTypes* seen) const {
   seen->push_back(this);
 
   hash = hash_combine(hash, uint32_t(kind_));
-  for (const auto& d : decorations_) {
-    hash = hash_combine(hash, d);
-  }
+  hash = HashDecorations(hash, decorations_);
 
   switch (kind_) {
 #define DeclareKindCase(type)                             \
@@ -536,7 +544,7 @@ size_t Struct::ComputeExtraStateHash(size_t hash, SeenTypes* seen) const {
     hash = t->ComputeHashValue(hash, seen);
   }
   for (const auto& pair : element_decorations_) {
-    hash = hash_combine(hash, pair.first, pair.second);
+    hash = HashDecorations(hash_combine(hash, pair.first), pair.second);
   }
   return hash;
 }
@@ -27,17 +27,28 @@ const uint32_t kInsertCompositeIdInIdx = 1;
 }  // namespace
 
 Pass::Status VectorDCE::Process() {
-  bool modified = false;
+  std::vector<Function*> functions;
   for (Function& function : *get_module()) {
-    modified |= VectorDCEFunction(&function);
+    functions.push_back(&function);
   }
-  return (modified ? Status::SuccessWithChange : Status::SuccessWithoutChange);
-}
 
-bool VectorDCE::VectorDCEFunction(Function* function) {
-  LiveComponentMap live_components;
-  FindLiveComponents(function, &live_components);
-  return RewriteInstructions(function, live_components);
+  // The live components of a function only depend on its own instructions, and
+  // rewriting a function does not change the others, so the liveness of every
+  // function can be found concurrently before any of them is rewritten.
+  std::vector<LiveComponentMap> live_components(functions.size());
+  context()->AnalyzeFunctionsInParallel(
+      functions,
+      IRContext::kAnalysisDefUse | IRContext::kAnalysisTypes |
+          IRContext::kAnalysisCombinators,
+      [this, &live_components](Function* function, size_t i) {
+        FindLiveComponents(function, &live_components[i]);
+      });
+
+  bool modified = false;
+  for (size_t i = 0; i < functions.size(); ++i) {
+    modified |= RewriteInstructions(functions[i], live_components[i]);
+  }
+  return (modified ? Status::SuccessWithChange : Status::SuccessWithoutChange);
 }
 
 void VectorDCE::FindLiveComponents(Function* function,
@@ -58,12 +58,10 @@ class VectorDCE : public MemPass {
   }
 
  private:
-  // Runs the vector dce pass on |function|.  Returns true if |function| was
-  // modified.
-  bool VectorDCEFunction(Function* function);
-
   // Identifies the live components of the vectors that are results of
   // instructions in |function|.  The results are stored in |live_components|.
+  // Only reads the module and the def-use, type and combinator analyses, so
+  // it may run on several functions at once.
   void FindLiveComponents(Function* function,
                           LiveComponentMap* live_components);
 
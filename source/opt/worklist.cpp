@@ -0,0 +1,42 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/worklist.h"
+
+#include "source/opt/cfg.h"
+#include "source/opt/function.h"
+
+namespace spvtools {
+namespace opt {
+
+void BlockWorklist::Reset(CFG* cfg, Function* function) {
+  order_.clear();
+  index_.clear();
+  heap_ = decltype(heap_)();
+  pending_ = utils::BitVector();
+  cfg->ForEachBlockInReversePostOrder(
+      function->entry().get(), [this](BasicBlock* block) { Index(block); });
+}
+
+uint32_t BlockWorklist::Index(BasicBlock* block) {
+  auto it = index_.find(block->id());
+  if (it != index_.end()) return it->second;
+  const uint32_t index = static_cast<uint32_t>(order_.size());
+  index_.insert({block->id(), index});
+  order_.push_back(block);
+  return index;
+}
+
+}  // namespace opt
+}  // namespace spvtools
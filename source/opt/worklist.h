@@ -0,0 +1,128 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_OPT_WORKLIST_H_
+#define SOURCE_OPT_WORKLIST_H_
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "source/opt/basic_block.h"
+#include "source/opt/instruction.h"
+#include "source/util/bit_vector.h"
+#include "source/util/dense_id_map.h"
+
+namespace spvtools {
+namespace opt {
+
+class CFG;
+class Function;
+
+// A first-in first-out worklist of instructions, in which an instruction is
+// pending at most once.  Membership is a bit indexed by the unique id of the
+// instruction, so instructions created while the worklist is in use can be
+// added too.
+class InstructionWorklist {
+ public:
+  InstructionWorklist() = default;
+
+  // Adds |inst| to the back of the worklist unless it is already pending.
+  // Returns true if it was added.
+  bool Push(Instruction* inst) {
+    if (pending_.Set(inst->unique_id())) return false;
+    queue_.push(inst);
+    return true;
+  }
+
+  // Removes the instruction at the front of the worklist and returns it.  It
+  // may be added again afterwards.  The worklist must not be empty.
+  Instruction* Pop() {
+    Instruction* inst = queue_.front();
+    queue_.pop();
+    pending_.Clear(inst->unique_id());
+    return inst;
+  }
+
+  // Returns true if |inst| is pending.
+  bool IsPending(const Instruction* inst) const {
+    return pending_.Get(inst->unique_id());
+  }
+
+  bool empty() const { return queue_.empty(); }
+  size_t size() const { return queue_.size(); }
+
+ private:
+  std::queue<Instruction*> queue_;
+  utils::BitVector pending_;
+};
+
+// A worklist of the basic blocks of a function, which always hands out the
+// pending block that comes first in reverse post-order, and in which a block
+// is pending at most once.  Forward propagation over the blocks in that order
+// sees the definitions before their uses wherever the CFG allows it, so it
+// needs fewer visits to converge than in the order the blocks were found.
+//
+// The blocks are numbered in reverse post-order once, when the worklist is
+// reset, and membership is a bit indexed by that number.
+class BlockWorklist {
+ public:
+  BlockWorklist() = default;
+
+  // Empties the worklist and numbers the blocks of |function| reachable from
+  // its entry in reverse post-order according to |cfg|.  Other blocks are
+  // numbered after them when they are first added.
+  void Reset(CFG* cfg, Function* function);
+
+  // Adds |block| to the worklist unless it is already pending.  Returns true
+  // if it was added.
+  bool Push(BasicBlock* block) {
+    const uint32_t index = Index(block);
+    if (pending_.Set(index)) return false;
+    heap_.push(index);
+    return true;
+  }
+
+  // Removes the pending block that comes first in reverse post-order and
+  // returns it.  It may be added again afterwards.  The worklist must not be
+  // empty.
+  BasicBlock* Pop() {
+    const uint32_t index = heap_.top();
+    heap_.pop();
+    pending_.Clear(index);
+    return order_[index];
+  }
+
+  // Returns the position of |block| in reverse post-order, numbering it if it
+  // was not numbered yet.
+  uint32_t Index(BasicBlock* block);
+
+  bool empty() const { return heap_.empty(); }
+
+ private:
+  // The numbered blocks, in reverse post-order.
+  std::vector<BasicBlock*> order_;
+  // The position in |order_| of each numbered block, by block id.
+  utils::DenseIdMap<uint32_t> index_;
+  // The positions of the pending blocks, smallest first.
+  std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>>
+      heap_;
+  utils::BitVector pending_;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // SOURCE_OPT_WORKLIST_H_
@@ -14,7 +14,7 @@
 
 #include "source/reduce/reducer.h"
 
-#include <cassert>
+#include <algorithm>
 #include <sstream>
 
 #include "source/reduce/conditional_branch_to_simple_conditional_branch_opportunity_finder.h"
@@ -31,6 +31,7 @@
 #include "source/reduce/structured_construct_to_block_reduction_opportunity_finder.h"
 #include "source/reduce/structured_loop_to_selection_reduction_opportunity_finder.h"
 #include "source/spirv_reducer_options.h"
+#include "source/util/parallel.h"
 
 namespace spvtools {
 namespace reduce {
@@ -60,16 +61,17 @@ Reducer::ReductionResultStatus Reducer::Run(
     spv_validator_options validator_options) {
   std::vector<uint32_t> current_binary(binary_in);
 
-  spvtools::SpirvTools tools(target_env_);
-  assert(tools.IsValid() && "Failed to create SPIRV-Tools interface");
+  // Each candidate is an edit of the binaries validated before it, so the
+  // validator can skip the checks of the functions it did not change.
+  val::IncrementalValidator validator(target_env_, validator_options);
 
   // Keeps track of how many reduction attempts have been tried.  Reduction
   // bails out if this reaches a given limit.
   uint32_t reductions_applied = 0;
 
   // Initial state should be valid.
-  if (!tools.Validate(&current_binary[0], current_binary.size(),
-                      validator_options)) {
+  if (validator.Validate(current_binary.data(), current_binary.size(),
+                         nullptr) != SPV_SUCCESS) {
     consumer_(SPV_MSG_INFO, nullptr, {},
               "Initial binary is invalid; stopping.");
     return Reducer::ReductionResultStatus::kInitialStateInvalid;
@@ -83,13 +85,13 @@ Reducer::ReductionResultStatus Reducer::Run(
   }
 
   Reducer::ReductionResultStatus result =
-      RunPasses(&passes_, options, validator_options, tools, &current_binary,
+      RunPasses(&passes_, options, &validator, &current_binary,
                 &reductions_applied);
 
   if (result == Reducer::ReductionResultStatus::kComplete) {
     // Cleanup passes.
-    result = RunPasses(&cleanup_passes_, options, validator_options, tools,
-                       &current_binary, &reductions_applied);
+    result = RunPasses(&cleanup_passes_, options, &validator, &current_binary,
+                       &reductions_applied);
   }
 
   if (result == Reducer::ReductionResultStatus::kComplete) {
@@ -159,9 +161,13 @@ bool Reducer::ReachedStepLimit(uint32_t current_step,
 
 Reducer::ReductionResultStatus Reducer::RunPasses(
     std::vector<std::unique_ptr<ReductionPass>>* passes,
-    spv_const_reducer_options options, spv_validator_options validator_options,
-    const SpirvTools& tools, std::vector<uint32_t>* current_binary,
+    spv_const_reducer_options options, val::IncrementalValidator* validator,
+    std::vector<uint32_t>* current_binary,
     uint32_t* const reductions_applied) {
+  const uint32_t num_jobs = options->num_jobs == 0
+                                ? utils::HardwareConcurrency()
+                                : options->num_jobs;
+
   // Determines whether, on completing one round of reduction passes, it is
   // worthwhile trying a further round.
   bool another_round_worthwhile = true;
@@ -186,9 +192,18 @@ Reducer::ReductionResultStatus Reducer::RunPasses(
       consumer_(SPV_MSG_INFO, nullptr, {},
                 ("Trying pass " + pass->GetName() + ".").c_str());
       do {
-        auto maybe_result =
-            pass->TryApplyReduction(*current_binary, options->target_function);
-        if (maybe_result.empty()) {
+        // Try as many steps at once as there are jobs, but no more than the
+        // step limit allows.  A pass always tries at least one step.
+        const uint32_t steps_left =
+            ReachedStepLimit(*reductions_applied, options)
+                ? 0
+                : options->step_limit - *reductions_applied;
+        const uint32_t num_candidates =
+            std::min(num_jobs, std::max(1u, steps_left));
+        std::vector<std::vector<uint32_t>> candidates =
+            pass->TryApplyReductions(*current_binary, options->target_function,
+                                     num_candidates);
+        if (candidates.empty()) {
           // For this round, the pass has no more opportunities (chunks) to
           // apply, so move on to the next pass.
           consumer_(
@@ -197,37 +212,65 @@ Reducer::ReductionResultStatus Reducer::RunPasses(
                   .c_str());
           break;
         }
-        bool interesting = false;
-        std::stringstream stringstream;
-        (*reductions_applied)++;
-        stringstream << "Pass " << pass->GetName() << " made reduction step "
-                     << *reductions_applied << ".";
-        consumer_(SPV_MSG_INFO, nullptr, {}, (stringstream.str().c_str()));
-        if (!tools.Validate(&maybe_result[0], maybe_result.size(),
-                            validator_options)) {
-          // The reduction step went wrong and an invalid binary was produced.
-          // By design, this shouldn't happen; this is a safeguard to stop an
-          // invalid binary from being regarded as interesting.
-          consumer_(SPV_MSG_INFO, nullptr, {},
-                    "Reduction step produced an invalid binary.");
-          if (options->fail_on_validation_error) {
-            // In this mode, we fail, so we update the current binary so it is
-            // output for debugging.
-            *current_binary = std::move(maybe_result);
-            return Reducer::ReductionResultStatus::kStateInvalid;
+
+        // Validate the candidates in order.  When an invalid candidate stops
+        // the reduction, the candidates after it are not needed.
+        std::vector<bool> valid;
+        for (const auto& candidate : candidates) {
+          valid.push_back(validator->Validate(candidate.data(),
+                                              candidate.size(),
+                                              nullptr) == SPV_SUCCESS);
+          if (!valid.back() && options->fail_on_validation_error) {
+            break;
+          }
+        }
+
+        // Evaluate the interestingness of the valid candidates concurrently.
+        // Each candidate is numbered as the step it would be if the ones
+        // before it proved uninteresting.
+        std::vector<char> interesting(valid.size(), 0);
+        utils::ParallelFor(valid.size(), num_jobs, [&](size_t i) {
+          interesting[i] =
+              valid[i] &&
+              interestingness_function_(
+                  candidates[i],
+                  *reductions_applied + static_cast<uint32_t>(i) + 1);
+        });
+
+        // Take the steps in order, up to the first interesting candidate.  The
+        // candidates after it were made from the binary it replaces, so they
+        // are discarded.
+        for (size_t i = 0; i < valid.size(); ++i) {
+          std::stringstream stringstream;
+          (*reductions_applied)++;
+          stringstream << "Pass " << pass->GetName() << " made reduction step "
+                       << *reductions_applied << ".";
+          consumer_(SPV_MSG_INFO, nullptr, {}, (stringstream.str().c_str()));
+          if (!valid[i]) {
+            // The reduction step went wrong and an invalid binary was
+            // produced. By design, this shouldn't happen; this is a safeguard
+            // to stop an invalid binary from being regarded as interesting.
+            consumer_(SPV_MSG_INFO, nullptr, {},
+                      "Reduction step produced an invalid binary.");
+            if (options->fail_on_validation_error) {
+              // In this mode, we fail, so we update the current binary so it
+              // is output for debugging.
+              *current_binary = std::move(candidates[i]);
+              return Reducer::ReductionResultStatus::kStateInvalid;
+            }
+          } else if (interesting[i]) {
+            // Success!  The binary produced by this reduction step is
+            // interesting, so make it the binary of interest henceforth, and
+            // note that it's worth doing another round of reduction passes.
+            consumer_(SPV_MSG_INFO, nullptr, {}, "Reduction step succeeded.");
+            *current_binary = std::move(candidates[i]);
+            another_round_worthwhile = true;
+            // We must call this before the next call to TryApplyReductions.
+            pass->NotifyInteresting(true);
+            break;
           }
-        } else if (interestingness_function_(maybe_result,
-                                             *reductions_applied)) {
-          // Success!  The binary produced by this reduction step is
-          // interesting, so make it the binary of interest henceforth, and
-          // note that it's worth doing another round of reduction passes.
-          consumer_(SPV_MSG_INFO, nullptr, {}, "Reduction step succeeded.");
-          *current_binary = std::move(maybe_result);
-          interesting = true;
-          another_round_worthwhile = true;
+          pass->NotifyInteresting(false);
         }
-        // We must call this before the next call to TryApplyReduction.
-        pass->NotifyInteresting(interesting);
         // Bail out if the reduction step limit has been reached.
       } while (!ReachedStepLimit(*reductions_applied, options));
     }
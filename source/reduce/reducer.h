@@ -19,6 +19,7 @@
 #include <string>
 
 #include "source/reduce/reduction_pass.h"
+#include "source/val/validate.h"
 #include "spirv-tools/libspirv.hpp"
 
 namespace spvtools {
@@ -75,7 +76,9 @@ class Reducer {
   void SetMessageConsumer(MessageConsumer consumer);
 
   // Sets the function that will be used to decide whether a reduced binary
-  // turned out to be interesting.
+  // turned out to be interesting.  When the reducer options allow more than
+  // one job, the function is called from several threads at once, and a step
+  // number may be passed again after the step it numbered was discarded.
   void SetInterestingnessFunction(
       InterestingnessFunction interestingness_function);
 
@@ -105,8 +108,7 @@ class Reducer {
 
   ReductionResultStatus RunPasses(
       std::vector<std::unique_ptr<ReductionPass>>* passes,
-      spv_const_reducer_options options,
-      spv_validator_options validator_options, const SpirvTools& tools,
+      spv_const_reducer_options options, val::IncrementalValidator* validator,
       std::vector<uint32_t>* current_binary, uint32_t* reductions_applied);
 
   const spv_target_env target_env_;
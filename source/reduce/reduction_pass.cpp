@@ -23,6 +23,17 @@ namespace reduce {
 
 std::vector<uint32_t> ReductionPass::TryApplyReduction(
     const std::vector<uint32_t>& binary, uint32_t target_function) {
+  std::vector<std::vector<uint32_t>> results =
+      TryApplyReductions(binary, target_function, 1);
+  if (results.empty()) {
+    return std::vector<uint32_t>();
+  }
+  return std::move(results[0]);
+}
+
+std::vector<std::vector<uint32_t>> ReductionPass::TryApplyReductions(
+    const std::vector<uint32_t>& binary, uint32_t target_function,
+    uint32_t max_candidates) {
   // We represent modules as binaries because (a) attempts at reduction need to
   // end up in binary form to be passed on to SPIR-V-consuming tools, and (b)
   // when we apply a reduction step we need to do it on a fresh version of the
@@ -44,6 +55,7 @@ std::vector<uint32_t> ReductionPass::TryApplyReduction(
 
   assert(granularity_ > 0);
 
+  std::vector<std::vector<uint32_t>> results;
   if (index_ >= opportunities.size()) {
     // We have reached the end of the available opportunities and, therefore,
     // the end of the round for this pass, so reset the index and decrease the
@@ -51,18 +63,33 @@ std::vector<uint32_t> ReductionPass::TryApplyReduction(
     // of the round.
     index_ = 0;
     granularity_ = std::max((uint32_t)1, granularity_ / 2);
-    return std::vector<uint32_t>();
+    return results;
   }
 
-  for (uint32_t i = index_;
-       i < std::min(index_ + granularity_, (uint32_t)opportunities.size());
-       ++i) {
-    opportunities[i]->TryToApply();
+  for (uint32_t candidate = 0; candidate < max_candidates; ++candidate) {
+    const size_t begin = index_ + size_t(candidate) * granularity_;
+    if (begin >= opportunities.size()) {
+      break;
+    }
+    if (candidate > 0) {
+      // Each chunk is applied to a fresh copy of the module.  The
+      // opportunities of a module are found in the same order each time.
+      context =
+          BuildModule(target_env_, consumer_, binary.data(), binary.size());
+      assert(context);
+      opportunities =
+          finder_->GetAvailableOpportunities(context.get(), target_function);
+    }
+    for (size_t i = begin;
+         i < std::min(begin + granularity_, opportunities.size()); ++i) {
+      opportunities[i]->TryToApply();
+    }
+
+    std::vector<uint32_t> result;
+    context->module()->ToBinary(&result, false);
+    results.push_back(std::move(result));
   }
-
-  std::vector<uint32_t> result;
-  context->module()->ToBinary(&result, false);
-  return result;
+  return results;
 }
 
 void ReductionPass::SetMessageConsumer(MessageConsumer consumer) {
@@ -56,6 +56,18 @@ class ReductionPass {
   std::vector<uint32_t> TryApplyReduction(const std::vector<uint32_t>& binary,
                                           uint32_t target_function);
 
+  // Like TryApplyReduction, but applies up to |max_candidates| consecutive
+  // chunks, each to a fresh copy of the given binary, and returns one binary
+  // per chunk, in order.  These are the binaries that successive calls to
+  // TryApplyReduction would return if each one proved uninteresting.  Before
+  // the next call, the caller must invoke NotifyInteresting(...) for the
+  // returned binaries in order, up to and including the first interesting
+  // one; the binaries after it are discarded.  Returns an empty vector at the
+  // end of a round, as TryApplyReduction does.
+  std::vector<std::vector<uint32_t>> TryApplyReductions(
+      const std::vector<uint32_t>& binary, uint32_t target_function,
+      uint32_t max_candidates);
+
   // Notifies the reduction pass whether the binary returned from
   // TryApplyReduction is interesting, so that the next call to
   // TryApplyReduction will avoid applying the same chunk of opportunities.
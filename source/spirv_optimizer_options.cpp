@@ -49,3 +49,30 @@ SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetPreserveSpecConstants(
     spv_optimizer_options options, bool val) {
   options->preserve_spec_constants_ = val;
 }
+
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetArenaAllocation(
+    spv_optimizer_options options, bool val) {
+  options->arena_allocation_ = val;
+}
+
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetCacheDirectory(
+    spv_optimizer_options options, const char* directory) {
+  options->cache_directory_ = directory ? directory : "";
+}
+
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetAnalysisSnapshot(
+    spv_optimizer_options options, const char* path) {
+  options->analysis_snapshot_ = path ? path : "";
+}
+
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetNumThreads(
+    spv_optimizer_options options, uint32_t num_threads) {
+  options->num_threads_ = num_threads;
+}
+
+SPIRV_TOOLS_EXPORT void spvOptimizerOptionsSetPassObserver(
+    spv_optimizer_options options, spv_pass_observer_fn_t observer,
+    void* user_data) {
+  options->pass_observer_ = observer;
+  options->pass_observer_data_ = user_data;
+}
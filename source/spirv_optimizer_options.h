@@ -15,6 +15,8 @@
 #ifndef SOURCE_SPIRV_OPTIMIZER_OPTIONS_H_
 #define SOURCE_SPIRV_OPTIMIZER_OPTIONS_H_
 
+#include <string>
+
 #include "source/spirv_validator_options.h"
 #include "spirv-tools/libspirv.h"
 
@@ -26,7 +28,13 @@ struct spv_optimizer_options_t {
         val_options_(),
         max_id_bound_(kDefaultMaxIdBound),
         preserve_bindings_(false),
-        preserve_spec_constants_(false) {}
+        preserve_spec_constants_(false),
+        arena_allocation_(false),
+        cache_directory_(),
+        analysis_snapshot_(),
+        num_threads_(1),
+        pass_observer_(nullptr),
+        pass_observer_data_(nullptr) {}
 
   // When true the validator will be run before optimizations are run.
   bool run_validator_;
@@ -45,5 +53,25 @@ struct spv_optimizer_options_t {
   // When true, all specialization constants within the module should be
   // preserved.
   bool preserve_spec_constants_;
+
+  // When true, the instructions of the module are allocated from an arena.
+  bool arena_allocation_;
+
+  // The directory of the on-disk cache of optimization results, or empty if
+  // results are not cached.
+  std::string cache_directory_;
+
+  // The file the analysis snapshot is read from and written to, or empty if
+  // none is.
+  std::string analysis_snapshot_;
+
+  // The number of threads passes may use to analyze functions concurrently,
+  // or 0 for one per hardware thread.
+  uint32_t num_threads_;
+
+  // The function called with the measurements of each pass, if any, and the
+  // data it is called with.
+  spv_pass_observer_fn_t pass_observer_;
+  void* pass_observer_data_;
 };
 #endif  // SOURCE_SPIRV_OPTIMIZER_OPTIONS_H_
@@ -25,7 +25,8 @@ const uint32_t kDefaultStepLimit = 2500;
 spv_reducer_options_t::spv_reducer_options_t()
     : step_limit(kDefaultStepLimit),
       fail_on_validation_error(false),
-      target_function(0) {}
+      target_function(0),
+      num_jobs(1) {}
 
 SPIRV_TOOLS_EXPORT spv_reducer_options spvReducerOptionsCreate() {
   return new spv_reducer_options_t();
@@ -49,3 +50,8 @@ SPIRV_TOOLS_EXPORT void spvReducerOptionsSetTargetFunction(
     spv_reducer_options options, uint32_t target_function) {
   options->target_function = target_function;
 }
+
+SPIRV_TOOLS_EXPORT void spvReducerOptionsSetNumJobs(spv_reducer_options options,
+                                                    uint32_t num_jobs) {
+  options->num_jobs = num_jobs;
+}
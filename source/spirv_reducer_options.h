@@ -33,6 +33,9 @@ struct spv_reducer_options_t {
 
   // See spvReducerOptionsSetTargetFunction.
   uint32_t target_function;
+
+  // See spvReducerOptionsSetNumJobs.
+  uint32_t num_jobs;
 };
 
 #endif  // SOURCE_SPIRV_REDUCER_OPTIONS_H_
@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <cstring>
+#include <sstream>
 
 bool spvParseUniversalLimitsOptions(const char* s, spv_validator_limit* type) {
   auto match = [s](const char* b) {
@@ -125,3 +126,39 @@ void spvValidatorOptionsSetAllowLocalSizeId(spv_validator_options options,
                                             bool val) {
   options->allow_localsizeid = val;
 }
+
+void spvValidatorOptionsSetNumThreads(spv_validator_options options,
+                                      uint32_t num_threads) {
+  options->num_threads = num_threads;
+}
+
+std::string spvValidatorOptionsCacheConfig(
+    const spv_validator_options_t& options) {
+  const validator_universal_limits_t& limits = options.universal_limits_;
+  std::ostringstream config;
+  config << "validator-limits " << limits.max_struct_members << " "
+         << limits.max_struct_depth << " " << limits.max_local_variables << " "
+         << limits.max_global_variables << " " << limits.max_switch_branches
+         << " " << limits.max_function_args << " "
+         << limits.max_control_flow_nesting_depth << " "
+         << limits.max_access_chain_indexes << " " << limits.max_id_bound
+         << "\n"
+         << "validator-flags " << options.relax_struct_store
+         << options.relax_logical_pointer << options.relax_block_layout
+         << options.uniform_buffer_standard_layout
+         << options.scalar_block_layout
+         << options.workgroup_scalar_block_layout << options.skip_block_layout
+         << options.allow_localsizeid << options.before_hlsl_legalization
+         << "\n";
+  return config.str();
+}
+
+std::string spvValidatorConfig(spv_target_env env,
+                               const spv_validator_options_t& options) {
+  std::ostringstream config;
+  config << "validate\n"
+         << "version " << spvSoftwareVersionDetailsString() << "\n"
+         << "target-env " << env << "\n"
+         << spvValidatorOptionsCacheConfig(options);
+  return config.str();
+}
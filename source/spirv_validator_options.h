@@ -15,6 +15,8 @@
 #ifndef SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
 #define SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
 
+#include <string>
+
 #include "spirv-tools/libspirv.h"
 
 // Return true if the command line option for the validator limit is valid (Also
@@ -48,7 +50,8 @@ struct spv_validator_options_t {
         workgroup_scalar_block_layout(false),
         skip_block_layout(false),
         allow_localsizeid(false),
-        before_hlsl_legalization(false) {}
+        before_hlsl_legalization(false),
+        num_threads(1) {}
 
   validator_universal_limits_t universal_limits_;
   bool relax_struct_store;
@@ -60,6 +63,19 @@ struct spv_validator_options_t {
   bool skip_block_layout;
   bool allow_localsizeid;
   bool before_hlsl_legalization;
+  // Number of threads used for the per-function checks. 0 means one thread per
+  // hardware thread.
+  uint32_t num_threads;
 };
 
+// Returns a description of the options that decide whether a module is valid,
+// for keying caches of results that depend on it.
+std::string spvValidatorOptionsCacheConfig(
+    const spv_validator_options_t& options);
+
+// Returns a description of everything, besides the module, that decides the
+// result of validating a module for |env| with |options|.
+std::string spvValidatorConfig(spv_target_env env,
+                                    const spv_validator_options_t& options);
+
 #endif  // SOURCE_SPIRV_VALIDATOR_OPTIONS_H_
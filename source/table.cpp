@@ -14,6 +14,7 @@
 
 #include "source/table.h"
 
+#include <cstring>
 #include <utility>
 
 spv_context spvContextCreate(spv_target_env env) {
@@ -62,6 +63,15 @@ spv_context spvContextCreate(spv_target_env env) {
 
 void spvContextDestroy(spv_context context) { delete context; }
 
+int spvtools::CompareTableName(const char* entry_name, const char* name,
+                               size_t length) {
+  const int result = strncmp(entry_name, name, length);
+  if (result != 0) return result;
+  // The first |length| characters match, so the entry name is greater unless
+  // it ends there.
+  return entry_name[length] == '\0' ? 0 : 1;
+}
+
 void spvtools::SetContextMessageConsumer(spv_context context,
                                          spvtools::MessageConsumer consumer) {
   context->consumer = std::move(consumer);
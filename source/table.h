@@ -15,6 +15,11 @@
 #ifndef SOURCE_TABLE_H_
 #define SOURCE_TABLE_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
 #include "source/extensions.h"
 #include "source/latest_version_spirv_header.h"
 #include "spirv-tools/libspirv.hpp"
@@ -67,6 +72,8 @@ typedef struct spv_operand_desc_group_t {
   const spv_operand_type_t type;
   const uint32_t count;
   const spv_operand_desc_t* entries;
+  // The positions of the entries, in the order of their names.
+  const uint16_t* nameIndex;
 } spv_operand_desc_group_t;
 
 typedef struct spv_ext_inst_desc_t {
@@ -81,11 +88,15 @@ typedef struct spv_ext_inst_group_t {
   const spv_ext_inst_type_t type;
   const uint32_t count;
   const spv_ext_inst_desc_t* entries;
+  // The positions of the entries, in the order of their names.
+  const uint16_t* nameIndex;
 } spv_ext_inst_group_t;
 
 typedef struct spv_opcode_table_t {
   const uint32_t count;
   const spv_opcode_desc_t* entries;
+  // The positions of the entries, in the order of their names.
+  const uint16_t* nameIndex;
 } spv_opcode_table_t;
 
 typedef struct spv_operand_table_t {
@@ -116,6 +127,32 @@ struct spv_context_t {
 
 namespace spvtools {
 
+// Compares |entry_name| with the |length| characters at |name|, which need not
+// be null-terminated.  Returns a negative number, zero or a positive number
+// if |entry_name| is less than, equal to or greater than the name, in the
+// order used by strcmp.
+int CompareTableName(const char* entry_name, const char* name, size_t length);
+
+// Returns the range of |name_index|, the positions of the |count| |entries| of
+// a table in the order of their names, that refer to the entries named by the
+// |length| characters at |name|.  The range is in table order.
+template <typename Entry>
+std::pair<const uint16_t*, const uint16_t*> EqualRangeOfName(
+    const Entry* entries, const uint16_t* name_index, uint32_t count,
+    const char* name, size_t length) {
+  const uint16_t* begin = name_index;
+  const uint16_t* end = name_index + count;
+  const uint16_t* first = std::lower_bound(
+      begin, end, name, [entries, length](uint16_t index, const char* key) {
+        return CompareTableName(entries[index].name, key, length) < 0;
+      });
+  const uint16_t* last = std::upper_bound(
+      first, end, name, [entries, length](const char* key, uint16_t index) {
+        return CompareTableName(entries[index].name, key, length) > 0;
+      });
+  return {first, last};
+}
+
 // Sets the message consumer to |consumer| in the given |context|. The original
 // message consumer will be overwritten.
 void SetContextMessageConsumer(spv_context context, MessageConsumer consumer);
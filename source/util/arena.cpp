@@ -0,0 +1,93 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/arena.h"
+
+#include <new>
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+// Every allocation is preceded by a header recording the arena it came from,
+// or nullptr for the heap.  The header is padded so the storage that follows
+// it keeps the alignment of the underlying allocation.
+constexpr size_t kHeaderSize = alignof(std::max_align_t) > sizeof(Arena*)
+                                   ? alignof(std::max_align_t)
+                                   : sizeof(Arena*);
+
+// The size of the chunks the arena carves allocations from.  Requests larger
+// than a quarter of this get a chunk of their own so that little space is
+// wasted at the end of the current chunk.
+constexpr size_t kChunkSize = 64 * 1024;
+
+thread_local Arena* current_arena = nullptr;
+
+size_t RoundUpToHeaderSize(size_t size) {
+  return (size + kHeaderSize - 1) / kHeaderSize * kHeaderSize;
+}
+
+}  // namespace
+
+void* Arena::Allocate(size_t size) {
+  Arena* arena = current_arena;
+  const size_t block_size = kHeaderSize + size;
+  char* block = arena ? arena->AllocateBlock(block_size)
+                      : static_cast<char*>(::operator new(block_size));
+  *reinterpret_cast<Arena**>(block) = arena;
+  return block + kHeaderSize;
+}
+
+void Arena::Deallocate(void* ptr) {
+  if (ptr == nullptr) return;
+  char* block = static_cast<char*>(ptr) - kHeaderSize;
+  Arena* arena = *reinterpret_cast<Arena**>(block);
+  if (arena == nullptr) {
+    ::operator delete(block);
+  } else {
+    arena->Unref();
+  }
+}
+
+char* Arena::AllocateBlock(size_t size) {
+  size = RoundUpToHeaderSize(size);
+  ++refs_;
+  if (size > kChunkSize / 4) {
+    chunks_.emplace_back(new char[size]);
+    reserved_bytes_ += size;
+    return chunks_.back().get();
+  }
+  if (static_cast<size_t>(end_ - next_) < size) {
+    chunks_.emplace_back(new char[kChunkSize]);
+    reserved_bytes_ += kChunkSize;
+    next_ = chunks_.back().get();
+    end_ = next_ + kChunkSize;
+  }
+  char* block = next_;
+  next_ += size;
+  return block;
+}
+
+void Arena::Unref() {
+  if (--refs_ == 0) delete this;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : previous_(current_arena) {
+  current_arena = arena;
+}
+
+ArenaScope::~ArenaScope() { current_arena = previous_; }
+
+}  // namespace utils
+}  // namespace spvtools
@@ -0,0 +1,98 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_ARENA_H_
+#define SOURCE_UTIL_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A bump allocator for objects that are created in bulk and are usually
+// destroyed together, such as the instructions of a module being loaded.
+//
+// Classes opt in by routing their operator new and operator delete to
+// Arena::Allocate and Arena::Deallocate.  Objects of those classes are placed
+// in the arena made current on the allocating thread with an ArenaScope, or
+// on the heap when there is none.  Deallocating an object from an arena does
+// not reuse its memory; the arena returns all of its memory at once when its
+// owner has released it and every object allocated from it has been
+// deallocated.  Objects may therefore outlive the owner of their arena, and
+// may be deallocated on any thread.
+class Arena {
+ public:
+  // Releases the owner's reference to the arena when an Arena::Ptr goes away.
+  struct Releaser {
+    void operator()(Arena* arena) const { arena->Unref(); }
+  };
+  using Ptr = std::unique_ptr<Arena, Releaser>;
+
+  // Returns a new arena owned by the returned pointer.
+  static Ptr Create() { return Ptr(new Arena()); }
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Returns |size| bytes of storage, suitably aligned for any object, taken
+  // from the current arena of this thread or from the heap.
+  static void* Allocate(size_t size);
+
+  // Returns storage obtained from Allocate.
+  static void Deallocate(void* ptr);
+
+  // Returns the number of bytes reserved from the system by this arena.
+  size_t reserved_bytes() const { return reserved_bytes_; }
+
+ private:
+  Arena() : refs_(1), next_(nullptr), end_(nullptr), reserved_bytes_(0) {}
+  ~Arena() = default;
+
+  // Returns |size| bytes of storage from the arena and takes a reference for
+  // it.
+  char* AllocateBlock(size_t size);
+
+  // Drops a reference and destroys the arena when it was the last one.
+  void Unref();
+
+  // One reference for the owner plus one per live allocation.
+  std::atomic<size_t> refs_;
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  char* next_;
+  char* end_;
+  size_t reserved_bytes_;
+};
+
+// Makes |arena| the current arena of the calling thread for the lifetime of
+// the scope.  Scopes nest; the previous arena is restored on destruction.
+// An arena must not be current on more than one thread at a time.
+class ArenaScope {
+ public:
+  explicit ArenaScope(Arena* arena);
+  ~ArenaScope();
+
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+ private:
+  Arena* previous_;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_ARENA_H_
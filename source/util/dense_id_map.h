@@ -0,0 +1,298 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_DENSE_ID_MAP_H_
+#define SOURCE_UTIL_DENSE_ID_MAP_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A map from SPIR-V ids to values of type |T|, stored in tables indexed by
+// id.  Ids in a module are dense in [1, id bound), so this replaces the
+// hashing and node allocation of an std::unordered_map with indexed loads.
+// The interface is the subset of std::unordered_map used by the analyses,
+// and iteration visits entries in increasing id order.
+//
+// Entries live in fixed-size pages that are allocated when the first id in
+// them is inserted and are never moved, so, as with std::unordered_map,
+// references to values stay valid when other ids are inserted or erased.
+// The page table grows with the largest id inserted, so this is not suited to
+// maps keyed by arbitrary integers.
+template <typename T>
+class DenseIdMap {
+  // Marks an unoccupied slot.  Never a valid id, since ids are less than the
+  // id bound.
+  static constexpr uint32_t kNoId = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t kPageBits = 8;
+  static constexpr size_t kPageSize = size_t(1) << kPageBits;
+
+ public:
+  using key_type = uint32_t;
+  using mapped_type = T;
+  using value_type = std::pair<uint32_t, T>;
+  using size_type = size_t;
+
+  template <typename Map, typename Value>
+  class iterator_template {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::remove_const<Value>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    iterator_template() : map_(nullptr), index_(0) {}
+
+    // Allows conversion from iterator to const_iterator.
+    template <typename OtherMap, typename OtherValue,
+              typename = typename std::enable_if<
+                  std::is_convertible<OtherValue*, Value*>::value>::type>
+    iterator_template(const iterator_template<OtherMap, OtherValue>& that)
+        : map_(that.map_), index_(that.index_) {}
+
+    reference operator*() const { return map_->Slot(index_); }
+    pointer operator->() const { return &map_->Slot(index_); }
+
+    iterator_template& operator++() {
+      ++index_;
+      SkipEmpty();
+      return *this;
+    }
+
+    iterator_template operator++(int) {
+      iterator_template old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const iterator_template& that) const {
+      return map_ == that.map_ && index_ == that.index_;
+    }
+    bool operator!=(const iterator_template& that) const {
+      return !(*this == that);
+    }
+
+   private:
+    friend class DenseIdMap;
+    template <typename OtherMap, typename OtherValue>
+    friend class iterator_template;
+
+    iterator_template(Map* map, size_t index) : map_(map), index_(index) {
+      SkipEmpty();
+    }
+
+    void SkipEmpty() {
+      const size_t capacity = map_->capacity();
+      while (index_ < capacity) {
+        if (!map_->pages_[index_ >> kPageBits]) {
+          // Skip the whole page.
+          index_ = ((index_ >> kPageBits) + 1) << kPageBits;
+        } else if (map_->Slot(index_).first == kNoId) {
+          ++index_;
+        } else {
+          return;
+        }
+      }
+      index_ = capacity;
+    }
+
+    Map* map_;
+    size_t index_;
+  };
+
+  using iterator = iterator_template<DenseIdMap, value_type>;
+  using const_iterator = iterator_template<const DenseIdMap, const value_type>;
+
+  DenseIdMap() : size_(0) {}
+
+  DenseIdMap(const DenseIdMap& that) : size_(0) { *this = that; }
+  // Leaves |that| empty.
+  DenseIdMap(DenseIdMap&& that) noexcept
+      : pages_(std::move(that.pages_)), size_(that.size_) {
+    that.pages_.clear();
+    that.size_ = 0;
+  }
+
+  DenseIdMap& operator=(const DenseIdMap& that) {
+    if (this == &that) return *this;
+    clear();
+    for (const value_type& entry : that) insert(entry);
+    return *this;
+  }
+  // Leaves |that| empty.
+  DenseIdMap& operator=(DenseIdMap&& that) noexcept {
+    if (this == &that) return *this;
+    pages_ = std::move(that.pages_);
+    size_ = that.size_;
+    that.pages_.clear();
+    that.size_ = 0;
+    return *this;
+  }
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, capacity()); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, capacity()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Sizes the page table for ids less than |id_bound|.  Pages themselves are
+  // only allocated once an id in them is inserted.
+  void reserve(uint32_t id_bound) {
+    const size_t page_count = (static_cast<size_t>(id_bound) + kPageSize - 1)
+                              >> kPageBits;
+    if (page_count > pages_.size()) pages_.resize(page_count);
+  }
+
+  void clear() {
+    pages_.clear();
+    size_ = 0;
+  }
+
+  iterator find(uint32_t id) {
+    return Contains(id) ? iterator(this, id) : end();
+  }
+  const_iterator find(uint32_t id) const {
+    return Contains(id) ? const_iterator(this, id) : end();
+  }
+
+  size_t count(uint32_t id) const { return Contains(id) ? 1 : 0; }
+
+  // Returns the value for |id|, which must be present.
+  T& at(uint32_t id) {
+    assert(Contains(id) && "Id is not in the map.");
+    return Slot(id).second;
+  }
+  const T& at(uint32_t id) const {
+    assert(Contains(id) && "Id is not in the map.");
+    return Slot(id).second;
+  }
+
+  // Returns the value for |id|, inserting a value-initialized one if |id| is
+  // not present.
+  T& operator[](uint32_t id) { return Occupy(id).first->second; }
+
+  // Inserts |value| unless its id is already present.  Returns an iterator to
+  // the entry for the id, and whether the insertion took place.
+  std::pair<iterator, bool> insert(const value_type& value) {
+    std::pair<iterator, bool> result = Occupy(value.first);
+    if (result.second) result.first->second = value.second;
+    return result;
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    std::pair<iterator, bool> result = Occupy(value.first);
+    if (result.second) result.first->second = std::move(value.second);
+    return result;
+  }
+
+  // Removes the entry for |id|, if any.  Returns the number of entries
+  // removed.
+  size_t erase(uint32_t id) {
+    if (!Contains(id)) return 0;
+    Slot(id) = EmptySlot();
+    --size_;
+    return 1;
+  }
+
+  // Removes the entry at |pos|, and returns an iterator to the entry after it.
+  iterator erase(const_iterator pos) {
+    const size_t index = pos.index_;
+    erase(static_cast<uint32_t>(index));
+    return iterator(this, index + 1);
+  }
+
+  friend bool operator==(const DenseIdMap& lhs, const DenseIdMap& rhs) {
+    if (lhs.size_ != rhs.size_) return false;
+    for (const value_type& entry : lhs) {
+      if (!rhs.Contains(entry.first) ||
+          !(rhs.Slot(entry.first).second == entry.second)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  friend bool operator!=(const DenseIdMap& lhs, const DenseIdMap& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  static value_type EmptySlot() { return value_type(kNoId, T()); }
+
+  size_t capacity() const { return pages_.size() << kPageBits; }
+
+  value_type& Slot(size_t index) {
+    return pages_[index >> kPageBits][index & (kPageSize - 1)];
+  }
+  const value_type& Slot(size_t index) const {
+    return pages_[index >> kPageBits][index & (kPageSize - 1)];
+  }
+
+  bool Contains(uint32_t id) const {
+    return id < capacity() && pages_[id >> kPageBits] &&
+           Slot(id).first != kNoId;
+  }
+
+  // Allocates the page holding the slot for |id|, if needed.
+  void AllocateSlot(uint32_t id) {
+    const size_t page_index = static_cast<size_t>(id) >> kPageBits;
+    if (page_index >= pages_.size()) {
+      pages_.resize(std::max(page_index + 1, pages_.size() * 2));
+    }
+    std::unique_ptr<value_type[]>& page = pages_[page_index];
+    if (page) return;
+    page.reset(new value_type[kPageSize]);
+    for (size_t i = 0; i < kPageSize; ++i) page[i].first = kNoId;
+  }
+
+  // Makes sure |id| has an entry.  Returns an iterator to it, and whether it
+  // was added.
+  std::pair<iterator, bool> Occupy(uint32_t id) {
+    assert(id != kNoId && "Invalid id.");
+    AllocateSlot(id);
+    value_type& slot = Slot(id);
+    if (slot.first != kNoId) return {iterator(this, id), false};
+    slot.first = id;
+    ++size_;
+    return {iterator(this, id), true};
+  }
+
+  std::vector<std::unique_ptr<value_type[]>> pages_;
+  size_t size_;
+};
+
+template <typename T>
+constexpr uint32_t DenseIdMap<T>::kNoId;
+template <typename T>
+constexpr uint32_t DenseIdMap<T>::kPageBits;
+template <typename T>
+constexpr size_t DenseIdMap<T>::kPageSize;
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_DENSE_ID_MAP_H_
@@ -0,0 +1,61 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+uint32_t HardwareConcurrency() {
+#if defined(SPIRV_EMSCRIPTEN)
+  return 1;
+#else
+  const unsigned count = std::thread::hardware_concurrency();
+  return count == 0 ? 1 : static_cast<uint32_t>(count);
+#endif
+}
+
+void ParallelFor(size_t count, uint32_t num_threads,
+                 const std::function<void(size_t)>& func) {
+#if defined(SPIRV_EMSCRIPTEN)
+  // Emscripten builds are not compiled with thread support.
+  num_threads = 1;
+#endif
+  const size_t thread_count =
+      std::min(static_cast<size_t>(std::max(num_threads, 1u)), count);
+  if (thread_count <= 1) {
+    for (size_t i = 0; i < count; ++i) func(i);
+    return;
+  }
+
+  std::atomic<size_t> next_index(0);
+  auto worker = [&next_index, count, &func]() {
+    for (size_t i = next_index++; i < count; i = next_index++) func(i);
+  };
+
+  // The calling thread does its share of the work too.
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (size_t i = 1; i < thread_count; ++i) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace utils
+}  // namespace spvtools
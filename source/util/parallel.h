@@ -0,0 +1,43 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_PARALLEL_H_
+#define SOURCE_UTIL_PARALLEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace spvtools {
+namespace utils {
+
+// Returns the number of threads the hardware can run concurrently, or 1 if
+// that cannot be determined.
+uint32_t HardwareConcurrency();
+
+// Calls |func| once for every index in [0, |count|), using at most
+// |num_threads| threads including the calling thread.  Indices are handed out
+// in increasing order, but no ordering is guaranteed between calls running on
+// different threads, so |func| must only touch state that is private to its
+// index or otherwise safe to share.  Returns once every call has finished.
+//
+// When |num_threads| is 0 or 1, or when threads are not available on the
+// target platform, every call is made on the calling thread in index order.
+void ParallelFor(size_t count, uint32_t num_threads,
+                 const std::function<void(size_t)>& func);
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_PARALLEL_H_
@@ -0,0 +1,159 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/result_cache.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+// Identifies a cache entry file, and the version of its format.
+const uint32_t kEntryMagic = 0x53505643;  // "CVPS"
+
+// The number of words that precede the result in an entry file: the magic
+// number and the two halves of the check hash.
+const size_t kEntryHeaderWords = 3;
+
+// Computes a 64-bit FNV-1a hash of |size| bytes at |data|, continuing from
+// |hash|.
+uint64_t HashFnv1a(const void* data, size_t size, uint64_t hash) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Computes a multiplicative hash of |size| bytes at |data|, continuing from
+// |hash|.  It is unrelated to FNV-1a, so the pair of them behaves as a 128-bit
+// hash.
+uint64_t HashMix(const void* data, size_t size, uint64_t hash) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+// Returns |value| as 16 hexadecimal digits.
+std::string ToHex(uint64_t value) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::string hex(16, '0');
+  for (size_t i = 0; i < 16; ++i) {
+    hex[15 - i] = kDigits[value & 0xf];
+    value >>= 4;
+  }
+  return hex;
+}
+
+// Returns a name for a temporary file next to |path| that no other thread or
+// process is using.
+std::string TemporaryPath(const std::string& path) {
+  static std::atomic<uint32_t> counter(0);
+  const uint64_t time = static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+  const uint64_t thread =
+      std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::ostringstream name;
+  name << path << ".tmp-" << ToHex(time ^ (thread << 16)) << "-"
+       << counter++;
+  return name.str();
+}
+
+}  // namespace
+
+ResultCacheEntry::ResultCacheEntry(const std::string& directory,
+                                   const std::string& config,
+                                   const uint32_t* words, size_t num_words) {
+  uint64_t name_hash = 0xcbf29ce484222325ULL;
+  name_hash = HashFnv1a(config.data(), config.size(), name_hash);
+  name_hash = HashFnv1a(words, num_words * sizeof(uint32_t), name_hash);
+
+  uint64_t check_hash = 0x2545f4914f6cdd1dULL;
+  check_hash = HashMix(config.data(), config.size(), check_hash);
+  check_hash = HashMix(words, num_words * sizeof(uint32_t), check_hash);
+  // Also account for the length, so that moving bytes between the config and
+  // the module cannot give the same hash.
+  check_hash = HashMix(&num_words, sizeof(num_words), check_hash);
+  check_ = check_hash;
+
+  path_ = directory;
+  if (!path_.empty() && path_.back() != '/' && path_.back() != '\\') {
+    path_ += '/';
+  }
+  path_ += ToHex(name_hash) + ".spv";
+}
+
+bool ResultCacheEntry::Load(std::vector<uint32_t>* binary) const {
+  std::ifstream file(path_, std::ios::binary | std::ios::ate);
+  if (!file) return false;
+  const std::streamoff end = file.tellg();
+  if (end < 0) return false;
+  const size_t size = static_cast<size_t>(end);
+  if (size < kEntryHeaderWords * sizeof(uint32_t) ||
+      size % sizeof(uint32_t) != 0) {
+    return false;
+  }
+  file.seekg(0);
+
+  std::vector<uint32_t> words(size / sizeof(uint32_t));
+  if (!file.read(reinterpret_cast<char*>(words.data()), end)) return false;
+  if (words[0] != kEntryMagic || words[1] != static_cast<uint32_t>(check_) ||
+      words[2] != static_cast<uint32_t>(check_ >> 32)) {
+    return false;
+  }
+
+  words.erase(words.begin(), words.begin() + kEntryHeaderWords);
+  binary->swap(words);
+  return true;
+}
+
+void ResultCacheEntry::Store(const std::vector<uint32_t>& binary) const {
+  const uint32_t header[kEntryHeaderWords] = {
+      kEntryMagic, static_cast<uint32_t>(check_),
+      static_cast<uint32_t>(check_ >> 32)};
+
+  const std::string temporary_path = TemporaryPath(path_);
+  {
+    std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+    if (!file) return;
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(binary.data()),
+               static_cast<std::streamsize>(binary.size() * sizeof(uint32_t)));
+    if (!file.flush()) {
+      file.close();
+      std::remove(temporary_path.c_str());
+      return;
+    }
+  }
+
+  // Renaming fails on some platforms when the entry already exists, in which
+  // case another writer has stored the same result.
+  if (std::rename(temporary_path.c_str(), path_.c_str()) != 0) {
+    std::remove(temporary_path.c_str());
+  }
+}
+
+}  // namespace utils
+}  // namespace spvtools
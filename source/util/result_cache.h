@@ -0,0 +1,64 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_RESULT_CACHE_H_
+#define SOURCE_UTIL_RESULT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// The entry of an on-disk cache of the results of a tool, such as the
+// optimizer or the validator, for one input module.
+//
+// Entries are files in the cache directory, named after a hash of the module
+// and of |config|, a description of everything else that determines the
+// result, such as the tool, its passes and its options.  A second,
+// independent hash is stored in the file and checked on load, so a collision
+// of file names is treated as a miss rather than returning the result for
+// another module.
+//
+// Any number of threads or processes may share a cache directory.  Entries
+// are written to a temporary file that is then renamed, so readers never see
+// a partial entry.
+class ResultCacheEntry {
+ public:
+  ResultCacheEntry(const std::string& directory, const std::string& config,
+                   const uint32_t* words, size_t num_words);
+
+  // If the entry exists, replaces the contents of |binary| with the cached
+  // result and returns true.  Otherwise, leaves |binary| alone and returns
+  // false.
+  bool Load(std::vector<uint32_t>* binary) const;
+
+  // Records |binary| as the result.  The cache is only an optimization, so
+  // failing to write it is not an error.
+  void Store(const std::vector<uint32_t>& binary) const;
+
+  // Returns the path of the file holding the entry.
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+  uint64_t check_;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_RESULT_CACHE_H_
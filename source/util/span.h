@@ -0,0 +1,66 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOURCE_UTIL_SPAN_H_
+#define SOURCE_UTIL_SPAN_H_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A view of |size| contiguous elements of type |T| owned by someone else, in
+// the manner of C++20's std::span.  The owner must keep the elements alive
+// for as long as the span is used.
+template <typename T>
+class Span {
+ public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = T*;
+
+  Span() : data_(nullptr), size_(0) {}
+  Span(T* data, size_t size) : data_(data), size_(size) {}
+
+  // Views the elements of |vec|.
+  template <typename U>
+  Span(const std::vector<U>& vec) : data_(vec.data()), size_(vec.size()) {}
+
+  T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  iterator begin() const { return data_; }
+  iterator end() const { return data_ + size_; }
+  const_iterator cbegin() const { return data_; }
+  const_iterator cend() const { return data_ + size_; }
+
+  T& operator[](size_t index) const {
+    assert(index < size_);
+    return data_[index];
+  }
+  T& front() const { return (*this)[0]; }
+  T& back() const { return (*this)[size_ - 1]; }
+
+ private:
+  T* data_;
+  size_t size_;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // SOURCE_UTIL_SPAN_H_
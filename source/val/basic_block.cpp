@@ -79,23 +79,70 @@ void BasicBlock::RegisterSuccessors(
 }
 
 bool BasicBlock::dominates(const BasicBlock& other) const {
+  if (HasDominatorIntervals(kDominatorTree, other)) {
+    return DominatorIntervalEncloses(kDominatorTree, other);
+  }
   return (this == &other) ||
          !(other.dom_end() ==
            std::find(other.dom_begin(), other.dom_end(), this));
 }
 
 bool BasicBlock::structurally_dominates(const BasicBlock& other) const {
+  if (HasDominatorIntervals(kStructuralDominatorTree, other)) {
+    return DominatorIntervalEncloses(kStructuralDominatorTree, other);
+  }
   return (this == &other) || !(other.structural_dom_end() ==
                                std::find(other.structural_dom_begin(),
                                          other.structural_dom_end(), this));
 }
 
 bool BasicBlock::structurally_postdominates(const BasicBlock& other) const {
+  if (HasDominatorIntervals(kStructuralPostDominatorTree, other)) {
+    return DominatorIntervalEncloses(kStructuralPostDominatorTree, other);
+  }
   return (this == &other) || !(other.structural_pdom_end() ==
                                std::find(other.structural_pdom_begin(),
                                          other.structural_pdom_end(), this));
 }
 
+const BasicBlock* BasicBlock::immediate_dominator(
+    DominatorTreeKind tree) const {
+  switch (tree) {
+    case kDominatorTree:
+      return immediate_dominator_;
+    case kStructuralDominatorTree:
+      return immediate_structural_dominator_;
+    case kStructuralPostDominatorTree:
+      return immediate_structural_post_dominator_;
+    case kDominatorTreeCOUNT:
+      break;
+  }
+  return nullptr;
+}
+
+void BasicBlock::SetDominatorInterval(DominatorTreeKind tree,
+                                      const BasicBlock* root, uint32_t pre,
+                                      uint32_t post) {
+  DominatorInterval& interval = dominator_intervals_[tree];
+  interval.root = root;
+  interval.pre = pre;
+  interval.post = post;
+}
+
+bool BasicBlock::HasDominatorIntervals(DominatorTreeKind tree,
+                                       const BasicBlock& other) const {
+  return dominator_intervals_[tree].root &&
+         other.dominator_intervals_[tree].root;
+}
+
+bool BasicBlock::DominatorIntervalEncloses(DominatorTreeKind tree,
+                                           const BasicBlock& other) const {
+  const DominatorInterval& outer = dominator_intervals_[tree];
+  const DominatorInterval& inner = other.dominator_intervals_[tree];
+  return outer.root == inner.root && outer.pre <= inner.pre &&
+         inner.post <= outer.post;
+}
+
 BasicBlock::DominatorIterator::DominatorIterator() : current_(nullptr) {}
 
 BasicBlock::DominatorIterator::DominatorIterator(
@@ -37,6 +37,14 @@ enum BlockType : uint32_t {
   kBlockTypeCOUNT  ///< Total number of block types. (must be the last element)
 };
 
+/// The dominator trees computed for the blocks of a function.
+enum DominatorTreeKind : uint32_t {
+  kDominatorTree,
+  kStructuralDominatorTree,
+  kStructuralPostDominatorTree,
+  kDominatorTreeCOUNT  ///< Total number of trees. (must be the last element)
+};
+
 class Instruction;
 
 // This class represents a basic block in a SPIR-V module
@@ -179,6 +187,18 @@ class BasicBlock {
   /// Assumes structural dominators have been computed.
   bool structurally_postdominates(const BasicBlock& other) const;
 
+  /// Returns the parent of the block in the given dominator tree
+  const BasicBlock* immediate_dominator(DominatorTreeKind tree) const;
+
+  /// Records the position of the block in a depth-first traversal of the
+  /// @p tree dominator tree rooted at @p root: the traversal enters the block
+  /// at step @p pre and leaves it at step @p post.  Once all the blocks of a
+  /// tree have their position, the dominance queries on that tree take
+  /// constant time instead of walking the tree.  See
+  /// Function::ComputeDominatorIntervals.
+  void SetDominatorInterval(DominatorTreeKind tree, const BasicBlock* root,
+                            uint32_t pre, uint32_t post);
+
   void RegisterStructuralSuccessor(BasicBlock* block) {
     block->structural_predecessors_.push_back(this);
     structural_successors_.push_back(block);
@@ -302,6 +322,27 @@ class BasicBlock {
 
   std::vector<BasicBlock*> structural_predecessors_;
   std::vector<BasicBlock*> structural_successors_;
+
+  /// The position of a block in a depth-first traversal of a dominator tree
+  struct DominatorInterval {
+    /// The root of the tree, or nullptr if the position is not known
+    const BasicBlock* root = nullptr;
+    uint32_t pre = 0;
+    uint32_t post = 0;
+  };
+
+  /// Returns true if the positions of this block and of @p other in @p tree
+  /// are known
+  bool HasDominatorIntervals(DominatorTreeKind tree,
+                             const BasicBlock& other) const;
+
+  /// Returns true if the position of this block in @p tree encloses the
+  /// position of @p other, that is if this block dominates @p other
+  bool DominatorIntervalEncloses(DominatorTreeKind tree,
+                                 const BasicBlock& other) const;
+
+  /// The position of the block in each of its dominator trees
+  DominatorInterval dominator_intervals_[kDominatorTreeCOUNT];
 };
 
 /// @brief Returns true if the iterators point to the same element or if both
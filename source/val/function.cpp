@@ -282,6 +282,49 @@ Function::AugmentedStructuralCFGPredecessorsFunction() const {
   };
 }
 
+void Function::ComputeDominatorIntervals(DominatorTreeKind tree) {
+  std::vector<BasicBlock*> all_blocks = {&pseudo_entry_block_,
+                                         &pseudo_exit_block_};
+  for (auto& entry : blocks_) all_blocks.push_back(&entry.second);
+
+  // Link the blocks to their children.  A root has no parent, or is its own
+  // parent.
+  std::unordered_map<const BasicBlock*, std::vector<BasicBlock*>> children;
+  std::vector<BasicBlock*> roots;
+  for (BasicBlock* block : all_blocks) {
+    const BasicBlock* parent = block->immediate_dominator(tree);
+    if (parent && parent != block) {
+      children[parent].push_back(block);
+    } else {
+      roots.push_back(block);
+    }
+  }
+
+  // Number the blocks in a depth-first traversal.  Deeply nested control flow
+  // gives deep trees, so the traversal keeps its own stack.
+  struct Visit {
+    BasicBlock* block;
+    uint32_t pre;
+    size_t next_child;
+  };
+  uint32_t step = 0;
+  std::vector<Visit> stack;
+  for (BasicBlock* root : roots) {
+    stack.push_back({root, ++step, 0});
+    while (!stack.empty()) {
+      Visit& visit = stack.back();
+      auto where = children.find(visit.block);
+      if (where != children.end() && visit.next_child < where->second.size()) {
+        BasicBlock* child = where->second[visit.next_child++];
+        stack.push_back({child, ++step, 0});
+      } else {
+        visit.block->SetDominatorInterval(tree, root, visit.pre, ++step);
+        stack.pop_back();
+      }
+    }
+  }
+}
+
 void Function::ComputeAugmentedCFG() {
   // Compute the successors of the pseudo-entry block, and
   // the predecessors of the pseudo exit block.
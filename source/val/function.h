@@ -191,6 +191,13 @@ class Function {
   /// Returns the block structural predecessors function for the augmented CFG.
   GetBlocksFunction AugmentedStructuralCFGPredecessorsFunction() const;
 
+  /// Numbers the blocks of the function, including the pseudo blocks, in a
+  /// depth-first traversal of the @p tree dominator tree, so that the
+  /// dominance queries of BasicBlock on that tree take constant time.  Call
+  /// once the immediate dominators of the tree are set, and again if they
+  /// change.
+  void ComputeDominatorIntervals(DominatorTreeKind tree);
+
   /// Returns the control flow nesting depth of the given basic block.
   /// This function only works when you have structured control flow.
   /// This function should only be called after the control flow constructs have
@@ -22,12 +22,16 @@
 namespace spvtools {
 namespace val {
 
-Instruction::Instruction(const spv_parsed_instruction_t* inst)
-    : words_(inst->words, inst->words + inst->num_words),
+Instruction::Instruction(const spv_parsed_instruction_t* inst,
+                         bool borrow_words)
+    : owned_words_(borrow_words ? std::vector<uint32_t>()
+                                : std::vector<uint32_t>(
+                                      inst->words,
+                                      inst->words + inst->num_words)),
       operands_(inst->operands, inst->operands + inst->num_operands),
-      inst_({words_.data(), inst->num_words, inst->opcode, inst->ext_inst_type,
-             inst->type_id, inst->result_id, operands_.data(),
-             inst->num_operands}) {}
+      inst_({borrow_words ? inst->words : owned_words_.data(),
+             inst->num_words, inst->opcode, inst->ext_inst_type, inst->type_id,
+             inst->result_id, operands_.data(), inst->num_operands}) {}
 
 void Instruction::RegisterUse(const Instruction* inst, uint32_t index) {
   uses_.push_back(std::make_pair(inst, index));
@@ -48,7 +52,7 @@ template <>
 std::string Instruction::GetOperandAs<std::string>(size_t index) const {
   const spv_parsed_operand_t& o = operands_.at(index);
   assert(o.offset + o.num_words <= inst_.num_words);
-  return spvtools::utils::MakeString(words_.data() + o.offset, o.num_words);
+  return spvtools::utils::MakeString(inst_.words + o.offset, o.num_words);
 }
 
 }  // namespace val
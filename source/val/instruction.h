@@ -23,6 +23,7 @@
 
 #include "source/ext_inst.h"
 #include "source/table.h"
+#include "source/util/span.h"
 #include "spirv-tools/libspirv.h"
 
 namespace spvtools {
@@ -35,7 +36,11 @@ class Function;
 /// instruction's result id
 class Instruction {
  public:
-  explicit Instruction(const spv_parsed_instruction_t* inst);
+  /// Creates an Instruction for \p inst.  If \p borrow_words is true, the
+  /// words of \p inst are referenced rather than copied, and must outlive the
+  /// Instruction.
+  explicit Instruction(const spv_parsed_instruction_t* inst,
+                       bool borrow_words = false);
 
   /// Registers the use of the Instruction in instruction \p inst at \p index
   void RegisterUse(const Instruction* inst, uint32_t index);
@@ -63,10 +68,15 @@ class Instruction {
   }
 
   /// The word used to define the Instruction
-  uint32_t word(size_t index) const { return words_[index]; }
+  uint32_t word(size_t index) const {
+    assert(index < inst_.num_words);
+    return inst_.words[index];
+  }
 
   /// The words used to define the Instruction
-  const std::vector<uint32_t>& words() const { return words_; }
+  utils::Span<const uint32_t> words() const {
+    return utils::Span<const uint32_t>(inst_.words, inst_.num_words);
+  }
 
   /// Returns the operand at |idx|.
   const spv_parsed_operand_t& operand(size_t idx) const {
@@ -103,14 +113,15 @@ class Instruction {
     const spv_parsed_operand_t& o = operands_.at(index);
     assert(o.num_words * 4 >= sizeof(T));
     assert(o.offset + o.num_words <= inst_.num_words);
-    return *reinterpret_cast<const T*>(&words_[o.offset]);
+    return *reinterpret_cast<const T*>(&inst_.words[o.offset]);
   }
 
   size_t LineNum() const { return line_num_; }
   void SetLineNum(size_t pos) { line_num_ = pos; }
 
  private:
-  const std::vector<uint32_t> words_;
+  /// Holds a copy of the words when they are not borrowed.
+  const std::vector<uint32_t> owned_words_;
   const std::vector<spv_parsed_operand_t> operands_;
   spv_parsed_instruction_t inst_;
   size_t line_num_ = 0;
@@ -22,6 +22,8 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "source/binary.h"
@@ -35,6 +37,7 @@
 #include "source/spirv_endian.h"
 #include "source/spirv_target_env.h"
 #include "source/spirv_validator_options.h"
+#include "source/util/make_unique.h"
 #include "source/val/construct.h"
 #include "source/val/function.h"
 #include "source/val/instruction.h"
@@ -152,9 +155,213 @@ spv_result_t ValidateEntryPoints(ValidationState_t& _) {
   return SPV_SUCCESS;
 }
 
+bool ChecksEveryOpcode(SpvOp) { return true; }
+
+}  // namespace
+
+const std::vector<InstructionCheck>& OpcodeChecks() {
+  // Keep these passes in the order they appear in the SPIR-V specification
+  // sections to maintain test consistency.
+  static const std::vector<InstructionCheck> checks = {
+      {MiscPass, MiscPassChecksOpcode},
+      {DebugPass, DebugPassChecksOpcode},
+      {AnnotationPass, AnnotationPassChecksOpcode},
+      {ExtensionPass, ExtensionPassChecksOpcode},
+      {ModeSettingPass, ModeSettingPassChecksOpcode},
+      {TypePass, TypePassChecksOpcode},
+      {ConstantPass, ConstantPassChecksOpcode},
+      {MemoryPass, MemoryPassChecksOpcode},
+      {FunctionPass, FunctionPassChecksOpcode},
+      {ImagePass, ImagePassChecksOpcode},
+      {ConversionPass, ConversionPassChecksOpcode},
+      {CompositesPass, CompositesPassChecksOpcode},
+      {ArithmeticsPass, ArithmeticsPassChecksOpcode},
+      {BitwisePass, BitwisePassChecksOpcode},
+      {LogicalsPass, LogicalsPassChecksOpcode},
+      {ControlFlowPass, ControlFlowPassChecksOpcode},
+      {DerivativesPass, DerivativesPassChecksOpcode},
+      {AtomicsPass, AtomicsPassChecksOpcode},
+      {PrimitivesPass, PrimitivesPassChecksOpcode},
+      {BarriersPass, BarriersPassChecksOpcode},
+      // Group
+      // Device-Side Enqueue
+      // Pipe
+      {NonUniformPass, NonUniformPassChecksOpcode},
+
+      {LiteralsPass, ChecksEveryOpcode},
+      {RayQueryPass, RayQueryPassChecksOpcode},
+      {RayTracingPass, RayTracingPassChecksOpcode},
+  };
+  return checks;
+}
+
+namespace {
+
+// The checks that run once the whole module has been checked, because the
+// other checks register the limitations they check.
+const InstructionCheck kLimitationChecks[] = {
+    {ValidateExecutionLimitations,
+     [](SpvOp opcode) { return opcode == SpvOpFunction; }},
+    {ValidateSmallTypeUses, ChecksEveryOpcode},
+};
+
+// Dispatches instructions to the checks of their opcode.  The checks of each
+// opcode of the grammar are listed once, when the table is built, so an
+// instruction only goes through the checks that apply to it.
+class InstructionCheckTable {
+ public:
+  using Check = spv_result_t (*)(ValidationState_t& _, const Instruction* inst);
+
+  template <typename Checks>
+  explicit InstructionCheckTable(const Checks& checks) {
+    spv_opcode_table opcodes = nullptr;
+    spvOpcodeTableGet(&opcodes, SPV_ENV_UNIVERSAL_1_0);
+    uint32_t max_opcode = 0;
+    for (uint32_t i = 0; i < opcodes->count; ++i) {
+      max_opcode = std::max(max_opcode,
+                            static_cast<uint32_t>(opcodes->entries[i].opcode));
+    }
+
+    offsets_.reserve(max_opcode + 2);
+    for (uint32_t opcode = 0; opcode <= max_opcode; ++opcode) {
+      offsets_.push_back(static_cast<uint32_t>(checks_.size()));
+      for (const InstructionCheck& check : checks) {
+        if (check.checks_opcode(static_cast<SpvOp>(opcode))) {
+          checks_.push_back(check.check);
+        }
+      }
+    }
+    offsets_.push_back(static_cast<uint32_t>(checks_.size()));
+    for (const InstructionCheck& check : checks) {
+      all_checks_.push_back(check.check);
+    }
+  }
+
+  // Runs the checks of the opcode of |inst|, and returns the first error.
+  spv_result_t Run(ValidationState_t& _, const Instruction* inst) const {
+    const uint32_t opcode = inst->opcode();
+    const Check* begin = all_checks_.data();
+    const Check* end = begin + all_checks_.size();
+    if (opcode < offsets_.size() - 1) {
+      begin = checks_.data() + offsets_[opcode];
+      end = checks_.data() + offsets_[opcode + 1];
+    }
+    for (const Check* check = begin; check != end; ++check) {
+      if (auto error = (*check)(_, inst)) return error;
+    }
+    return SPV_SUCCESS;
+  }
+
+ private:
+  // The checks of |opcode| are checks_[offsets_[opcode]] up to
+  // checks_[offsets_[opcode + 1]].
+  std::vector<uint32_t> offsets_;
+  std::vector<Check> checks_;
+  // All the checks, for opcodes outside of the grammar.
+  std::vector<Check> all_checks_;
+};
+
+// Returns the index of the first instruction of the first function in
+// |instructions|, or the number of instructions if there is no function.
+size_t FirstFunctionInstruction(const std::vector<Instruction>& instructions) {
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    if (instructions[i].opcode() == SpvOpFunction) return i;
+  }
+  return instructions.size();
+}
+
+// Returns the ranges of the instructions of the functions in |instructions|,
+// which start at index |first|. Each range runs from an OpFunction to the
+// OpFunctionEnd after it.
+std::vector<std::pair<size_t, size_t>> FunctionRanges(
+    const std::vector<Instruction>& instructions, size_t first) {
+  std::vector<std::pair<size_t, size_t>> ranges;
+  size_t begin = first;
+  for (size_t i = first; i < instructions.size(); ++i) {
+    if (instructions[i].opcode() == SpvOpFunctionEnd) {
+      ranges.emplace_back(begin, i + 1);
+      begin = i + 1;
+    }
+  }
+  return ranges;
+}
+
+// Returns true if |lhs| and |rhs| have the same words.
+bool SameWords(const Instruction& lhs, const Instruction& rhs) {
+  const auto lhs_words = lhs.words();
+  const auto rhs_words = rhs.words();
+  return lhs_words.size() == rhs_words.size() &&
+         std::equal(lhs_words.begin(), lhs_words.end(), rhs_words.begin());
+}
+
+// Returns true if the instructions in [first, last), those of |func|, use no
+// id defined in another function, and the ids they define are not used in
+// another function.
+bool SharesNoIds(const Function* func, const Instruction* first,
+                 const Instruction* last, const ValidationState_t& _) {
+  for (const Instruction* inst = first; inst != last; ++inst) {
+    if (inst->function() == func) {
+      for (const auto& use : inst->uses()) {
+        const Function* user = use.first->function();
+        if (user && user != func) return false;
+      }
+    }
+    for (const auto& operand : inst->operands()) {
+      if (!spvIsIdType(operand.type) ||
+          operand.type == SPV_OPERAND_TYPE_RESULT_ID) {
+        continue;
+      }
+      const Instruction* def = _.FindDef(inst->word(operand.offset));
+      if (def && def->function() && def->function() != func) return false;
+    }
+  }
+  return true;
+}
+
+// Marks the functions of |_| that are the same as in |previous|, the state of
+// a module that passed validation with the same options. The control flow and
+// dominance checks of a function only depend on its instructions and on the
+// instructions outside of functions, so the functions skip them when those
+// instructions are the same as before and the function shares no ids with
+// other functions.
+void MarkUnchangedFunctions(const ValidationState_t& previous,
+                            ValidationState_t& _) {
+  if (previous.version() != _.version()) return;
+  const auto& old_instructions = previous.ordered_instructions();
+  const auto& instructions = _.ordered_instructions();
+  const size_t num_globals = FirstFunctionInstruction(instructions);
+  if (FirstFunctionInstruction(old_instructions) != num_globals) return;
+  for (size_t i = 0; i < num_globals; ++i) {
+    if (!SameWords(old_instructions[i], instructions[i])) return;
+  }
+
+  std::unordered_map<uint32_t, std::pair<size_t, size_t>> old_functions;
+  for (const auto& range : FunctionRanges(old_instructions, num_globals)) {
+    old_functions[old_instructions[range.first].id()] = range;
+  }
+  for (const auto& range : FunctionRanges(instructions, num_globals)) {
+    const uint32_t id = instructions[range.first].id();
+    const auto old_function = old_functions.find(id);
+    if (old_function == old_functions.end()) continue;
+    const size_t old_first = old_function->second.first;
+    if (old_function->second.second - old_first != range.second - range.first)
+      continue;
+    bool same = true;
+    for (size_t i = 0; same && i < range.second - range.first; ++i) {
+      same = SameWords(old_instructions[old_first + i],
+                       instructions[range.first + i]);
+    }
+    if (same && SharesNoIds(_.function(id), instructions.data() + range.first,
+                            instructions.data() + range.second, _)) {
+      _.RegisterUnchangedFunction(id);
+    }
+  }
+}
+
 spv_result_t ValidateBinaryUsingContextAndValidationState(
     const spv_context_t& context, const uint32_t* words, const size_t num_words,
-    spv_diagnostic* pDiagnostic, ValidationState_t* vstate) {
+    spv_diagnostic* pDiagnostic, ValidationState_t* vstate,
+    const ValidationState_t* previous = nullptr) {
   auto binary = std::unique_ptr<spv_const_binary_t>(
       new spv_const_binary_t{words, num_words});
 
@@ -319,39 +526,10 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   }
 
   // Validate individual opcodes.
+  static const InstructionCheckTable opcode_checks(OpcodeChecks());
   for (size_t i = 0; i < vstate->ordered_instructions().size(); ++i) {
     auto& instruction = vstate->ordered_instructions()[i];
-
-    // Keep these passes in the order they appear in the SPIR-V specification
-    // sections to maintain test consistency.
-    if (auto error = MiscPass(*vstate, &instruction)) return error;
-    if (auto error = DebugPass(*vstate, &instruction)) return error;
-    if (auto error = AnnotationPass(*vstate, &instruction)) return error;
-    if (auto error = ExtensionPass(*vstate, &instruction)) return error;
-    if (auto error = ModeSettingPass(*vstate, &instruction)) return error;
-    if (auto error = TypePass(*vstate, &instruction)) return error;
-    if (auto error = ConstantPass(*vstate, &instruction)) return error;
-    if (auto error = MemoryPass(*vstate, &instruction)) return error;
-    if (auto error = FunctionPass(*vstate, &instruction)) return error;
-    if (auto error = ImagePass(*vstate, &instruction)) return error;
-    if (auto error = ConversionPass(*vstate, &instruction)) return error;
-    if (auto error = CompositesPass(*vstate, &instruction)) return error;
-    if (auto error = ArithmeticsPass(*vstate, &instruction)) return error;
-    if (auto error = BitwisePass(*vstate, &instruction)) return error;
-    if (auto error = LogicalsPass(*vstate, &instruction)) return error;
-    if (auto error = ControlFlowPass(*vstate, &instruction)) return error;
-    if (auto error = DerivativesPass(*vstate, &instruction)) return error;
-    if (auto error = AtomicsPass(*vstate, &instruction)) return error;
-    if (auto error = PrimitivesPass(*vstate, &instruction)) return error;
-    if (auto error = BarriersPass(*vstate, &instruction)) return error;
-    // Group
-    // Device-Side Enqueue
-    // Pipe
-    if (auto error = NonUniformPass(*vstate, &instruction)) return error;
-
-    if (auto error = LiteralsPass(*vstate, &instruction)) return error;
-    if (auto error = RayQueryPass(*vstate, &instruction)) return error;
-    if (auto error = RayTracingPass(*vstate, &instruction)) return error;
+    if (auto error = opcode_checks.Run(*vstate, &instruction)) return error;
   }
 
   // Validate the preconditions involving adjacent instructions. e.g. SpvOpPhi
@@ -359,6 +537,7 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   if (auto error = ValidateAdjacency(*vstate)) return error;
 
   if (auto error = ValidateEntryPoints(*vstate)) return error;
+  if (previous) MarkUnchangedFunctions(*previous, *vstate);
   // CFG checks are performed after the binary has been parsed
   // and the CFGPass has collected information about the control flow
   if (auto error = PerformCfgChecks(*vstate)) return error;
@@ -370,9 +549,9 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
   if (auto error = ValidateBuiltIns(*vstate)) return error;
   // These checks must be performed after individual opcode checks because
   // those checks register the limitation checked here.
+  static const InstructionCheckTable limitation_checks(kLimitationChecks);
   for (const auto& inst : vstate->ordered_instructions()) {
-    if (auto error = ValidateExecutionLimitations(*vstate, &inst)) return error;
-    if (auto error = ValidateSmallTypeUses(*vstate, &inst)) return error;
+    if (auto error = limitation_checks.Run(*vstate, &inst)) return error;
   }
 
   return SPV_SUCCESS;
@@ -397,6 +576,43 @@ spv_result_t ValidateBinaryAndKeepValidationState(
       hijack_context, words, num_words, pDiagnostic, vstate->get());
 }
 
+IncrementalValidator::IncrementalValidator(spv_target_env env,
+                                           spv_const_validator_options options)
+    : context_(spvContextCreate(env)), options_(options) {}
+
+IncrementalValidator::~IncrementalValidator() { spvContextDestroy(context_); }
+
+spv_result_t IncrementalValidator::Validate(const uint32_t* words,
+                                            size_t num_words,
+                                            spv_diagnostic* pDiagnostic) {
+  spv_context_t hijack_context = *context_;
+  if (pDiagnostic) {
+    *pDiagnostic = nullptr;
+    UseDiagnosticAsMessageConsumer(&hijack_context, pDiagnostic);
+  }
+
+  const std::string config =
+      spvValidatorConfig(context_->target_env, *options_);
+  const ValidationState_t* previous =
+      state_ && config == config_ ? state_.get() : nullptr;
+
+  // The state refers to the words, so they are kept with it.
+  std::vector<uint32_t> module_words(words, words + num_words);
+  auto vstate = MakeUnique<ValidationState_t>(
+      &hijack_context, options_, module_words.data(), module_words.size(),
+      kDefaultMaxNumOfWarnings);
+  const spv_result_t result = ValidateBinaryUsingContextAndValidationState(
+      hijack_context, module_words.data(), module_words.size(), pDiagnostic,
+      vstate.get(), previous);
+  num_unchanged_functions_ = vstate->num_unchanged_functions();
+  if (result == SPV_SUCCESS) {
+    state_ = std::move(vstate);
+    words_ = std::move(module_words);
+    config_ = config;
+  }
+  return result;
+}
+
 }  // namespace val
 }  // namespace spvtools
 
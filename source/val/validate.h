@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -93,6 +94,9 @@ spv_result_t ValidateInterfaces(ValidationState_t& _);
 /// @return SPV_SUCCESS if no errors are found.
 spv_result_t MemoryPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if MemoryPass checks instructions with the given opcode.
+bool MemoryPassChecksOpcode(SpvOp opcode);
+
 /// @brief Updates the immediate dominator for each of the block edges
 ///
 /// Updates the immediate dominator of the blocks for each of the edges
@@ -120,6 +124,9 @@ spv_result_t CfgPass(ValidationState_t& _, const Instruction* inst);
 /// Validates Control Flow Graph instructions.
 spv_result_t ControlFlowPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if ControlFlowPass checks instructions with the given opcode.
+bool ControlFlowPassChecksOpcode(SpvOp opcode);
+
 /// Performs Id and SSA validation of a module
 spv_result_t IdPass(ValidationState_t& _, Instruction* inst);
 
@@ -136,51 +143,96 @@ spv_result_t ValidateBuiltIns(ValidationState_t& _);
 /// Validates type instructions.
 spv_result_t TypePass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if TypePass checks instructions with the given opcode.
+bool TypePassChecksOpcode(SpvOp opcode);
+
 /// Validates constant instructions.
 spv_result_t ConstantPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if ConstantPass checks instructions with the given opcode.
+bool ConstantPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of arithmetic instructions.
 spv_result_t ArithmeticsPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if ArithmeticsPass checks instructions with the given opcode.
+bool ArithmeticsPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of composite instructions.
 spv_result_t CompositesPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if CompositesPass checks instructions with the given opcode.
+bool CompositesPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of conversion instructions.
 spv_result_t ConversionPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if ConversionPass checks instructions with the given opcode.
+bool ConversionPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of derivative instructions.
 spv_result_t DerivativesPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if DerivativesPass checks instructions with the given opcode.
+bool DerivativesPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of logical instructions.
 spv_result_t LogicalsPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if LogicalsPass checks instructions with the given opcode.
+bool LogicalsPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of bitwise instructions.
 spv_result_t BitwisePass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if BitwisePass checks instructions with the given opcode.
+bool BitwisePassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of image instructions.
 spv_result_t ImagePass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if ImagePass checks instructions with the given opcode.
+bool ImagePassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of atomic instructions.
 spv_result_t AtomicsPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if AtomicsPass checks instructions with the given opcode.
+bool AtomicsPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of barrier instructions.
 spv_result_t BarriersPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if BarriersPass checks instructions with the given opcode.
+bool BarriersPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of literal numbers.
 spv_result_t LiteralsPass(ValidationState_t& _, const Instruction* inst);
 
 /// Validates correctness of extension instructions.
 spv_result_t ExtensionPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if ExtensionPass checks instructions with the given opcode.
+bool ExtensionPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of annotation instructions.
 spv_result_t AnnotationPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if AnnotationPass checks instructions with the given opcode.
+bool AnnotationPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of non-uniform group instructions.
 spv_result_t NonUniformPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if NonUniformPass checks instructions with the given opcode.
+bool NonUniformPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of debug instructions.
 spv_result_t DebugPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if DebugPass checks instructions with the given opcode.
+bool DebugPassChecksOpcode(SpvOp opcode);
+
 // Validates that capability declarations use operands allowed in the current
 // context.
 spv_result_t CapabilityPass(ValidationState_t& _, const Instruction* inst);
@@ -188,21 +240,50 @@ spv_result_t CapabilityPass(ValidationState_t& _, const Instruction* inst);
 /// Validates correctness of primitive instructions.
 spv_result_t PrimitivesPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if PrimitivesPass checks instructions with the given opcode.
+bool PrimitivesPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of mode setting instructions.
 spv_result_t ModeSettingPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if ModeSettingPass checks instructions with the given opcode.
+bool ModeSettingPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of function instructions.
 spv_result_t FunctionPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if FunctionPass checks instructions with the given opcode.
+bool FunctionPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of miscellaneous instructions.
 spv_result_t MiscPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if MiscPass checks instructions with the given opcode.
+bool MiscPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of ray query instructions.
 spv_result_t RayQueryPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if RayQueryPass checks instructions with the given opcode.
+bool RayQueryPassChecksOpcode(SpvOp opcode);
+
 /// Validates correctness of ray tracing instructions.
 spv_result_t RayTracingPass(ValidationState_t& _, const Instruction* inst);
 
+/// Returns true if RayTracingPass checks instructions with the given opcode.
+bool RayTracingPassChecksOpcode(SpvOp opcode);
+
+/// A check of individual instructions, and a predicate on the opcodes of the
+/// instructions it checks.  The check does nothing for other instructions.
+struct InstructionCheck {
+  spv_result_t (*check)(ValidationState_t& _, const Instruction* inst);
+  bool (*checks_opcode)(SpvOp opcode);
+};
+
+/// Returns the checks of individual instructions, in the order they run on
+/// each instruction.
+const std::vector<InstructionCheck>& OpcodeChecks();
+
 /// Calculates the reachability of basic blocks.
 void ReachabilityPass(ValidationState_t& _);
 
@@ -236,12 +317,51 @@ spv_result_t spvValidateIDs(const spv_instruction_t* pInstructions,
 // Performs validation for the SPIRV-V module binary.
 // The main difference between this API and spvValidateBinary is that the
 // "Validation State" is not destroyed upon function return; it lives on and is
-// pointed to by the vstate unique_ptr.
+// pointed to by the vstate unique_ptr.  The state refers to |words| rather
+// than copying them, so they must outlive *|vstate|.
 spv_result_t ValidateBinaryAndKeepValidationState(
     const spv_const_context context, spv_const_validator_options options,
     const uint32_t* words, const size_t num_words, spv_diagnostic* pDiagnostic,
     std::unique_ptr<ValidationState_t>* vstate);
 
+// Validates a sequence of modules, each an edit of the ones before it, such
+// as the candidates of a reducer or the states of a shader in an editor. The
+// validation state of the last module found valid is kept. The functions of a
+// new module that are the same as in that module, and that share no ids with
+// other functions, skip the control flow and dominance checks they passed
+// already. Any other change, including one outside of functions, is validated
+// in full. The results are the same as those of spvValidateWithOptions.
+class IncrementalValidator {
+ public:
+  // |options| must outlive the validator. They may change between modules, in
+  // which case the next module is validated in full.
+  IncrementalValidator(spv_target_env env,
+                       spv_const_validator_options options);
+  ~IncrementalValidator();
+
+  // Validates the module |words|, and keeps its state if it is valid.
+  spv_result_t Validate(const uint32_t* words, size_t num_words,
+                        spv_diagnostic* pDiagnostic);
+
+  // Returns the number of functions of the module last validated that were
+  // found unchanged.
+  size_t num_unchanged_functions() const { return num_unchanged_functions_; }
+
+ private:
+  IncrementalValidator(const IncrementalValidator&) = delete;
+  IncrementalValidator& operator=(const IncrementalValidator&) = delete;
+
+  spv_context context_;
+  spv_const_validator_options options_;
+  // The words of the last module found valid, which |state_| refers to, and
+  // the configuration of the options it was validated with. Only the
+  // instructions of |state_| are read.
+  std::vector<uint32_t> words_;
+  std::string config_;
+  std::unique_ptr<ValidationState_t> state_;
+  size_t num_unchanged_functions_ = 0;
+};
+
 }  // namespace val
 }  // namespace spvtools
 
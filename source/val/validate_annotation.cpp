@@ -487,6 +487,7 @@ spv_result_t RegisterDecorations(ValidationState_t& _,
 }  // namespace
 
 spv_result_t AnnotationPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with AnnotationPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpDecorate:
       if (auto error = ValidateDecorate(_, inst)) return error;
@@ -519,5 +520,19 @@ spv_result_t AnnotationPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool AnnotationPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpDecorate:
+    case SpvOpDecorateId:
+    case SpvOpMemberDecorate:
+    case SpvOpDecorationGroup:
+    case SpvOpGroupDecorate:
+    case SpvOpGroupMemberDecorate:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
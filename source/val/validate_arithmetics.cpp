@@ -28,6 +28,7 @@ namespace val {
 
 // Validates correctness of arithmetic instructions.
 spv_result_t ArithmeticsPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with ArithmeticsPassChecksOpcode.
   const SpvOp opcode = inst->opcode();
   const uint32_t result_type = inst->type_id();
 
@@ -546,5 +547,41 @@ spv_result_t ArithmeticsPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool ArithmeticsPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpFAdd:
+    case SpvOpFSub:
+    case SpvOpFMul:
+    case SpvOpFDiv:
+    case SpvOpFRem:
+    case SpvOpFMod:
+    case SpvOpFNegate:
+    case SpvOpUDiv:
+    case SpvOpUMod:
+    case SpvOpISub:
+    case SpvOpIAdd:
+    case SpvOpIMul:
+    case SpvOpSDiv:
+    case SpvOpSMod:
+    case SpvOpSRem:
+    case SpvOpSNegate:
+    case SpvOpDot:
+    case SpvOpVectorTimesScalar:
+    case SpvOpMatrixTimesScalar:
+    case SpvOpVectorTimesMatrix:
+    case SpvOpMatrixTimesVector:
+    case SpvOpMatrixTimesMatrix:
+    case SpvOpOuterProduct:
+    case SpvOpIAddCarry:
+    case SpvOpISubBorrow:
+    case SpvOpUMulExtended:
+    case SpvOpSMulExtended:
+    case SpvOpCooperativeMatrixMulAddNV:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
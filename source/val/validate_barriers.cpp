@@ -32,6 +32,7 @@ namespace val {
 
 // Validates correctness of barrier instructions.
 spv_result_t BarriersPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with BarriersPassChecksOpcode.
   const SpvOp opcode = inst->opcode();
   const uint32_t result_type = inst->type_id();
 
@@ -132,5 +133,17 @@ spv_result_t BarriersPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool BarriersPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpControlBarrier:
+    case SpvOpMemoryBarrier:
+    case SpvOpNamedBarrierInitialize:
+    case SpvOpMemoryNamedBarrier:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
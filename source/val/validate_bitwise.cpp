@@ -58,6 +58,7 @@ spv_result_t ValidateBaseType(ValidationState_t& _, const Instruction* inst,
 
 // Validates correctness of bitwise instructions.
 spv_result_t BitwisePass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with BitwisePassChecksOpcode.
   const SpvOp opcode = inst->opcode();
   const uint32_t result_type = inst->type_id();
 
@@ -228,5 +229,25 @@ spv_result_t BitwisePass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool BitwisePassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpShiftRightLogical:
+    case SpvOpShiftRightArithmetic:
+    case SpvOpShiftLeftLogical:
+    case SpvOpBitwiseOr:
+    case SpvOpBitwiseXor:
+    case SpvOpBitwiseAnd:
+    case SpvOpNot:
+    case SpvOpBitFieldInsert:
+    case SpvOpBitFieldSExtract:
+    case SpvOpBitFieldUExtract:
+    case SpvOpBitReverse:
+    case SpvOpBitCount:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -870,134 +870,146 @@ spv_result_t StructuredControlFlowChecks(
   return SPV_SUCCESS;
 }
 
-spv_result_t PerformCfgChecks(ValidationState_t& _) {
-  for (auto& function : _.functions()) {
-    // Check all referenced blocks are defined within a function
-    if (function.undefined_block_count() != 0) {
-      std::string undef_blocks("{");
-      bool first = true;
-      for (auto undefined_block : function.undefined_blocks()) {
-        undef_blocks += _.getIdName(undefined_block);
-        if (!first) {
-          undef_blocks += " ";
+// Performs the CFG checks of PerformCfgChecks on a single function. Only
+// |function| and its blocks are modified, so functions can be checked
+// concurrently.
+spv_result_t PerformFunctionCfgChecks(ValidationState_t& _,
+                                      Function& function) {
+  // Check all referenced blocks are defined within a function
+  if (function.undefined_block_count() != 0) {
+    std::string undef_blocks("{");
+    bool first = true;
+    for (auto undefined_block : function.undefined_blocks()) {
+      undef_blocks += _.getIdName(undefined_block);
+      if (!first) {
+        undef_blocks += " ";
+      }
+      first = false;
+    }
+    return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(function.id()))
+           << "Block(s) " << undef_blocks << "}"
+           << " are referenced but not defined in function "
+           << _.getIdName(function.id());
+  }
+
+  // Set each block's immediate dominator.
+  //
+  // We want to analyze all the blocks in the function, even in degenerate
+  // control flow cases including unreachable blocks.  So use the augmented
+  // CFG to ensure we cover all the blocks.
+  std::vector<const BasicBlock*> postorder;
+  auto ignore_block = [](const BasicBlock*) {};
+  auto ignore_edge = [](const BasicBlock*, const BasicBlock*) {};
+  auto no_terminal_blocks = [](const BasicBlock*) { return false; };
+  if (!function.ordered_blocks().empty()) {
+    /// calculate dominators
+    CFA<BasicBlock>::DepthFirstTraversal(
+        function.first_block(), function.AugmentedCFGSuccessorsFunction(),
+        ignore_block, [&](const BasicBlock* b) { postorder.push_back(b); },
+        ignore_edge, no_terminal_blocks);
+    auto edges = CFA<BasicBlock>::CalculateDominators(
+        postorder, function.AugmentedCFGPredecessorsFunction());
+    for (auto edge : edges) {
+      if (edge.first != edge.second)
+        edge.first->SetImmediateDominator(edge.second);
+    }
+    function.ComputeDominatorIntervals(kDominatorTree);
+  }
+
+  auto& blocks = function.ordered_blocks();
+  if (!blocks.empty()) {
+    // Check if the order of blocks in the binary appear before the blocks
+    // they dominate
+    for (auto block = begin(blocks) + 1; block != end(blocks); ++block) {
+      if (auto idom = (*block)->immediate_dominator()) {
+        if (idom != function.pseudo_entry_block() &&
+            block == std::find(begin(blocks), block, idom)) {
+          return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(idom->id()))
+                 << "Block " << _.getIdName((*block)->id())
+                 << " appears in the binary before its dominator "
+                 << _.getIdName(idom->id());
+        }
+      }
+    }
+    // If we have structured control flow, check that no block has a control
+    // flow nesting depth larger than the limit.
+    if (_.HasCapability(SpvCapabilityShader)) {
+      const int control_flow_nesting_depth_limit =
+          _.options()->universal_limits_.max_control_flow_nesting_depth;
+      for (auto block = begin(blocks); block != end(blocks); ++block) {
+        if (function.GetBlockDepth(*block) > control_flow_nesting_depth_limit) {
+          return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef((*block)->id()))
+                 << "Maximum Control Flow nesting depth exceeded.";
         }
-        first = false;
       }
-      return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(function.id()))
-             << "Block(s) " << undef_blocks << "}"
-             << " are referenced but not defined in function "
-             << _.getIdName(function.id());
     }
+  }
 
-    // Set each block's immediate dominator.
-    //
-    // We want to analyze all the blocks in the function, even in degenerate
-    // control flow cases including unreachable blocks.  So use the augmented
-    // CFG to ensure we cover all the blocks.
-    std::vector<const BasicBlock*> postorder;
-    auto ignore_block = [](const BasicBlock*) {};
-    auto ignore_edge = [](const BasicBlock*, const BasicBlock*) {};
-    auto no_terminal_blocks = [](const BasicBlock*) { return false; };
+  /// Structured control flow checks are only required for shader capabilities
+  if (_.HasCapability(SpvCapabilityShader)) {
+    // Calculate structural dominance.
+    postorder.clear();
+    std::vector<const BasicBlock*> postdom_postorder;
+    std::vector<std::pair<uint32_t, uint32_t>> back_edges;
     if (!function.ordered_blocks().empty()) {
       /// calculate dominators
       CFA<BasicBlock>::DepthFirstTraversal(
-          function.first_block(), function.AugmentedCFGSuccessorsFunction(),
-          ignore_block, [&](const BasicBlock* b) { postorder.push_back(b); },
-          ignore_edge, no_terminal_blocks);
+          function.first_block(),
+          function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
+          [&](const BasicBlock* b) { postorder.push_back(b); }, ignore_edge,
+          no_terminal_blocks);
       auto edges = CFA<BasicBlock>::CalculateDominators(
-          postorder, function.AugmentedCFGPredecessorsFunction());
+          postorder, function.AugmentedStructuralCFGPredecessorsFunction());
       for (auto edge : edges) {
         if (edge.first != edge.second)
-          edge.first->SetImmediateDominator(edge.second);
+          edge.first->SetImmediateStructuralDominator(edge.second);
       }
-    }
+      function.ComputeDominatorIntervals(kStructuralDominatorTree);
 
-    auto& blocks = function.ordered_blocks();
-    if (!blocks.empty()) {
-      // Check if the order of blocks in the binary appear before the blocks
-      // they dominate
-      for (auto block = begin(blocks) + 1; block != end(blocks); ++block) {
-        if (auto idom = (*block)->immediate_dominator()) {
-          if (idom != function.pseudo_entry_block() &&
-              block == std::find(begin(blocks), block, idom)) {
-            return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef(idom->id()))
-                   << "Block " << _.getIdName((*block)->id())
-                   << " appears in the binary before its dominator "
-                   << _.getIdName(idom->id());
-          }
-        }
-      }
-      // If we have structured control flow, check that no block has a control
-      // flow nesting depth larger than the limit.
-      if (_.HasCapability(SpvCapabilityShader)) {
-        const int control_flow_nesting_depth_limit =
-            _.options()->universal_limits_.max_control_flow_nesting_depth;
-        for (auto block = begin(blocks); block != end(blocks); ++block) {
-          if (function.GetBlockDepth(*block) >
-              control_flow_nesting_depth_limit) {
-            return _.diag(SPV_ERROR_INVALID_CFG, _.FindDef((*block)->id()))
-                   << "Maximum Control Flow nesting depth exceeded.";
-          }
-        }
+      /// calculate post dominators
+      CFA<BasicBlock>::DepthFirstTraversal(
+          function.pseudo_exit_block(),
+          function.AugmentedStructuralCFGPredecessorsFunction(), ignore_block,
+          [&](const BasicBlock* b) { postdom_postorder.push_back(b); },
+          ignore_edge, no_terminal_blocks);
+      auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
+          postdom_postorder,
+          function.AugmentedStructuralCFGSuccessorsFunction());
+      for (auto edge : postdom_edges) {
+        edge.first->SetImmediateStructuralPostDominator(edge.second);
       }
+      function.ComputeDominatorIntervals(kStructuralPostDominatorTree);
+      /// calculate back edges.
+      CFA<BasicBlock>::DepthFirstTraversal(
+          function.pseudo_entry_block(),
+          function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
+          ignore_block,
+          [&](const BasicBlock* from, const BasicBlock* to) {
+            // A back edge must be a real edge. Since the augmented successors
+            // contain structural edges, filter those from consideration.
+            for (const auto* succ : *(from->successors())) {
+              if (succ == to) back_edges.emplace_back(from->id(), to->id());
+            }
+          },
+          no_terminal_blocks);
     }
+    UpdateContinueConstructExitBlocks(function, back_edges);
 
-    /// Structured control flow checks are only required for shader capabilities
-    if (_.HasCapability(SpvCapabilityShader)) {
-      // Calculate structural dominance.
-      postorder.clear();
-      std::vector<const BasicBlock*> postdom_postorder;
-      std::vector<std::pair<uint32_t, uint32_t>> back_edges;
-      if (!function.ordered_blocks().empty()) {
-        /// calculate dominators
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.first_block(),
-            function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
-            [&](const BasicBlock* b) { postorder.push_back(b); }, ignore_edge,
-            no_terminal_blocks);
-        auto edges = CFA<BasicBlock>::CalculateDominators(
-            postorder, function.AugmentedStructuralCFGPredecessorsFunction());
-        for (auto edge : edges) {
-          if (edge.first != edge.second)
-            edge.first->SetImmediateStructuralDominator(edge.second);
-        }
-
-        /// calculate post dominators
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.pseudo_exit_block(),
-            function.AugmentedStructuralCFGPredecessorsFunction(), ignore_block,
-            [&](const BasicBlock* b) { postdom_postorder.push_back(b); },
-            ignore_edge, no_terminal_blocks);
-        auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
-            postdom_postorder,
-            function.AugmentedStructuralCFGSuccessorsFunction());
-        for (auto edge : postdom_edges) {
-          edge.first->SetImmediateStructuralPostDominator(edge.second);
-        }
-        /// calculate back edges.
-        CFA<BasicBlock>::DepthFirstTraversal(
-            function.pseudo_entry_block(),
-            function.AugmentedStructuralCFGSuccessorsFunction(), ignore_block,
-            ignore_block,
-            [&](const BasicBlock* from, const BasicBlock* to) {
-              // A back edge must be a real edge. Since the augmented successors
-              // contain structural edges, filter those from consideration.
-              for (const auto* succ : *(from->successors())) {
-                if (succ == to) back_edges.emplace_back(from->id(), to->id());
-              }
-            },
-            no_terminal_blocks);
-      }
-      UpdateContinueConstructExitBlocks(function, back_edges);
-
-      if (auto error =
-              StructuredControlFlowChecks(_, &function, back_edges, postorder))
-        return error;
-    }
+    if (auto error =
+            StructuredControlFlowChecks(_, &function, back_edges, postorder))
+      return error;
   }
   return SPV_SUCCESS;
 }
 
+spv_result_t PerformCfgChecks(ValidationState_t& _) {
+  auto& functions = _.functions();
+  return _.RunIndependentChecks(functions.size(), [&_, &functions](size_t i) {
+    if (_.IsUnchangedFunction(functions[i].id())) return SPV_SUCCESS;
+    return PerformFunctionCfgChecks(_, functions[i]);
+  });
+}
+
 spv_result_t CfgPass(ValidationState_t& _, const Instruction* inst) {
   SpvOp opcode = inst->opcode();
   switch (opcode) {
@@ -1138,6 +1150,7 @@ void ReachabilityPass(ValidationState_t& _) {
 }
 
 spv_result_t ControlFlowPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with ControlFlowPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpPhi:
       if (auto error = ValidatePhi(_, inst)) return error;
@@ -1164,5 +1177,19 @@ spv_result_t ControlFlowPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool ControlFlowPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpPhi:
+    case SpvOpBranch:
+    case SpvOpBranchConditional:
+    case SpvOpReturnValue:
+    case SpvOpSwitch:
+    case SpvOpLoopMerge:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
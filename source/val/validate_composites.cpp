@@ -585,6 +585,7 @@ spv_result_t ValidateCopyLogical(ValidationState_t& _,
 
 // Validates correctness of composite instructions.
 spv_result_t CompositesPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with CompositesPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpVectorExtractDynamic:
       return ValidateVectorExtractDynamic(_, inst);
@@ -611,5 +612,22 @@ spv_result_t CompositesPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool CompositesPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpVectorExtractDynamic:
+    case SpvOpVectorInsertDynamic:
+    case SpvOpVectorShuffle:
+    case SpvOpCompositeConstruct:
+    case SpvOpCompositeExtract:
+    case SpvOpCompositeInsert:
+    case SpvOpCopyObject:
+    case SpvOpTranspose:
+    case SpvOpCopyLogical:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -295,7 +295,7 @@ spv_result_t ValidateConstantSampler(ValidationState_t& _,
 // True if instruction defines a type that can have a null value, as defined by
 // the SPIR-V spec.  Tracks composite-type components through module to check
 // nullability transitively.
-bool IsTypeNullable(const std::vector<uint32_t>& instruction,
+bool IsTypeNullable(utils::Span<const uint32_t> instruction,
                     const ValidationState_t& _) {
   uint16_t opcode;
   uint16_t word_count;
@@ -424,6 +424,7 @@ spv_result_t ValidateSpecConstantOp(ValidationState_t& _,
 }  // namespace
 
 spv_result_t ConstantPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with ConstantPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpConstantTrue:
     case SpvOpConstantFalse:
@@ -464,5 +465,9 @@ spv_result_t ConstantPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool ConstantPassChecksOpcode(SpvOp opcode) {
+  return spvOpcodeIsConstant(opcode) != 0;
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -56,6 +56,7 @@ spv_result_t ValidateLine(ValidationState_t& _, const Instruction* inst) {
 }  // namespace
 
 spv_result_t DebugPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with DebugPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpMemberName:
       if (auto error = ValidateMemberName(_, inst)) return error;
@@ -70,5 +71,15 @@ spv_result_t DebugPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool DebugPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpMemberName:
+    case SpvOpLine:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <set>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -69,9 +70,27 @@ struct LayoutConstraints {
 using MemberConstraints = std::unordered_map<std::pair<uint32_t, uint32_t>,
                                              LayoutConstraints, PairHash>;
 
+// What is known about the layout of the structs of a module.  It is shared by
+// the checks of all the buffer variables, since neither the constraints of
+// the members of a struct nor the size and alignment of a struct depend on the
+// variable the struct is laid out in.
+struct StructLayouts {
+  MemberConstraints constraints;
+  // The structs whose member constraints are in |constraints|.
+  std::unordered_set<uint32_t> constrained_structs;
+  // Base alignments of structs, by struct id and whether they are rounded up.
+  std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, PairHash>
+      base_alignments;
+  // Sizes of structs, by struct id.
+  std::unordered_map<uint32_t, uint32_t> sizes;
+  // The layouts checkLayout found valid, by struct id, block rules, scalar
+  // block layout and offset of the struct.
+  std::set<std::tuple<uint32_t, bool, bool, uint32_t>> valid_layouts;
+};
+
 // Returns the array stride of the given array type.
 uint32_t GetArrayStride(uint32_t array_id, ValidationState_t& vstate) {
-  for (auto& decoration : vstate.id_decorations(array_id)) {
+  for (const Decoration& decoration : vstate.decorations(array_id)) {
     if (SpvDecorationArrayStride == decoration.dec_type()) {
       return decoration.params()[0];
     }
@@ -81,7 +100,7 @@ uint32_t GetArrayStride(uint32_t array_id, ValidationState_t& vstate) {
 
 // Returns true if the given variable has a BuiltIn decoration.
 bool isBuiltInVar(uint32_t var_id, ValidationState_t& vstate) {
-  const auto& decorations = vstate.id_decorations(var_id);
+  const auto decorations = vstate.decorations(var_id);
   return std::any_of(
       decorations.begin(), decorations.end(),
       [](const Decoration& d) { return SpvDecorationBuiltIn == d.dec_type(); });
@@ -90,7 +109,7 @@ bool isBuiltInVar(uint32_t var_id, ValidationState_t& vstate) {
 // Returns true if the given structure type has any members with BuiltIn
 // decoration.
 bool isBuiltInStruct(uint32_t struct_id, ValidationState_t& vstate) {
-  const auto& decorations = vstate.id_decorations(struct_id);
+  const auto decorations = vstate.decorations(struct_id);
   return std::any_of(
       decorations.begin(), decorations.end(), [](const Decoration& d) {
         return SpvDecorationBuiltIn == d.dec_type() &&
@@ -100,7 +119,7 @@ bool isBuiltInStruct(uint32_t struct_id, ValidationState_t& vstate) {
 
 // Returns true if the given structure type has a Block decoration.
 bool isBlock(uint32_t struct_id, ValidationState_t& vstate) {
-  const auto& decorations = vstate.id_decorations(struct_id);
+  const auto decorations = vstate.decorations(struct_id);
   return std::any_of(
       decorations.begin(), decorations.end(),
       [](const Decoration& d) { return SpvDecorationBlock == d.dec_type(); });
@@ -108,7 +127,7 @@ bool isBlock(uint32_t struct_id, ValidationState_t& vstate) {
 
 // Returns true if the given ID has the Import LinkageAttributes decoration.
 bool hasImportLinkageAttribute(uint32_t id, ValidationState_t& vstate) {
-  const auto& decorations = vstate.id_decorations(id);
+  const auto decorations = vstate.decorations(id);
   return std::any_of(decorations.begin(), decorations.end(),
                      [](const Decoration& d) {
                        return SpvDecorationLinkageAttributes == d.dec_type() &&
@@ -147,7 +166,7 @@ bool isMissingOffsetInStruct(uint32_t struct_id, ValidationState_t& vstate) {
     struct_members = getStructMembers(struct_id, vstate);
     hasOffset.resize(struct_members.size(), false);
 
-    for (auto& decoration : vstate.id_decorations(struct_id)) {
+    for (const Decoration& decoration : vstate.decorations(struct_id)) {
       if (SpvDecorationOffset == decoration.dec_type() &&
           Decoration::kInvalidMember != decoration.struct_member_index()) {
         // Offset 0xffffffff is not valid so ignore it for simplicity's sake.
@@ -183,7 +202,7 @@ uint32_t align(uint32_t x, uint32_t alignment) {
 // bytes.
 uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
                           const LayoutConstraints& inherited,
-                          MemberConstraints& constraints,
+                          StructLayouts& layouts,
                           ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
@@ -205,7 +224,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
       const auto componentId = words[2];
       const auto numComponents = words[3];
       const auto componentAlignment = getBaseAlignment(
-          componentId, roundUp, inherited, constraints, vstate);
+          componentId, roundUp, inherited, layouts, vstate);
       baseAlignment =
           componentAlignment * (numComponents == 3 ? 4 : numComponents);
       break;
@@ -214,7 +233,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
       const auto column_type = words[2];
       if (inherited.majorness == kColumnMajor) {
         baseAlignment = getBaseAlignment(column_type, roundUp, inherited,
-                                         constraints, vstate);
+                                         layouts, vstate);
       } else {
         // A row-major matrix of C columns has a base alignment equal to the
         // base alignment of a vector of C matrix components.
@@ -222,7 +241,7 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
         const auto component_inst = vstate.FindDef(column_type);
         const auto component_id = component_inst->words()[2];
         const auto componentAlignment = getBaseAlignment(
-            component_id, roundUp, inherited, constraints, vstate);
+            component_id, roundUp, inherited, layouts, vstate);
         baseAlignment =
             componentAlignment * (num_columns == 3 ? 4 : num_columns);
       }
@@ -231,21 +250,25 @@ uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
     case SpvOpTypeArray:
     case SpvOpTypeRuntimeArray:
       baseAlignment =
-          getBaseAlignment(words[2], roundUp, inherited, constraints, vstate);
+          getBaseAlignment(words[2], roundUp, inherited, layouts, vstate);
       if (roundUp) baseAlignment = align(baseAlignment, 16u);
       break;
     case SpvOpTypeStruct: {
+      const auto key = std::make_pair(member_id, uint32_t(roundUp));
+      const auto known = layouts.base_alignments.find(key);
+      if (known != layouts.base_alignments.end()) return known->second;
       const auto members = getStructMembers(member_id, vstate);
       for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
            memberIdx < numMembers; ++memberIdx) {
         const auto id = members[memberIdx];
         const auto& constraint =
-            constraints[std::make_pair(member_id, memberIdx)];
+            layouts.constraints[std::make_pair(member_id, memberIdx)];
         baseAlignment = std::max(
             baseAlignment,
-            getBaseAlignment(id, roundUp, constraint, constraints, vstate));
+            getBaseAlignment(id, roundUp, constraint, layouts, vstate));
       }
       if (roundUp) baseAlignment = align(baseAlignment, 16u);
+      layouts.base_alignments[key] = baseAlignment;
       break;
     }
     case SpvOpTypePointer:
@@ -307,7 +330,7 @@ uint32_t getScalarAlignment(uint32_t type_id, ValidationState_t& vstate) {
 // Returns size of a struct member. Doesn't include padding at the end of struct
 // or array.  Assumes that in the struct case, all members have offsets.
 uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
-                 MemberConstraints& constraints, ValidationState_t& vstate) {
+                 StructLayouts& layouts, ValidationState_t& vstate) {
   const auto inst = vstate.FindDef(member_id);
   const auto& words = inst->words();
   switch (inst->opcode()) {
@@ -325,7 +348,7 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
       const auto componentId = words[2];
       const auto numComponents = words[3];
       const auto componentSize =
-          getSize(componentId, inherited, constraints, vstate);
+          getSize(componentId, inherited, layouts, vstate);
       const auto size = componentSize * numComponents;
       return size;
     }
@@ -336,7 +359,7 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
       const uint32_t num_elem = sizeInst->words()[3];
       const uint32_t elem_type = words[2];
       const uint32_t elem_size =
-          getSize(elem_type, inherited, constraints, vstate);
+          getSize(elem_type, inherited, layouts, vstate);
       // Account for gaps due to alignments in the first N-1 elements,
       // then add the size of the last element.
       const auto size =
@@ -356,32 +379,36 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
         const auto num_rows = component_inst->words()[3];
         const auto scalar_elem_type = component_inst->words()[2];
         const uint32_t scalar_elem_size =
-            getSize(scalar_elem_type, inherited, constraints, vstate);
+            getSize(scalar_elem_type, inherited, layouts, vstate);
         return (num_rows - 1) * inherited.matrix_stride +
                num_columns * scalar_elem_size;
       }
     }
     case SpvOpTypeStruct: {
+      const auto known = layouts.sizes.find(member_id);
+      if (known != layouts.sizes.end()) return known->second;
       const auto& members = getStructMembers(member_id, vstate);
       if (members.empty()) return 0;
       const auto lastIdx = uint32_t(members.size() - 1);
       const auto& lastMember = members.back();
       uint32_t offset = 0xffffffff;
       // Find the offset of the last element and add the size.
-      auto member_decorations =
-          vstate.id_member_decorations(member_id, lastIdx);
-      for (auto decoration = member_decorations.begin;
-           decoration != member_decorations.end; ++decoration) {
-        assert(decoration->struct_member_index() == (int)lastIdx);
-        if (SpvDecorationOffset == decoration->dec_type()) {
-          offset = decoration->params()[0];
+      for (const Decoration& decoration :
+           vstate.member_decorations(member_id, lastIdx)) {
+        assert(decoration.struct_member_index() == (int)lastIdx);
+        if (SpvDecorationOffset == decoration.dec_type()) {
+          offset = decoration.params()[0];
         }
       }
       // This check depends on the fact that all members have offsets.  This
       // has been checked earlier in the flow.
       assert(offset != 0xffffffff);
-      const auto& constraint = constraints[std::make_pair(lastMember, lastIdx)];
-      return offset + getSize(lastMember, constraint, constraints, vstate);
+      const auto& constraint =
+          layouts.constraints[std::make_pair(lastMember, lastIdx)];
+      const uint32_t size =
+          offset + getSize(lastMember, constraint, layouts, vstate);
+      layouts.sizes[member_id] = size;
+      return size;
     }
     case SpvOpTypePointer:
       return vstate.pointer_size_and_alignment();
@@ -400,9 +427,9 @@ uint32_t getSize(uint32_t member_id, const LayoutConstraints& inherited,
 // decorations placing its first byte at a non-integer multiple of 16.
 bool hasImproperStraddle(uint32_t id, uint32_t offset,
                          const LayoutConstraints& inherited,
-                         MemberConstraints& constraints,
+                         StructLayouts& layouts,
                          ValidationState_t& vstate) {
-  const auto size = getSize(id, inherited, constraints, vstate);
+  const auto size = getSize(id, inherited, layouts, vstate);
   const auto F = offset;
   const auto L = offset + size - 1;
   if (size <= 16) {
@@ -428,7 +455,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
                          const char* decoration_str, bool blockRules,
                          bool scalar_block_layout,
                          uint32_t incoming_offset,
-                         MemberConstraints& constraints,
+                         StructLayouts& layouts,
                          ValidationState_t& vstate) {
   if (vstate.options()->skip_block_layout) return SPV_SUCCESS;
 
@@ -436,6 +463,12 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
   // standard layout extension is being used.
   if (vstate.options()->uniform_buffer_standard_layout) blockRules = false;
 
+  // Only the messages depend on the storage class and decoration, so a layout
+  // found valid for one variable is valid for all.
+  const auto layout = std::make_tuple(struct_id, blockRules,
+                                      scalar_block_layout, incoming_offset);
+  if (layouts.valid_layouts.count(layout)) return SPV_SUCCESS;
+
   // Relaxed layout and scalar layout can both be in effect at the same time.
   // For example, relaxed layout is implied by Vulkan 1.1.  But scalar layout
   // is more permissive than relaxed layout.
@@ -470,14 +503,12 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
   for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
        memberIdx < numMembers; memberIdx++) {
     uint32_t offset = 0xffffffff;
-    auto member_decorations =
-        vstate.id_member_decorations(struct_id, memberIdx);
-    for (auto decoration = member_decorations.begin;
-         decoration != member_decorations.end; ++decoration) {
-      assert(decoration->struct_member_index() == (int)memberIdx);
-      switch (decoration->dec_type()) {
+    for (const Decoration& decoration :
+         vstate.member_decorations(struct_id, memberIdx)) {
+      assert(decoration.struct_member_index() == (int)memberIdx);
+      switch (decoration.dec_type()) {
         case SpvDecorationOffset:
-          offset = decoration->params()[0];
+          offset = decoration.params()[0];
           break;
         default:
           break;
@@ -501,17 +532,17 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
     const auto offset = member_offset.offset;
     auto id = members[member_offset.member];
     const LayoutConstraints& constraint =
-        constraints[std::make_pair(struct_id, uint32_t(memberIdx))];
+        layouts.constraints[std::make_pair(struct_id, uint32_t(memberIdx))];
     // Scalar layout takes precedence because it's more permissive, and implying
     // an alignment that divides evenly into the alignment that would otherwise
     // be used.
     const auto alignment =
         scalar_block_layout
             ? getScalarAlignment(id, vstate)
-            : getBaseAlignment(id, blockRules, constraint, constraints, vstate);
+            : getBaseAlignment(id, blockRules, constraint, layouts, vstate);
     const auto inst = vstate.FindDef(id);
     const auto opcode = inst->opcode();
-    const auto size = getSize(id, constraint, constraints, vstate);
+    const auto size = getSize(id, constraint, layouts, vstate);
     // Check offset.
     if (offset == 0xffffffff)
       return fail(memberIdx) << "is missing an Offset decoration";
@@ -541,7 +572,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
     if (!scalar_block_layout && relaxed_block_layout) {
       // Check improper straddle of vectors.
       if (SpvOpTypeVector == opcode &&
-          hasImproperStraddle(id, offset, constraint, constraints, vstate))
+          hasImproperStraddle(id, offset, constraint, layouts, vstate))
         return fail(memberIdx)
                << "is an improperly straddling vector at offset " << offset;
     }
@@ -551,7 +582,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
         SPV_SUCCESS != (recursive_status = checkLayout(
                             id, storage_class_str, decoration_str, blockRules,
                             scalar_block_layout,
-                            offset, constraints, vstate)))
+                            offset, layouts, vstate)))
       return recursive_status;
     // Check matrix stride.
     if (SpvOpTypeMatrix == opcode) {
@@ -571,7 +602,8 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
       const auto element_inst = vstate.FindDef(typeId);
       // Check array stride.
       uint32_t array_stride = 0;
-      for (auto& decoration : vstate.id_decorations(array_inst->id())) {
+      for (const Decoration& decoration :
+           vstate.decorations(array_inst->id())) {
         if (SpvDecorationArrayStride == decoration.dec_type()) {
           array_stride = decoration.params()[0];
           if (array_stride == 0) {
@@ -608,7 +640,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
           if (SPV_SUCCESS !=
               (recursive_status = checkLayout(
                    typeId, storage_class_str, decoration_str, blockRules,
-                   scalar_block_layout, next_offset, constraints, vstate)))
+                   scalar_block_layout, next_offset, layouts, vstate)))
             return recursive_status;
 
           seen[next_offset % 16] = true;
@@ -620,10 +652,10 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
       array_alignment = scalar_block_layout
                             ? getScalarAlignment(array_inst->id(), vstate)
                             : getBaseAlignment(array_inst->id(), blockRules,
-                                               constraint, constraints, vstate);
+                                               constraint, layouts, vstate);
 
       const auto element_size =
-          getSize(element_inst->id(), constraint, constraints, vstate);
+          getSize(element_inst->id(), constraint, layouts, vstate);
       if (element_size > array_stride) {
         return fail(memberIdx)
                << "contains an array with stride " << array_stride
@@ -638,6 +670,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
       nextValidOffset = align(nextValidOffset, alignment);
     }
   }
+  layouts.valid_layouts.insert(layout);
   return SPV_SUCCESS;
 }
 
@@ -645,7 +678,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
 // nested structures.
 bool hasDecoration(uint32_t id, SpvDecoration decoration,
                    ValidationState_t& vstate) {
-  for (auto& dec : vstate.id_decorations(id)) {
+  for (const Decoration& dec : vstate.decorations(id)) {
     if (decoration == dec.dec_type()) return true;
   }
   if (SpvOpTypeStruct != vstate.FindDef(id)->opcode()) {
@@ -668,14 +701,12 @@ bool checkForRequiredDecoration(uint32_t struct_id,
     const auto id = members[memberIdx];
     if (type != vstate.FindDef(id)->opcode()) continue;
     bool found = false;
-    for (auto& dec : vstate.id_decorations(id)) {
+    for (const Decoration& dec : vstate.decorations(id)) {
       if (checker(dec.dec_type())) found = true;
     }
-    for (auto& dec : vstate.id_decorations(struct_id)) {
-      if (checker(dec.dec_type()) &&
-          (int)memberIdx == dec.struct_member_index()) {
-        found = true;
-      }
+    for (const Decoration& dec : vstate.member_decorations(
+             struct_id, static_cast<uint32_t>(memberIdx))) {
+      if (checker(dec.dec_type())) found = true;
     }
     if (!found) {
       return false;
@@ -734,8 +765,7 @@ spv_result_t CheckImportedVariableInitialization(ValidationState_t& vstate) {
 
 // Checks whether a builtin variable is valid.
 spv_result_t CheckBuiltInVariable(uint32_t var_id, ValidationState_t& vstate) {
-  const auto& decorations = vstate.id_decorations(var_id);
-  for (const auto& d : decorations) {
+  for (const Decoration& d : vstate.decorations(var_id)) {
     if (spvIsVulkanEnv(vstate.context()->target_env)) {
       if (d.dec_type() == SpvDecorationLocation ||
           d.dec_type() == SpvDecorationComponent) {
@@ -895,7 +925,7 @@ spv_result_t CheckDecorationsOfEntryPoints(ValidationState_t& vstate) {
       }
       // The LinkageAttributes Decoration cannot be applied to functions
       // targeted by an OpEntryPoint instruction
-      for (auto& decoration : vstate.id_decorations(entry_point)) {
+      for (const Decoration& decoration : vstate.decorations(entry_point)) {
         if (SpvDecorationLinkageAttributes == decoration.dec_type()) {
           const std::string linkage_name =
               spvtools::utils::MakeString(decoration.params());
@@ -936,32 +966,32 @@ spv_result_t CheckDecorationsOfEntryPoints(ValidationState_t& vstate) {
   return SPV_SUCCESS;
 }
 
-// Load |constraints| with all the member constraints for structs contained
+// Load |layouts| with all the member constraints for structs contained
 // within the given array type.
-void ComputeMemberConstraintsForArray(MemberConstraints* constraints,
+void ComputeMemberConstraintsForArray(StructLayouts* layouts,
                                       uint32_t array_id,
                                       const LayoutConstraints& inherited,
                                       ValidationState_t& vstate);
 
-// Load |constraints| with all the member constraints for the given struct,
-// and all its contained structs.
-void ComputeMemberConstraintsForStruct(MemberConstraints* constraints,
+// Load |layouts| with all the member constraints for the given struct,
+// and all its contained structs.  The constraints of each struct are computed
+// once, so |inherited| must be the same for all the calls with |layouts|.
+void ComputeMemberConstraintsForStruct(StructLayouts* layouts,
                                        uint32_t struct_id,
                                        const LayoutConstraints& inherited,
                                        ValidationState_t& vstate) {
-  assert(constraints);
+  assert(layouts);
+  if (!layouts->constrained_structs.insert(struct_id).second) return;
   const auto& members = getStructMembers(struct_id, vstate);
   for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
        memberIdx < numMembers; memberIdx++) {
     LayoutConstraints& constraint =
-        (*constraints)[std::make_pair(struct_id, memberIdx)];
+        layouts->constraints[std::make_pair(struct_id, memberIdx)];
     constraint = inherited;
-    auto member_decorations =
-        vstate.id_member_decorations(struct_id, memberIdx);
-    for (auto decoration = member_decorations.begin;
-         decoration != member_decorations.end; ++decoration) {
-      assert(decoration->struct_member_index() == (int)memberIdx);
-      switch (decoration->dec_type()) {
+    for (const Decoration& decoration :
+         vstate.member_decorations(struct_id, memberIdx)) {
+      assert(decoration.struct_member_index() == (int)memberIdx);
+      switch (decoration.dec_type()) {
         case SpvDecorationRowMajor:
           constraint.majorness = kRowMajor;
           break;
@@ -969,7 +999,7 @@ void ComputeMemberConstraintsForStruct(MemberConstraints* constraints,
           constraint.majorness = kColumnMajor;
           break;
         case SpvDecorationMatrixStride:
-          constraint.matrix_stride = decoration->params()[0];
+          constraint.matrix_stride = decoration.params()[0];
           break;
         default:
           break;
@@ -983,12 +1013,12 @@ void ComputeMemberConstraintsForStruct(MemberConstraints* constraints,
     switch (opcode) {
       case SpvOpTypeArray:
       case SpvOpTypeRuntimeArray:
-        ComputeMemberConstraintsForArray(constraints, member_type_id, inherited,
+        ComputeMemberConstraintsForArray(layouts, member_type_id, inherited,
                                          vstate);
         break;
       case SpvOpTypeStruct:
-        ComputeMemberConstraintsForStruct(constraints, member_type_id,
-                                          inherited, vstate);
+        ComputeMemberConstraintsForStruct(layouts, member_type_id, inherited,
+                                          vstate);
         break;
       default:
         break;
@@ -996,22 +1026,22 @@ void ComputeMemberConstraintsForStruct(MemberConstraints* constraints,
   }
 }
 
-void ComputeMemberConstraintsForArray(MemberConstraints* constraints,
+void ComputeMemberConstraintsForArray(StructLayouts* layouts,
                                       uint32_t array_id,
                                       const LayoutConstraints& inherited,
                                       ValidationState_t& vstate) {
-  assert(constraints);
+  assert(layouts);
   auto elem_type_id = vstate.FindDef(array_id)->words()[2];
   const auto elem_type_inst = vstate.FindDef(elem_type_id);
   const auto opcode = elem_type_inst->opcode();
   switch (opcode) {
     case SpvOpTypeArray:
     case SpvOpTypeRuntimeArray:
-      ComputeMemberConstraintsForArray(constraints, elem_type_id, inherited,
+      ComputeMemberConstraintsForArray(layouts, elem_type_id, inherited,
                                        vstate);
       break;
     case SpvOpTypeStruct:
-      ComputeMemberConstraintsForStruct(constraints, elem_type_id, inherited,
+      ComputeMemberConstraintsForStruct(layouts, elem_type_id, inherited,
                                         vstate);
       break;
     default:
@@ -1022,6 +1052,7 @@ void ComputeMemberConstraintsForArray(MemberConstraints* constraints,
 spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
   // Set of entry points that are known to use a push constant.
   std::unordered_set<uint32_t> uses_push_constant;
+  StructLayouts layouts;
   for (const auto& inst : vstate.ordered_instructions()) {
     const auto& words = inst.words();
     if (SpvOpVariable == inst.opcode()) {
@@ -1115,8 +1146,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
         }
         // Struct requirement is checked on variables so just move on here.
         if (SpvOpTypeStruct != id_inst->opcode()) continue;
-        MemberConstraints constraints;
-        ComputeMemberConstraintsForStruct(&constraints, id, LayoutConstraints(),
+        ComputeMemberConstraintsForStruct(&layouts, id, LayoutConstraints(),
                                           vstate);
         // Prepare for messages
         const char* sc_str =
@@ -1186,7 +1216,7 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
           }
         }
 
-        for (const auto& dec : vstate.id_decorations(id)) {
+        for (const Decoration& dec : vstate.decorations(id)) {
           const bool blockDeco = SpvDecorationBlock == dec.dec_type();
           const bool bufferDeco = SpvDecorationBufferBlock == dec.dec_type();
           const bool blockRules = uniform && blockDeco;
@@ -1259,13 +1289,13 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
                        (SPV_SUCCESS !=
                         (recursive_status = checkLayout(
                              id, sc_str, deco_str, true, scalar_block_layout, 0,
-                             constraints, vstate)))) {
+                             layouts, vstate)))) {
               return recursive_status;
             } else if (bufferRules &&
                        (SPV_SUCCESS !=
                         (recursive_status = checkLayout(
                              id, sc_str, deco_str, false, scalar_block_layout,
-                             0, constraints, vstate)))) {
+                             0, layouts, vstate)))) {
               return recursive_status;
             }
           }
@@ -1401,7 +1431,7 @@ spv_result_t CheckVulkanMemoryModelDeprecatedDecorations(
   for (const auto& def : vstate.all_definitions()) {
     const auto inst = def.second;
     const auto id = inst->id();
-    for (const auto& dec : vstate.id_decorations(id)) {
+    for (const Decoration& dec : vstate.decorations(id)) {
       const auto member = dec.struct_member_index();
       if (dec.dec_type() == SpvDecorationCoherent ||
           dec.dec_type() == SpvDecorationVolatile) {
@@ -28,6 +28,7 @@ namespace val {
 
 // Validates correctness of derivative instructions.
 spv_result_t DerivativesPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with DerivativesPassChecksOpcode.
   const SpvOp opcode = inst->opcode();
   const uint32_t result_type = inst->type_id();
 
@@ -108,5 +109,22 @@ spv_result_t DerivativesPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool DerivativesPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpDPdx:
+    case SpvOpDPdy:
+    case SpvOpFwidth:
+    case SpvOpDPdxFine:
+    case SpvOpDPdyFine:
+    case SpvOpFwidthFine:
+    case SpvOpDPdxCoarse:
+    case SpvOpDPdyCoarse:
+    case SpvOpFwidthCoarse:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
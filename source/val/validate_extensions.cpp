@@ -3401,6 +3401,7 @@ spv_result_t ValidateExtInst(ValidationState_t& _, const Instruction* inst) {
 }
 
 spv_result_t ExtensionPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with ExtensionPassChecksOpcode.
   const SpvOp opcode = inst->opcode();
   if (opcode == SpvOpExtension) return ValidateExtension(_, inst);
   if (opcode == SpvOpExtInstImport) return ValidateExtInstImport(_, inst);
@@ -3409,5 +3410,10 @@ spv_result_t ExtensionPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool ExtensionPassChecksOpcode(SpvOp opcode) {
+  return opcode == SpvOpExtension || opcode == SpvOpExtInstImport ||
+         opcode == SpvOpExtInst;
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -336,6 +336,7 @@ spv_result_t ValidateFunctionCall(ValidationState_t& _,
 }  // namespace
 
 spv_result_t FunctionPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with FunctionPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpFunction:
       if (auto error = ValidateFunction(_, inst)) return error;
@@ -353,5 +354,16 @@ spv_result_t FunctionPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool FunctionPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpFunction:
+    case SpvOpFunctionParameter:
+    case SpvOpFunctionCall:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
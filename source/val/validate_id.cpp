@@ -50,18 +50,19 @@ spv_result_t UpdateIdUse(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
-/// This function checks all ID definitions dominate their use in the CFG.
-///
-/// This function will iterate over all ID definitions that are defined in the
-/// functions of a module and make sure that the definitions appear in a
-/// block that dominates their use.
-///
-/// NOTE: This function does NOT check module scoped functions which are
-/// checked during the initial binary parse in the IdPass below
-spv_result_t CheckIdDefinitionDominateUse(ValidationState_t& _) {
-  std::vector<const Instruction*> phi_instructions;
+namespace {
+
+// Checks that the ids defined by the instructions in [first, last) dominate
+// their uses. Uses by OpPhi instructions are not checked here. Instead the
+// OpPhi instructions are appended to |phi_instructions| in the order they are
+// first seen. The validation state is only read, so disjoint ranges can be
+// checked concurrently.
+spv_result_t CheckIdDefinitionDominateUse(
+    ValidationState_t& _, const Instruction* first, const Instruction* last,
+    std::vector<const Instruction*>* phi_instructions) {
   std::unordered_set<uint32_t> phi_ids;
-  for (const auto& inst : _.ordered_instructions()) {
+  for (const Instruction* it = first; it != last; ++it) {
+    const Instruction& inst = *it;
     if (inst.id() == 0) continue;
     if (const Function* func = inst.function()) {
       if (const BasicBlock* block = inst.block()) {
@@ -73,7 +74,7 @@ spv_result_t CheckIdDefinitionDominateUse(ValidationState_t& _) {
             if (use_block->reachable() == false) continue;
             if (use->opcode() == SpvOpPhi) {
               if (phi_ids.insert(use->id()).second) {
-                phi_instructions.push_back(use);
+                phi_instructions->push_back(use);
               }
             } else if (!block->dominates(*use->block())) {
               return _.diag(SPV_ERROR_INVALID_ID, use_block->label())
@@ -104,6 +105,55 @@ spv_result_t CheckIdDefinitionDominateUse(ValidationState_t& _) {
     // This check is being performed in the IdPass function
   }
 
+  return SPV_SUCCESS;
+}
+
+}  // namespace
+
+/// This function checks all ID definitions dominate their use in the CFG.
+///
+/// This function will iterate over all ID definitions that are defined in the
+/// functions of a module and make sure that the definitions appear in a
+/// block that dominates their use.
+///
+/// NOTE: This function does NOT check module scoped functions which are
+/// checked during the initial binary parse in the IdPass below
+spv_result_t CheckIdDefinitionDominateUse(ValidationState_t& _) {
+  // Split the instructions into one range per function so the functions can
+  // be checked independently. Instructions outside of functions are skipped,
+  // as are unchanged functions, which share no ids with other functions.
+  const auto& instructions = _.ordered_instructions();
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t i = 0; i < instructions.size(); ++i) {
+    const Function* func = instructions[i].function();
+    if (!func || _.IsUnchangedFunction(func->id())) continue;
+    if (!ranges.empty() && ranges.back().second == i &&
+        instructions[i - 1].function() == func) {
+      ranges.back().second = i + 1;
+    } else {
+      ranges.emplace_back(i, i + 1);
+    }
+  }
+
+  std::vector<std::vector<const Instruction*>> range_phi_instructions(
+      ranges.size());
+  if (auto error = _.RunIndependentChecks(ranges.size(), [&](size_t i) {
+        return CheckIdDefinitionDominateUse(
+            _, instructions.data() + ranges[i].first,
+            instructions.data() + ranges[i].second,
+            &range_phi_instructions[i]);
+      })) {
+    return error;
+  }
+
+  std::vector<const Instruction*> phi_instructions;
+  std::unordered_set<uint32_t> phi_ids;
+  for (const auto& phis : range_phi_instructions) {
+    for (const Instruction* phi : phis) {
+      if (phi_ids.insert(phi->id()).second) phi_instructions.push_back(phi);
+    }
+  }
+
   // Check all OpPhi parent blocks are dominated by the variable's defining
   // blocks
   for (const Instruction* phi : phi_instructions) {
@@ -1642,6 +1642,7 @@ spv_result_t ValidatePtrComparison(ValidationState_t& _,
 }  // namespace
 
 spv_result_t MemoryPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with MemoryPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpVariable:
       if (auto error = ValidateVariable(_, inst)) return error;
@@ -1688,5 +1689,29 @@ spv_result_t MemoryPass(ValidationState_t& _, const Instruction* inst) {
 
   return SPV_SUCCESS;
 }
+
+bool MemoryPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpVariable:
+    case SpvOpLoad:
+    case SpvOpStore:
+    case SpvOpCopyMemory:
+    case SpvOpCopyMemorySized:
+    case SpvOpPtrAccessChain:
+    case SpvOpAccessChain:
+    case SpvOpInBoundsAccessChain:
+    case SpvOpInBoundsPtrAccessChain:
+    case SpvOpArrayLength:
+    case SpvOpCooperativeMatrixLoadNV:
+    case SpvOpCooperativeMatrixStoreNV:
+    case SpvOpCooperativeMatrixLengthNV:
+    case SpvOpPtrEqual:
+    case SpvOpPtrNotEqual:
+    case SpvOpPtrDiff:
+      return true;
+    default:
+      return false;
+  }
+}
 }  // namespace val
 }  // namespace spvtools
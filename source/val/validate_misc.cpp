@@ -103,6 +103,7 @@ spv_result_t ValidateExpect(ValidationState_t& _, const Instruction* inst) {
 }  // namespace
 
 spv_result_t MiscPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with MiscPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpUndef:
       if (auto error = ValidateUndef(_, inst)) return error;
@@ -197,5 +198,21 @@ spv_result_t MiscPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool MiscPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpUndef:
+    case SpvOpBeginInvocationInterlockEXT:
+    case SpvOpEndInvocationInterlockEXT:
+    case SpvOpDemoteToHelperInvocationEXT:
+    case SpvOpIsHelperInvocationEXT:
+    case SpvOpReadClockKHR:
+    case SpvOpAssumeTrueKHR:
+    case SpvOpExpectKHR:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
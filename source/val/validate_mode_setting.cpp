@@ -570,6 +570,7 @@ spv_result_t ValidateMemoryModel(ValidationState_t& _,
 }  // namespace
 
 spv_result_t ModeSettingPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with ModeSettingPassChecksOpcode.
   switch (inst->opcode()) {
     case SpvOpEntryPoint:
       if (auto error = ValidateEntryPoint(_, inst)) return error;
@@ -587,5 +588,17 @@ spv_result_t ModeSettingPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool ModeSettingPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpEntryPoint:
+    case SpvOpExecutionMode:
+    case SpvOpExecutionModeId:
+    case SpvOpMemoryModel:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -120,6 +120,7 @@ spv_result_t ValidateGroupNonUniformRotateKHR(ValidationState_t& _,
 
 // Validates correctness of non-uniform group instructions.
 spv_result_t NonUniformPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with NonUniformPassChecksOpcode.
   const SpvOp opcode = inst->opcode();
 
   if (spvOpcodeIsNonUniformGroupOperation(opcode)) {
@@ -141,5 +142,16 @@ spv_result_t NonUniformPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool NonUniformPassChecksOpcode(SpvOp opcode) {
+  if (spvOpcodeIsNonUniformGroupOperation(opcode)) return true;
+  switch (opcode) {
+    case SpvOpGroupNonUniformBallotBitCount:
+    case SpvOpGroupNonUniformRotateKHR:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
@@ -28,6 +28,7 @@ namespace val {
 
 // Validates correctness of primitive instructions.
 spv_result_t PrimitivesPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with PrimitivesPassChecksOpcode.
   const SpvOp opcode = inst->opcode();
 
   switch (opcode) {
@@ -71,5 +72,17 @@ spv_result_t PrimitivesPass(ValidationState_t& _, const Instruction* inst) {
   return SPV_SUCCESS;
 }
 
+bool PrimitivesPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpEmitVertex:
+    case SpvOpEndPrimitive:
+    case SpvOpEmitStreamVertex:
+    case SpvOpEndStreamPrimitive:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace val
 }  // namespace spvtools
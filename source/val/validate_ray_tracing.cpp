@@ -23,6 +23,7 @@ namespace spvtools {
 namespace val {
 
 spv_result_t RayTracingPass(ValidationState_t& _, const Instruction* inst) {
+  // Keep the opcodes handled here in sync with RayTracingPassChecksOpcode.
   const SpvOp opcode = inst->opcode();
   const uint32_t result_type = inst->type_id();
 
@@ -202,5 +203,16 @@ spv_result_t RayTracingPass(ValidationState_t& _, const Instruction* inst) {
 
   return SPV_SUCCESS;
 }
+
+bool RayTracingPassChecksOpcode(SpvOp opcode) {
+  switch (opcode) {
+    case SpvOpTraceRayKHR:
+    case SpvOpReportIntersectionKHR:
+    case SpvOpExecuteCallableKHR:
+      return true;
+    default:
+      return false;
+  }
+}
 }  // namespace val
 }  // namespace spvtools
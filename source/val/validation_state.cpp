@@ -14,13 +14,17 @@
 
 #include "source/val/validation_state.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <functional>
 #include <stack>
 #include <utility>
 
 #include "source/opcode.h"
 #include "source/spirv_constant.h"
 #include "source/spirv_target_env.h"
+#include "source/util/parallel.h"
 #include "source/val/basic_block.h"
 #include "source/val/construct.h"
 #include "source/val/function.h"
@@ -30,6 +34,17 @@ namespace spvtools {
 namespace val {
 namespace {
 
+// Orders indexed decorations by struct member index, to find the decorations
+// of a member.
+struct IndexedDecorationLess {
+  bool operator()(const Decoration& decoration, int member_index) const {
+    return decoration.struct_member_index() < member_index;
+  }
+  bool operator()(int member_index, const Decoration& decoration) const {
+    return member_index < decoration.struct_member_index();
+  }
+};
+
 ModuleLayoutSection InstructionLayoutSection(
     ModuleLayoutSection current_section, SpvOp op) {
   // See Section 2.4
@@ -136,6 +151,26 @@ void UpdateFeaturesBasedOnSpirvVersion(ValidationState_t::Feature* features,
   }
 }
 
+// A diagnostic held back by RunIndependentChecks until it is known whether it
+// would have been reported by a serial run.
+struct BufferedMessage {
+  spv_message_level_t level;
+  std::string source;
+  spv_position_t position;
+  std::string message;
+};
+
+// When set, diagnostics raised on this thread are appended here instead of
+// being sent to the context's consumer.
+thread_local std::vector<BufferedMessage>* tls_buffered_messages = nullptr;
+
+MessageConsumer BufferingConsumer(std::vector<BufferedMessage>* buffer) {
+  return [buffer](spv_message_level_t level, const char* source,
+                  const spv_position_t& position, const char* message) {
+    buffer->push_back({level, source ? source : "", position, message});
+  };
+}
+
 }  // namespace
 
 ValidationState_t::ValidationState_t(const spv_const_context ctx,
@@ -314,7 +349,52 @@ DiagnosticStream ValidationState_t::diag(spv_result_t error_code,
   if (inst) disassembly = Disassemble(*inst);
 
   return DiagnosticStream({0, 0, inst ? inst->LineNum() : 0},
-                          context_->consumer, disassembly, error_code);
+                          tls_buffered_messages
+                              ? BufferingConsumer(tls_buffered_messages)
+                              : context_->consumer,
+                          disassembly, error_code);
+}
+
+spv_result_t ValidationState_t::RunIndependentChecks(
+    size_t count, const std::function<spv_result_t(size_t)>& check) {
+  const uint32_t num_threads = options_->num_threads == 0
+                                   ? utils::HardwareConcurrency()
+                                   : options_->num_threads;
+  if (num_threads <= 1 || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      if (auto error = check(i)) return error;
+    }
+    return SPV_SUCCESS;
+  }
+
+  std::vector<spv_result_t> results(count, SPV_SUCCESS);
+  std::vector<std::vector<BufferedMessage>> messages(count);
+  std::atomic<size_t> first_error(count);
+  utils::ParallelFor(count, num_threads, [&](size_t i) {
+    // Nothing past the first failing index is ever reported.
+    if (i > first_error.load()) return;
+
+    tls_buffered_messages = &messages[i];
+    results[i] = check(i);
+    tls_buffered_messages = nullptr;
+
+    if (results[i] != SPV_SUCCESS) {
+      size_t current = first_error.load();
+      while (i < current && !first_error.compare_exchange_weak(current, i)) {
+      }
+    }
+  });
+
+  for (size_t i = 0; i < count; ++i) {
+    if (context_->consumer) {
+      for (const auto& message : messages[i]) {
+        context_->consumer(message.level, message.source.c_str(),
+                           message.position, message.message.c_str());
+      }
+    }
+    if (results[i] != SPV_SUCCESS) return results[i];
+  }
+  return SPV_SUCCESS;
 }
 
 std::vector<Function>& ValidationState_t::functions() {
@@ -515,7 +595,13 @@ spv_result_t ValidationState_t::RegisterFunctionEnd() {
 
 Instruction* ValidationState_t::AddOrderedInstruction(
     const spv_parsed_instruction_t* inst) {
-  ordered_instructions_.emplace_back(inst);
+  // The parser passes words that point into the module unless it had to
+  // convert their endianness, in which case they only live until the next
+  // instruction is parsed.
+  const bool in_module =
+      std::less_equal<const uint32_t*>()(words_, inst->words) &&
+      std::less<const uint32_t*>()(inst->words, words_ + num_words_);
+  ordered_instructions_.emplace_back(inst, in_module);
   ordered_instructions_.back().SetLineNum(ordered_instructions_.size());
   return &ordered_instructions_.back();
 }
@@ -787,6 +873,50 @@ bool ValidationState_t::RegisterUniqueTypeDeclaration(const Instruction* inst) {
   return unique_type_declarations_.insert(std::move(key)).second;
 }
 
+void ValidationState_t::BuildDecorationIndex() {
+  uint32_t bound = id_bound_;
+  if (!id_decorations_.empty()) {
+    bound = std::max(bound, id_decorations_.rbegin()->first + 1);
+  }
+  decoration_offsets_.assign(bound + 1, 0);
+  indexed_decorations_.clear();
+  uint32_t next_id = 0;
+  for (const auto& kv : id_decorations_) {
+    for (; next_id <= kv.first; ++next_id) {
+      decoration_offsets_[next_id] =
+          static_cast<uint32_t>(indexed_decorations_.size());
+    }
+    indexed_decorations_.insert(indexed_decorations_.end(), kv.second.begin(),
+                                kv.second.end());
+  }
+  for (; next_id <= bound; ++next_id) {
+    decoration_offsets_[next_id] =
+        static_cast<uint32_t>(indexed_decorations_.size());
+  }
+}
+
+ValidationState_t::DecorationSpan ValidationState_t::decorations(uint32_t id) {
+  if (decoration_offsets_.empty()) BuildDecorationIndex();
+  if (id >= decoration_offsets_.size() - 1) {
+    return DecorationSpan(indexed_decorations_.end(),
+                          indexed_decorations_.end());
+  }
+  return DecorationSpan(
+      indexed_decorations_.begin() + decoration_offsets_[id],
+      indexed_decorations_.begin() + decoration_offsets_[id + 1]);
+}
+
+ValidationState_t::DecorationSpan ValidationState_t::member_decorations(
+    uint32_t id, uint32_t member_index) {
+  const DecorationSpan all = decorations(id);
+  // The decorations are sorted by member index, so the decorations of the
+  // member are a contiguous range of those of the structure.
+  const auto range = std::equal_range(
+      all.begin(), all.end(), static_cast<int>(member_index),
+      IndexedDecorationLess());
+  return DecorationSpan(range.first, range.second);
+}
+
 uint32_t ValidationState_t::GetTypeId(uint32_t id) const {
   const Instruction* inst = FindDef(id);
   return inst ? inst->type_id() : 0;
@@ -16,6 +16,7 @@
 #define SOURCE_VAL_VALIDATION_STATE_H_
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -192,6 +193,15 @@ class ValidationState_t {
 
   DiagnosticStream diag(spv_result_t error_code, const Instruction* inst);
 
+  /// Runs |check| for every index in [0, count), spreading the calls over
+  /// options()->num_threads threads. The checks must be independent of each
+  /// other and must not emit warnings. Diagnostics are buffered per index and
+  /// forwarded to the consumer in index order up to the first failing index,
+  /// whose error is returned, so the outcome is the same as running the checks
+  /// serially and stopping at the first error.
+  spv_result_t RunIndependentChecks(
+      size_t count, const std::function<spv_result_t(size_t)>& check);
+
   /// Returns the function states
   std::vector<Function>& functions();
 
@@ -203,6 +213,22 @@ class ValidationState_t {
   const Function* function(uint32_t id) const;
   Function* function(uint32_t id);
 
+  /// Marks the function |id| as the same as in a module that passed
+  /// validation before. The control flow and dominance checks skip it.
+  void RegisterUnchangedFunction(uint32_t id) {
+    unchanged_functions_.insert(id);
+  }
+
+  /// Returns true if the function |id| is marked as unchanged.
+  bool IsUnchangedFunction(uint32_t id) const {
+    return unchanged_functions_.count(id) != 0;
+  }
+
+  /// Returns the number of functions marked as unchanged.
+  size_t num_unchanged_functions() const {
+    return unchanged_functions_.size();
+  }
+
   /// Returns true if the called after a function instruction but before the
   /// function end instruction
   bool in_function_body() const;
@@ -378,6 +404,8 @@ class ValidationState_t {
   const AssemblyGrammar& grammar() const { return grammar_; }
 
   /// Inserts the instruction into the list of ordered instructions in the file.
+  /// Words that lie in the module being validated are referenced rather than
+  /// copied.
   Instruction* AddOrderedInstruction(const spv_parsed_instruction_t* inst);
 
   /// Registers the instruction. This will add the instruction to the list of
@@ -391,6 +419,7 @@ class ValidationState_t {
   void RegisterDecorationForId(uint32_t id, const Decoration& dec) {
     auto& dec_list = id_decorations_[id];
     dec_list.insert(dec);
+    decoration_offsets_.clear();
   }
 
   /// Registers the list of decorations for the given <id>
@@ -398,6 +427,7 @@ class ValidationState_t {
   void RegisterDecorationsForId(uint32_t id, InputIt begin, InputIt end) {
     std::set<Decoration>& cur_decs = id_decorations_[id];
     cur_decs.insert(begin, end);
+    decoration_offsets_.clear();
   }
 
   /// Registers the list of decorations for the given member of the given
@@ -412,6 +442,7 @@ class ValidationState_t {
       dec.set_struct_member_index(member_index);
       cur_decs.insert(dec);
     }
+    decoration_offsets_.clear();
   }
 
   /// Returns all the decorations for the given <id>. If no decorations exist
@@ -458,6 +489,37 @@ class ValidationState_t {
         [dec](const Decoration& d) { return dec == d.dec_type(); });
   }
 
+  /// A contiguous range of the decoration index.
+  class DecorationSpan {
+   public:
+    using const_iterator =
+        std::vector<std::reference_wrapper<const Decoration>>::const_iterator;
+
+    DecorationSpan(const_iterator begin, const_iterator end)
+        : begin_(begin), end_(end) {}
+
+    const_iterator begin() const { return begin_; }
+    const_iterator end() const { return end_; }
+    bool empty() const { return begin_ == end_; }
+
+   private:
+    const_iterator begin_;
+    const_iterator end_;
+  };
+
+  /// Returns the decorations of <id> in the same order as id_decorations(id):
+  /// the decorations of <id> itself, then those of its members by member
+  /// index.  Unlike id_decorations(id), this does not register an empty set
+  /// for undecorated ids.  The spans come from a flat index that the first
+  /// call after a decoration is registered rebuilds, so this is meant for the
+  /// checks that run once all the annotations have been seen.  Not safe to
+  /// call concurrently.
+  DecorationSpan decorations(uint32_t id);
+
+  /// Returns the decorations of member <member_index> of the structure <id>,
+  /// from the same index as decorations(id).
+  DecorationSpan member_decorations(uint32_t id, uint32_t member_index);
+
   /// Finds id's def, if it exists.  If found, returns the definition otherwise
   /// nullptr
   const Instruction* FindDef(uint32_t id) const;
@@ -853,6 +915,9 @@ class ValidationState_t {
   /// Functions IDs that are target of OpFunctionCall.
   std::unordered_set<uint32_t> function_call_targets_;
 
+  /// IDs of the functions that passed validation before, unchanged.
+  std::unordered_set<uint32_t> unchanged_functions_;
+
   /// ID Bound from the Header
   uint32_t id_bound_;
 
@@ -875,11 +940,29 @@ class ValidationState_t {
   /// Stores the list of decorations for a given <id>
   std::map<uint32_t, std::set<Decoration>> id_decorations_;
 
+  /// Flat index of id_decorations_: the decorations of <id> are
+  /// indexed_decorations_[decoration_offsets_[id]] up to
+  /// indexed_decorations_[decoration_offsets_[id + 1]].  The offsets are
+  /// cleared whenever a decoration is registered, and rebuilt on demand.
+  std::vector<uint32_t> decoration_offsets_;
+  std::vector<std::reference_wrapper<const Decoration>> indexed_decorations_;
+
+  /// Rebuilds the decoration index from id_decorations_.
+  void BuildDecorationIndex();
+
+  /// Hashes the words of a type declaration.
+  struct TypeDeclarationHash {
+    size_t operator()(const std::vector<uint32_t>& words) const {
+      size_t hash = words.size();
+      for (uint32_t word : words) hash = hash * 31 + word;
+      return hash;
+    }
+  };
+
   /// Stores type declarations which need to be unique (i.e. non-aggregates),
   /// in the form [opcode, operand words], result_id is not stored.
-  /// Using ordered set to avoid the need for a vector hash function.
-  /// The size of this container is expected not to exceed double-digits.
-  std::set<std::vector<uint32_t>> unique_type_declarations_;
+  std::unordered_set<std::vector<uint32_t>, TypeDeclarationHash>
+      unique_type_declarations_;
 
   AssemblyGrammar grammar_;
 
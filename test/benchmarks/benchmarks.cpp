@@ -0,0 +1,754 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks of the parser, assembler, disassembler, validator, optimizer,
+// linker and reducer, run on synthetic modules and optionally on a corpus.
+//
+// Usage: spirv-tools-bench [--corpus=<list>] [benchmark options]
+//
+// The file <list> names SPIR-V binaries to add to the benchmarked modules, one
+// per line.  The other options are those of Google Benchmark, such as
+// --benchmark_filter=<regex>.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "source/opt/analysis_snapshot.h"
+#include "source/opt/build_module.h"
+#include "source/opt/ir_context.h"
+#include "source/reduce/reducer.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/linker.hpp"
+#include "spirv-tools/optimizer.hpp"
+#include "test/benchmarks/heap_usage.h"
+#include "test/benchmarks/synthetic_module.h"
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// The numbers of functions of the synthetic modules.
+const uint32_t kSyntheticSizes[] = {8, 64, 512};
+
+// The numbers of distinct types of the modules deduplicated by the
+// remove-duplicates benchmarks.
+const uint32_t kDuplicateTypesSizes[] = {128, 1024, 8192};
+
+// The numbers of selections of the functions whose dominator trees are
+// benchmarked.  Each selection adds three blocks.
+const uint32_t kManyBlocksSizes[] = {1024, 8192};
+
+// The depths of the nested selections of the modules whose validation is
+// benchmarked.  The validator limits the nesting depth to 1023 by default.
+const uint32_t kNestingDepths[] = {64, 512};
+
+// The numbers of buffer variables of the modules whose decoration checks are
+// benchmarked.
+const uint32_t kBufferCounts[] = {64, 1024};
+
+// The dominance and lookup benchmarks pair query i with id i * kQueryStride,
+// modulo the number of ids, so the queries do not walk the tables in order.
+const size_t kQueryStride = 7919;
+
+// The number of modules linked together by the link benchmarks.
+const uint32_t kNumLinkedModules = 4;
+
+// The number of reduction steps taken by the reduce benchmarks.
+const uint32_t kReductionSteps = 16;
+
+// A module the benchmarks run on.
+struct Module {
+  std::string name;
+  spv_target_env env;
+  std::vector<uint32_t> binary;
+  std::string text;
+};
+
+// Records the throughput of a benchmark that processes |num_words| words per
+// iteration.
+void SetCounters(benchmark::State& state, size_t num_words) {
+  state.counters["words_per_second"] =
+      benchmark::Counter(static_cast<double>(num_words),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Records the throughput of a benchmark that processes |num_items| items other
+// than words per iteration, with the rate named |rate_name|.
+void SetItemCounters(benchmark::State& state, const std::string& rate_name,
+                     size_t num_items) {
+  state.counters[rate_name] =
+      benchmark::Counter(static_cast<double>(num_items),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Registers the benchmark |name| that runs |run|, recording the heap memory
+// used by each run, setup included.  peak_heap_kb is the most memory it held
+// at once, on top of what was allocated before, and allocations is the number
+// of allocations per iteration.
+template <typename Run>
+void RegisterBenchmark(const std::string& name, Run run) {
+  benchmark::RegisterBenchmark(name.c_str(), [run](benchmark::State& state) {
+    StartHeapMeasurement();
+    run(state);
+    state.counters["peak_heap_kb"] =
+        static_cast<double>(PeakHeapBytes()) / 1024;
+    state.counters["allocations"] =
+        benchmark::Counter(static_cast<double>(NumHeapAllocations()),
+                           benchmark::Counter::kAvgIterations);
+  });
+}
+
+spv_result_t CountInstruction(void* user_data,
+                              const spv_parsed_instruction_t*) {
+  ++*static_cast<size_t*>(user_data);
+  return SPV_SUCCESS;
+}
+
+// Returns the number of instructions of |module|.
+size_t CountInstructions(const Module& module) {
+  Context context(module.env);
+  size_t num_instructions = 0;
+  spvBinaryParse(context.CContext(), &num_instructions, module.binary.data(),
+                 module.binary.size(), nullptr, CountInstruction, nullptr);
+  return num_instructions;
+}
+
+void RegisterParse(std::shared_ptr<const Module> module) {
+  RegisterBenchmark(
+      ("parse/" + module->name).c_str(), [module](benchmark::State& state) {
+        Context context(module->env);
+        size_t num_instructions = 0;
+        for (auto _ : state) {
+          if (spvBinaryParse(context.CContext(), &num_instructions,
+                             module->binary.data(), module->binary.size(),
+                             nullptr, CountInstruction, nullptr)) {
+            state.SkipWithError("the module could not be parsed");
+            break;
+          }
+        }
+        benchmark::DoNotOptimize(num_instructions);
+        SetCounters(state, module->binary.size());
+      });
+}
+
+void RegisterAssemble(std::shared_ptr<const Module> module) {
+  RegisterBenchmark(
+      ("assemble/" + module->name).c_str(), [module](benchmark::State& state) {
+        SpirvTools tools(module->env);
+        std::vector<uint32_t> binary;
+        for (auto _ : state) {
+          if (!tools.Assemble(module->text, &binary)) {
+            state.SkipWithError("the module could not be assembled");
+            break;
+          }
+        }
+        SetCounters(state, module->binary.size());
+      });
+}
+
+void RegisterDisassemble(std::shared_ptr<const Module> module) {
+  RegisterBenchmark(
+      ("disassemble/" + module->name).c_str(),
+      [module](benchmark::State& state) {
+        SpirvTools tools(module->env);
+        std::string text;
+        for (auto _ : state) {
+          if (!tools.Disassemble(module->binary, &text)) {
+            state.SkipWithError("the module could not be disassembled");
+            break;
+          }
+        }
+        SetCounters(state, module->binary.size());
+      });
+}
+
+void RegisterValidate(std::shared_ptr<const Module> module) {
+  RegisterBenchmark(
+      ("validate/" + module->name).c_str(), [module](benchmark::State& state) {
+        SpirvTools tools(module->env);
+        for (auto _ : state) {
+          if (!tools.Validate(module->binary)) {
+            state.SkipWithError("the module is invalid");
+            break;
+          }
+        }
+        SetCounters(state, module->binary.size());
+        SetItemCounters(state, "instructions_per_second",
+                        CountInstructions(*module));
+      });
+}
+
+// Registers a benchmark of validating a function of selections nested
+// |depth| deep, whose dominance checks walk deep dominator trees.
+void RegisterValidateNested(uint32_t depth) {
+  auto module = std::make_shared<Module>();
+  module->name = "nested-selections-" + std::to_string(depth);
+  module->env = SPV_ENV_UNIVERSAL_1_3;
+  module->text = GenerateNestedSelectionsModule(depth);
+  SpirvTools tools(module->env);
+  if (!tools.Assemble(module->text, &module->binary)) {
+    std::cerr << "error: cannot assemble a nested selections module"
+              << std::endl;
+    return;
+  }
+  RegisterValidate(module);
+}
+
+// Registers a benchmark of validating a module with |num_buffers| buffer
+// variables of the same struct, whose layout is checked for each of them.
+void RegisterValidateBuffers(uint32_t num_buffers) {
+  auto module = std::make_shared<Module>();
+  module->name = "buffers-" + std::to_string(num_buffers);
+  module->env = SPV_ENV_UNIVERSAL_1_3;
+  module->text = GenerateBuffersModule(num_buffers);
+  SpirvTools tools(module->env);
+  if (!tools.Assemble(module->text, &module->binary)) {
+    std::cerr << "error: cannot assemble a buffers module" << std::endl;
+    return;
+  }
+  RegisterValidate(module);
+}
+
+// Registers a benchmark named |name| that runs the passes registered by
+// |flags| on |binary|.
+void RegisterOptimize(const std::string& name, spv_target_env env,
+                      const std::vector<std::string>& flags,
+                      std::shared_ptr<const std::vector<uint32_t>> binary) {
+  RegisterBenchmark(
+      name.c_str(), [env, flags, binary](benchmark::State& state) {
+        Optimizer optimizer(env);
+        optimizer.RegisterPassesFromFlags(flags);
+        OptimizerOptions options;
+        options.set_run_validator(false);
+        std::vector<uint32_t> optimized;
+        for (auto _ : state) {
+          optimized.clear();
+          if (!optimizer.Run(binary->data(), binary->size(), &optimized,
+                             options)) {
+            state.SkipWithError("the optimizer failed");
+            break;
+          }
+        }
+        SetCounters(state, binary->size());
+      });
+}
+
+// Registers benchmarks of the recipe registered by |recipe_flag| as a whole
+// and of each of its passes.  Each pass is run on the module as it is at that
+// point of the recipe.
+void RegisterRecipe(const std::string& recipe_flag,
+                    std::shared_ptr<const Module> module) {
+  auto binary = std::make_shared<const std::vector<uint32_t>>(module->binary);
+  const std::string recipe = recipe_flag.substr(1);
+  RegisterOptimize("opt/" + recipe + "/" + module->name, module->env,
+                   {recipe_flag}, binary);
+
+  Optimizer recipe_optimizer(module->env);
+  recipe_optimizer.RegisterPassesFromFlags({recipe_flag});
+  const std::vector<const char*> pass_names = recipe_optimizer.GetPassNames();
+  OptimizerOptions options;
+  options.set_run_validator(false);
+  for (size_t i = 0; i < pass_names.size(); ++i) {
+    // The passes are recreated from their names, which are the flags that
+    // register them, including any arguments.
+    const std::vector<std::string> flags = {std::string("--") +
+                                            pass_names[i]};
+    Optimizer optimizer(module->env);
+    char index[16];
+    snprintf(index, sizeof(index), "%02zu", i);
+    if (!optimizer.RegisterPassesFromFlags(flags)) {
+      std::cerr << "warning: cannot benchmark pass " << pass_names[i]
+                << " of " << recipe_flag << std::endl;
+      continue;
+    }
+    RegisterOptimize("opt/" + recipe + "/" + index + "-" + pass_names[i] +
+                         "/" + module->name,
+                     module->env, flags, binary);
+
+    auto optimized = std::make_shared<std::vector<uint32_t>>();
+    if (!optimizer.Run(binary->data(), binary->size(), optimized.get(),
+                       options)) {
+      std::cerr << "warning: pass " << pass_names[i] << " failed on "
+                << module->name << std::endl;
+      return;
+    }
+    binary = optimized;
+  }
+}
+
+// Registers a benchmark that links |num_modules| synthetic libraries of
+// |num_functions| functions each.
+void RegisterLink(uint32_t num_functions, uint32_t num_modules) {
+  auto binaries = std::make_shared<std::vector<std::vector<uint32_t>>>();
+  size_t num_words = 0;
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_3);
+  for (uint32_t i = 0; i < num_modules; ++i) {
+    SyntheticModuleOptions options;
+    options.num_functions = num_functions;
+    options.seed = i + 1;
+    options.export_prefix = "m" + std::to_string(i) + "_";
+    binaries->emplace_back();
+    if (!tools.Assemble(GenerateSyntheticModule(options), &binaries->back())) {
+      std::cerr << "error: cannot assemble a synthetic library" << std::endl;
+      return;
+    }
+    num_words += binaries->back().size();
+  }
+
+  RegisterBenchmark(
+      ("link/synthetic-" + std::to_string(num_functions) + "x" +
+       std::to_string(num_modules))
+          .c_str(),
+      [binaries, num_words](benchmark::State& state) {
+        Context context(SPV_ENV_UNIVERSAL_1_3);
+        LinkerOptions options;
+        options.SetCreateLibrary(true);
+        std::vector<uint32_t> linked;
+        for (auto _ : state) {
+          linked.clear();
+          if (Link(context, *binaries, &linked, options) != SPV_SUCCESS) {
+            state.SkipWithError("the modules could not be linked");
+            break;
+          }
+        }
+        SetCounters(state, num_words);
+      });
+}
+
+// Registers a benchmark of the remove-duplicates pass on a module that
+// declares |num_types| types twice each, to show how it scales.
+void RegisterRemoveDuplicates(uint32_t num_types) {
+  auto binary = std::make_shared<std::vector<uint32_t>>();
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_3);
+  if (!tools.Assemble(GenerateDuplicateTypesModule(num_types), binary.get())) {
+    std::cerr << "error: cannot assemble a duplicate types module" << std::endl;
+    return;
+  }
+  RegisterOptimize(
+      "opt/remove-duplicates/duplicate-types-" + std::to_string(num_types),
+      SPV_ENV_UNIVERSAL_1_3, {"--remove-duplicates"}, binary);
+}
+
+// Registers benchmarks of building the dominator tree of a function of
+// |num_selections| selections in sequence, of loading its dominator and
+// postdominator trees from an analysis snapshot, and of querying it.
+void RegisterDominators(uint32_t num_selections) {
+  std::shared_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_3, nullptr,
+                  GenerateManyBlocksModule(num_selections));
+  if (!context) {
+    std::cerr << "error: cannot build a many blocks module" << std::endl;
+    return;
+  }
+  opt::Function* function = &*context->module()->begin();
+  auto blocks = std::make_shared<std::vector<uint32_t>>();
+  for (const opt::BasicBlock& block : *function) {
+    blocks->push_back(block.id());
+  }
+  const std::string suffix = "/blocks-" + std::to_string(blocks->size());
+
+  RegisterBenchmark(
+      ("opt/dominators/build" + suffix).c_str(),
+      [context, function, blocks](benchmark::State& state) {
+        for (auto _ : state) {
+          opt::DominatorAnalysis analysis;
+          analysis.InitializeTree(*context->cfg(), function);
+          benchmark::DoNotOptimize(analysis.IsReachable(blocks->back()));
+        }
+        SetItemCounters(state, "blocks_per_second", blocks->size());
+      });
+
+  // Loading the snapshot installs both trees, so it is compared with
+  // building both.
+  RegisterBenchmark(
+      ("opt/dominators/build-both" + suffix).c_str(),
+      [context, function, blocks](benchmark::State& state) {
+        for (auto _ : state) {
+          opt::DominatorAnalysis dominators;
+          dominators.InitializeTree(*context->cfg(), function);
+          opt::PostDominatorAnalysis post_dominators;
+          post_dominators.InitializeTree(*context->cfg(), function);
+          benchmark::DoNotOptimize(post_dominators.IsReachable(blocks->back()));
+        }
+        SetItemCounters(state, "blocks_per_second", blocks->size());
+      });
+
+  auto binary = std::make_shared<std::vector<uint32_t>>();
+  auto snapshot = std::make_shared<std::vector<uint32_t>>();
+  context->module()->ToBinary(binary.get(), /* skip_nop = */ false);
+  opt::WriteAnalysisSnapshot(context.get(), *binary, snapshot.get());
+  RegisterBenchmark(
+      ("opt/dominators/load-snapshot" + suffix).c_str(),
+      [context, blocks, binary, snapshot](benchmark::State& state) {
+        for (auto _ : state) {
+          context->InvalidateAnalyses(
+              opt::IRContext::kAnalysisDominatorAnalysis);
+          if (!opt::LoadAnalysisSnapshot(context.get(), binary->data(),
+                                         binary->size(), snapshot->data(),
+                                         snapshot->size())) {
+            state.SkipWithError("the snapshot could not be loaded");
+            break;
+          }
+        }
+        SetItemCounters(state, "blocks_per_second", blocks->size());
+      });
+
+  RegisterBenchmark(
+      ("opt/dominators/dominates" + suffix).c_str(),
+      [context, function, blocks](benchmark::State& state) {
+        const opt::DominatorAnalysis* analysis =
+            context->GetDominatorAnalysis(function);
+        const size_t num_blocks = blocks->size();
+        size_t num_dominated = 0;
+        for (auto _ : state) {
+          for (size_t i = 0; i < num_blocks; ++i) {
+            num_dominated += analysis->Dominates(
+                (*blocks)[i], (*blocks)[(i * kQueryStride) % num_blocks]);
+          }
+          benchmark::DoNotOptimize(num_dominated);
+        }
+        SetItemCounters(state, "queries_per_second", num_blocks);
+      });
+
+  RegisterBenchmark(
+      ("opt/dominators/immediate-dominator" + suffix).c_str(),
+      [context, function, blocks](benchmark::State& state) {
+        const opt::DominatorAnalysis* analysis =
+            context->GetDominatorAnalysis(function);
+        for (auto _ : state) {
+          for (uint32_t id : *blocks) {
+            benchmark::DoNotOptimize(analysis->ImmediateDominator(id));
+          }
+        }
+        SetItemCounters(state, "queries_per_second", blocks->size());
+      });
+}
+
+// Registers benchmarks of looking up ids in the def-use manager, the type
+// manager and the CFG of a function of |num_selections| selections in
+// sequence.
+void RegisterLookups(uint32_t num_selections) {
+  std::shared_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_3, nullptr,
+                  GenerateManyBlocksModule(num_selections));
+  if (!context) {
+    std::cerr << "error: cannot build a many blocks module" << std::endl;
+    return;
+  }
+  auto ids = std::make_shared<std::vector<uint32_t>>();
+  context->module()->ForEachInst([&ids](opt::Instruction* inst) {
+    if (inst->result_id() != 0) ids->push_back(inst->result_id());
+  });
+  auto blocks = std::make_shared<std::vector<uint32_t>>();
+  for (const opt::BasicBlock& block : *context->module()->begin()) {
+    blocks->push_back(block.id());
+  }
+  for (std::vector<uint32_t>* queries : {ids.get(), blocks.get()}) {
+    std::vector<uint32_t> scattered(queries->size());
+    for (size_t i = 0; i < queries->size(); ++i) {
+      scattered[i] = (*queries)[(i * kQueryStride) % queries->size()];
+    }
+    queries->swap(scattered);
+  }
+  // Build the analyses up front so only the lookups are measured.
+  context->get_def_use_mgr();
+  context->get_type_mgr();
+  context->cfg();
+  const std::string ids_suffix = "/ids-" + std::to_string(ids->size());
+  const std::string blocks_suffix = "/blocks-" + std::to_string(blocks->size());
+
+  RegisterBenchmark(
+      ("opt/lookups/get-def" + ids_suffix).c_str(),
+      [context, ids](benchmark::State& state) {
+        opt::analysis::DefUseManager* def_use_mgr = context->get_def_use_mgr();
+        for (auto _ : state) {
+          for (uint32_t id : *ids) {
+            benchmark::DoNotOptimize(def_use_mgr->GetDef(id));
+          }
+        }
+        SetItemCounters(state, "queries_per_second", ids->size());
+      });
+
+  // Most result ids are not types, so this measures misses as much as hits,
+  // as passes that ask whether an id is a type do.
+  RegisterBenchmark(
+      ("opt/lookups/get-type" + ids_suffix).c_str(),
+      [context, ids](benchmark::State& state) {
+        const opt::analysis::TypeManager* type_mgr = context->get_type_mgr();
+        for (auto _ : state) {
+          for (uint32_t id : *ids) {
+            benchmark::DoNotOptimize(type_mgr->GetType(id));
+          }
+        }
+        SetItemCounters(state, "queries_per_second", ids->size());
+      });
+
+  RegisterBenchmark(
+      ("opt/lookups/cfg-block" + blocks_suffix).c_str(),
+      [context, blocks](benchmark::State& state) {
+        const opt::CFG* cfg = context->cfg();
+        for (auto _ : state) {
+          for (uint32_t id : *blocks) {
+            benchmark::DoNotOptimize(cfg->block(id));
+          }
+        }
+        SetItemCounters(state, "queries_per_second", blocks->size());
+      });
+}
+
+// Registers a benchmark of reading the in-operands of every instruction of
+// |module| once it is loaded into the optimizer's representation.  The
+// operand_bytes counter is the memory taken by the operands themselves.
+void RegisterOperands(std::shared_ptr<const Module> module) {
+  std::shared_ptr<opt::IRContext> context = BuildModule(
+      module->env, nullptr, module->binary.data(), module->binary.size());
+  if (!context) {
+    std::cerr << "error: cannot build module " << module->name << std::endl;
+    return;
+  }
+
+  RegisterBenchmark(
+      ("opt/operands/" + module->name).c_str(),
+      [context](benchmark::State& state) {
+        size_t num_operands = 0;
+        uint32_t sum = 0;
+        for (auto _ : state) {
+          num_operands = 0;
+          context->module()->ForEachInst(
+              [&num_operands, &sum](const opt::Instruction* inst) {
+                num_operands += inst->NumOperands();
+                inst->ForEachInId([&sum](const uint32_t* id) { sum += *id; });
+                for (uint32_t i = 0; i < inst->NumInOperands(); ++i) {
+                  for (uint32_t word : inst->GetInOperand(i).words) sum += word;
+                }
+              });
+          benchmark::DoNotOptimize(sum);
+        }
+        SetItemCounters(state, "operands_per_second", num_operands);
+        state.counters["operand_bytes"] =
+            static_cast<double>(num_operands * sizeof(opt::Operand));
+      });
+}
+
+// Registers benchmarks of loading |module| into the optimizer's
+// representation, with and without allocating it from an arena, and of
+// loading it followed by building the analyses most passes start from:
+// def-use, types, constants, decorations, the CFG and the dominator tree of
+// every function.  The difference between opt/load and opt/load-analyses is
+// the most that a snapshot of the analyses could save a tool that loads the
+// module.  The opt/dominators benchmarks show what the analysis snapshot
+// saves of it.  Each iteration loads the module and destroys it again, so
+// the peak_heap_kb and allocations of opt/load and opt/load-arena compare the
+// memory taken by a loaded module with and without the arena.
+void RegisterLoadAnalyses(std::shared_ptr<const Module> module) {
+  for (const bool use_arena : {false, true}) {
+    RegisterBenchmark(
+        ((use_arena ? "opt/load-arena/" : "opt/load/") + module->name).c_str(),
+        [module, use_arena](benchmark::State& state) {
+          for (auto _ : state) {
+            std::unique_ptr<opt::IRContext> context = BuildModule(
+                module->env, nullptr, module->binary.data(),
+                module->binary.size(), /* extra_line_tracking = */ true,
+                use_arena);
+            if (!context) {
+              state.SkipWithError("the module could not be loaded");
+              break;
+            }
+            benchmark::DoNotOptimize(context.get());
+          }
+          SetCounters(state, module->binary.size());
+        });
+  }
+
+  RegisterBenchmark(
+      ("opt/load-analyses/" + module->name).c_str(),
+      [module](benchmark::State& state) {
+        for (auto _ : state) {
+          std::unique_ptr<opt::IRContext> context =
+              BuildModule(module->env, nullptr, module->binary.data(),
+                          module->binary.size());
+          if (!context) {
+            state.SkipWithError("the module could not be loaded");
+            break;
+          }
+          context->BuildInvalidAnalyses(
+              opt::IRContext::kAnalysisDefUse | opt::IRContext::kAnalysisTypes |
+              opt::IRContext::kAnalysisConstants |
+              opt::IRContext::kAnalysisDecorations |
+              opt::IRContext::kAnalysisCFG);
+          for (opt::Function& function : *context->module()) {
+            benchmark::DoNotOptimize(context->GetDominatorAnalysis(&function));
+          }
+        }
+        SetCounters(state, module->binary.size());
+      });
+}
+
+void RegisterReduce(std::shared_ptr<const Module> module) {
+  RegisterBenchmark(
+      ("reduce/" + module->name).c_str(), [module](benchmark::State& state) {
+        ReducerOptions options;
+        options.set_step_limit(kReductionSteps);
+        ValidatorOptions validator_options;
+        std::vector<uint32_t> reduced;
+        for (auto _ : state) {
+          reduce::Reducer reducer(module->env);
+          reducer.SetInterestingnessFunction(
+              [](const std::vector<uint32_t>&, uint32_t) { return true; });
+          reducer.AddDefaultReductionPasses();
+          reduced.clear();
+          const auto status = reducer.Run(module->binary, &reduced, options,
+                                          validator_options);
+          if (status != reduce::Reducer::kReachedStepLimit &&
+              status != reduce::Reducer::kComplete) {
+            state.SkipWithError("the reducer failed");
+            break;
+          }
+        }
+        SetCounters(state, module->binary.size());
+      });
+}
+
+void RegisterModule(std::shared_ptr<const Module> module) {
+  RegisterParse(module);
+  RegisterAssemble(module);
+  RegisterDisassemble(module);
+  RegisterValidate(module);
+  RegisterOperands(module);
+  RegisterLoadAnalyses(module);
+  RegisterRecipe("-O", module);
+  RegisterRecipe("-Os", module);
+  RegisterReduce(module);
+}
+
+// Returns the synthetic module with |num_functions| functions, or null if it
+// cannot be assembled.
+std::shared_ptr<Module> MakeSyntheticModule(uint32_t num_functions) {
+  auto module = std::make_shared<Module>();
+  module->name = "synthetic-" + std::to_string(num_functions);
+  module->env = SPV_ENV_UNIVERSAL_1_3;
+  SyntheticModuleOptions options;
+  options.num_functions = num_functions;
+  module->text = GenerateSyntheticModule(options);
+  SpirvTools tools(module->env);
+  tools.SetMessageConsumer([](spv_message_level_t, const char*,
+                              const spv_position_t& position,
+                              const char* message) {
+    std::cerr << "error: synthetic module: line " << position.line << ": "
+              << message << std::endl;
+  });
+  if (!tools.Assemble(module->text, &module->binary) ||
+      !tools.Validate(module->binary)) {
+    return nullptr;
+  }
+  return module;
+}
+
+// Reads the module in the SPIR-V binary file named |file|.  Returns null if
+// it cannot be read or disassembled.
+std::shared_ptr<Module> ReadCorpusModule(const std::string& file) {
+  auto module = std::make_shared<Module>();
+  module->name = file;
+  // The newest environment accepts modules of every version.
+  module->env = SPV_ENV_UNIVERSAL_1_6;
+  std::ifstream input(file, std::ios::binary | std::ios::ate);
+  const std::streamoff size = input.tellg();
+  if (!input || size < 0 || size % sizeof(uint32_t) != 0) return nullptr;
+  module->binary.resize(static_cast<size_t>(size) / sizeof(uint32_t));
+  input.seekg(0);
+  if (!input.read(reinterpret_cast<char*>(module->binary.data()), size)) {
+    return nullptr;
+  }
+  SpirvTools tools(module->env);
+  if (!tools.Disassemble(module->binary, &module->text,
+                         SPV_BINARY_TO_TEXT_OPTION_NONE)) {
+    return nullptr;
+  }
+  return module;
+}
+
+// Registers the benchmarks of every module in the corpus listed in the file
+// named |list_file|.  Returns false if a module cannot be read.
+bool RegisterCorpus(const char* list_file) {
+  std::ifstream list(list_file);
+  if (!list) {
+    std::cerr << "error: could not open corpus list '" << list_file << "'"
+              << std::endl;
+    return false;
+  }
+  std::string line;
+  while (std::getline(list, line)) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.find_first_not_of(" \t") == std::string::npos) continue;
+    auto module = ReadCorpusModule(line);
+    if (!module) {
+      std::cerr << "error: could not read SPIR-V module '" << line << "'"
+                << std::endl;
+      return false;
+    }
+    RegisterModule(module);
+  }
+  return true;
+}
+
+}  // namespace
+}  // namespace bench
+}  // namespace spvtools
+
+int main(int argc, char** argv) {
+  // Take out the options of this program before Google Benchmark sees them.
+  const char* corpus = nullptr;
+  int num_args = 0;
+  for (int argi = 0; argi < argc; ++argi) {
+    if (0 == strncmp(argv[argi], "--corpus=", 9)) {
+      corpus = argv[argi] + 9;
+    } else {
+      argv[num_args++] = argv[argi];
+    }
+  }
+  argc = num_args;
+
+  for (uint32_t num_functions : spvtools::bench::kSyntheticSizes) {
+    auto module = spvtools::bench::MakeSyntheticModule(num_functions);
+    if (!module) return 1;
+    spvtools::bench::RegisterModule(module);
+    spvtools::bench::RegisterLink(num_functions,
+                                  spvtools::bench::kNumLinkedModules);
+  }
+  for (uint32_t num_types : spvtools::bench::kDuplicateTypesSizes) {
+    spvtools::bench::RegisterRemoveDuplicates(num_types);
+  }
+  for (uint32_t depth : spvtools::bench::kNestingDepths) {
+    spvtools::bench::RegisterValidateNested(depth);
+  }
+  for (uint32_t num_buffers : spvtools::bench::kBufferCounts) {
+    spvtools::bench::RegisterValidateBuffers(num_buffers);
+  }
+  for (uint32_t num_selections : spvtools::bench::kManyBlocksSizes) {
+    spvtools::bench::RegisterDominators(num_selections);
+    spvtools::bench::RegisterLookups(num_selections);
+  }
+  if (corpus && !spvtools::bench::RegisterCorpus(corpus)) return 1;
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/benchmarks/heap_usage.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// Each allocation starts with a header that holds its size, padded so that
+// the memory handed out keeps the alignment of malloc.
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+
+// These are plain atomics, so they are initialized before any allocation.
+std::atomic<size_t> live_bytes(0);
+std::atomic<size_t> baseline_bytes(0);
+std::atomic<size_t> peak_bytes(0);
+std::atomic<size_t> num_allocations(0);
+
+void* Allocate(size_t size) {
+  void* block = std::malloc(kHeaderSize + size);
+  if (block == nullptr) return nullptr;
+  *static_cast<size_t*>(block) = size;
+  const size_t live = live_bytes.fetch_add(size) + size;
+  size_t peak = peak_bytes.load();
+  while (live > peak && !peak_bytes.compare_exchange_weak(peak, live)) {
+  }
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  return static_cast<char*>(block) + kHeaderSize;
+}
+
+void Free(void* pointer) {
+  if (pointer == nullptr) return;
+  void* block = static_cast<char*>(pointer) - kHeaderSize;
+  live_bytes.fetch_sub(*static_cast<size_t*>(block));
+  std::free(block);
+}
+
+}  // namespace
+
+void StartHeapMeasurement() {
+  const size_t live = live_bytes.load();
+  baseline_bytes.store(live);
+  peak_bytes.store(live);
+  num_allocations.store(0);
+}
+
+size_t PeakHeapBytes() {
+  const size_t peak = peak_bytes.load();
+  const size_t baseline = baseline_bytes.load();
+  return peak > baseline ? peak - baseline : 0;
+}
+
+size_t NumHeapAllocations() { return num_allocations.load(); }
+
+}  // namespace bench
+}  // namespace spvtools
+
+// All the forms of operator new and operator delete but the aligned ones are
+// replaced, since not every standard library implements the others in terms
+// of the plain ones.
+void* operator new(size_t size) {
+  if (void* pointer = spvtools::bench::Allocate(size)) return pointer;
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return spvtools::bench::Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return spvtools::bench::Allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  spvtools::bench::Free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  spvtools::bench::Free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  spvtools::bench::Free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  spvtools::bench::Free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  spvtools::bench::Free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  spvtools::bench::Free(pointer);
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_BENCHMARKS_HEAP_USAGE_H_
+#define TEST_BENCHMARKS_HEAP_USAGE_H_
+
+#include <cstddef>
+
+namespace spvtools {
+namespace bench {
+
+// The benchmarks replace the global operator new and operator delete to keep
+// track of the memory they allocate.  Unlike the peak resident memory of the
+// process, this can be measured for each benchmark on its own.
+
+// Starts a new measurement: the bytes allocated and not freed yet are the
+// baseline of PeakHeapBytes.
+void StartHeapMeasurement();
+
+// Returns the largest number of bytes that were allocated and not freed at the
+// same time since the last call to StartHeapMeasurement, on top of those that
+// were live then.
+size_t PeakHeapBytes();
+
+// Returns the number of allocations made since the last call to
+// StartHeapMeasurement.
+size_t NumHeapAllocations();
+
+}  // namespace bench
+}  // namespace spvtools
+
+#endif  // TEST_BENCHMARKS_HEAP_USAGE_H_
@@ -0,0 +1,269 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "test/benchmarks/synthetic_module.h"
+
+#include <random>
+#include <sstream>
+
+namespace spvtools {
+namespace bench {
+namespace {
+
+// The number of integer constants, %int_0 to %int_<n - 1>, and of float
+// constants, %float_0 to %float_<n - 1>, declared by every module.
+const uint32_t kNumConstants = 10;
+
+// Returns a number less than |bound| taken from |random|.  Only the raw output
+// of the engine is specified by the standard, so the numbers are computed from
+// it directly rather than through a distribution.
+uint32_t Choose(std::mt19937* random, uint32_t bound) {
+  return static_cast<uint32_t>((*random)() % bound);
+}
+
+// Writes the definition of function |index|, which scales and offsets its
+// parameter in a loop.  The names of its ids all start with %f<index>_.
+void WriteFunction(uint32_t index, std::mt19937* random, std::ostream* out) {
+  const uint32_t trip_count = 2 + Choose(random, kNumConstants - 2);
+  const uint32_t scale = Choose(random, kNumConstants);
+  const uint32_t offset = Choose(random, kNumConstants);
+  const char* combine = Choose(random, 2) ? "OpFAdd" : "OpFSub";
+
+  const std::string f = "%f" + std::to_string(index) + "_";
+  *out << "%f" << index << " = OpFunction %float None %float_fn\n"
+       << f << "x = OpFunctionParameter %float\n"
+       << f << "entry = OpLabel\n"
+       << f << "acc = OpVariable %float_fptr Function\n"
+       << f << "i = OpVariable %int_fptr Function\n"
+       << "OpStore " << f << "acc " << f << "x\n"
+       << "OpStore " << f << "i %int_0\n"
+       << "OpBranch " << f << "header\n"
+       << f << "header = OpLabel\n"
+       << "OpLoopMerge " << f << "merge " << f << "continue None\n"
+       << "OpBranch " << f << "cond\n"
+       << f << "cond = OpLabel\n"
+       << f << "iv = OpLoad %int " << f << "i\n"
+       << f << "cmp = OpSLessThan %bool " << f << "iv %int_" << trip_count
+       << "\n"
+       << "OpBranchConditional " << f << "cmp " << f << "body " << f
+       << "merge\n"
+       << f << "body = OpLabel\n"
+       << f << "a = OpLoad %float " << f << "acc\n"
+       << f << "fi = OpConvertSToF %float " << f << "iv\n"
+       << f << "m = OpFMul %float " << f << "a %float_" << scale << "\n"
+       << f << "s = " << combine << " %float " << f << "m " << f << "fi\n"
+       << "OpStore " << f << "acc " << f << "s\n"
+       << f << "bit = OpBitwiseAnd %int " << f << "iv %int_1\n"
+       << f << "odd = OpIEqual %bool " << f << "bit %int_1\n"
+       << "OpSelectionMerge " << f << "join None\n"
+       << "OpBranchConditional " << f << "odd " << f << "then " << f
+       << "join\n"
+       << f << "then = OpLabel\n"
+       << f << "t = OpFAdd %float " << f << "s %float_" << offset << "\n"
+       << "OpStore " << f << "acc " << f << "t\n"
+       << "OpBranch " << f << "join\n"
+       << f << "join = OpLabel\n"
+       << "OpBranch " << f << "continue\n"
+       << f << "continue = OpLabel\n"
+       << f << "next = OpIAdd %int " << f << "iv %int_1\n"
+       << "OpStore " << f << "i " << f << "next\n"
+       << "OpBranch " << f << "header\n"
+       << f << "merge = OpLabel\n"
+       << f << "r = OpLoad %float " << f << "acc\n"
+       << "OpReturnValue " << f << "r\n"
+       << "OpFunctionEnd\n";
+}
+
+}  // namespace
+
+std::string GenerateSyntheticModule(const SyntheticModuleOptions& options) {
+  const bool is_library = !options.export_prefix.empty();
+  std::mt19937 random(options.seed);
+  std::ostringstream out;
+
+  out << "OpCapability Shader\n";
+  if (is_library) out << "OpCapability Linkage\n";
+  out << "OpMemoryModel Logical GLSL450\n";
+  if (!is_library) {
+    out << "OpEntryPoint GLCompute %main \"main\"\n"
+        << "OpExecutionMode %main LocalSize 1 1 1\n"
+        << "OpName %main \"main\"\n";
+  }
+  for (uint32_t i = 0; i < options.num_functions; ++i) {
+    out << "OpName %f" << i << " \"f" << i << "\"\n";
+  }
+  if (is_library) {
+    for (uint32_t i = 0; i < options.num_functions; ++i) {
+      out << "OpDecorate %f" << i << " LinkageAttributes \""
+          << options.export_prefix << "f" << i << "\" Export\n";
+    }
+  }
+
+  out << "%void = OpTypeVoid\n"
+      << "%bool = OpTypeBool\n"
+      << "%int = OpTypeInt 32 1\n"
+      << "%float = OpTypeFloat 32\n"
+      << "%void_fn = OpTypeFunction %void\n"
+      << "%float_fn = OpTypeFunction %float %float\n"
+      << "%int_fptr = OpTypePointer Function %int\n"
+      << "%float_fptr = OpTypePointer Function %float\n"
+      << "%float_pptr = OpTypePointer Private %float\n";
+  for (uint32_t i = 0; i < kNumConstants; ++i) {
+    out << "%int_" << i << " = OpConstant %int " << i << "\n";
+  }
+  for (uint32_t i = 0; i < kNumConstants; ++i) {
+    out << "%float_" << i << " = OpConstant %float " << 0.25 * (i + 1) << "\n";
+  }
+  if (!is_library) out << "%g = OpVariable %float_pptr Private\n";
+
+  for (uint32_t i = 0; i < options.num_functions; ++i) {
+    WriteFunction(i, &random, &out);
+  }
+
+  // The entry point passes a value through every function.
+  if (!is_library) {
+    out << "%main = OpFunction %void None %void_fn\n"
+        << "%main_entry = OpLabel\n"
+        << "%main_v0 = OpLoad %float %g\n";
+    for (uint32_t i = 0; i < options.num_functions; ++i) {
+      out << "%main_v" << i + 1 << " = OpFunctionCall %float %f" << i
+          << " %main_v" << i << "\n";
+    }
+    out << "OpStore %g %main_v" << options.num_functions << "\n"
+        << "OpReturn\n"
+        << "OpFunctionEnd\n";
+  }
+  return out.str();
+}
+
+std::string GenerateDuplicateTypesModule(uint32_t num_types) {
+  std::ostringstream out;
+  out << "OpCapability Shader\n"
+      << "OpCapability Linkage\n"
+      << "OpMemoryModel Logical GLSL450\n";
+  for (uint32_t i = 0; i < num_types; ++i) {
+    out << "OpDecorate %a" << i << " ArrayStride 4\n"
+        << "OpDecorate %b" << i << " ArrayStride 4\n";
+  }
+  out << "%uint = OpTypeInt 32 0\n";
+  for (uint32_t i = 0; i < num_types; ++i) {
+    out << "%n" << i << " = OpConstant %uint " << i + 1 << "\n"
+        << "%a" << i << " = OpTypeArray %uint %n" << i << "\n"
+        << "%b" << i << " = OpTypeArray %uint %n" << i << "\n";
+  }
+  return out.str();
+}
+
+std::string GenerateManyBlocksModule(uint32_t num_selections) {
+  std::ostringstream out;
+  out << "OpCapability Shader\n"
+      << "OpMemoryModel Logical GLSL450\n"
+      << "OpEntryPoint GLCompute %main \"main\"\n"
+      << "OpExecutionMode %main LocalSize 1 1 1\n"
+      << "%void = OpTypeVoid\n"
+      << "%bool = OpTypeBool\n"
+      << "%true = OpConstantTrue %bool\n"
+      << "%void_fn = OpTypeFunction %void\n"
+      << "%main = OpFunction %void None %void_fn\n";
+  for (uint32_t i = 0; i < num_selections; ++i) {
+    out << "%h" << i << " = OpLabel\n"
+        << "OpSelectionMerge %h" << i + 1 << " None\n"
+        << "OpBranchConditional %true %t" << i << " %e" << i << "\n"
+        << "%t" << i << " = OpLabel\n"
+        << "OpBranch %h" << i + 1 << "\n"
+        << "%e" << i << " = OpLabel\n"
+        << "OpBranch %h" << i + 1 << "\n";
+  }
+  out << "%h" << num_selections << " = OpLabel\n"
+      << "OpReturn\n"
+      << "OpFunctionEnd\n";
+  return out.str();
+}
+
+std::string GenerateNestedSelectionsModule(uint32_t depth) {
+  std::ostringstream out;
+  out << "OpCapability Shader\n"
+      << "OpMemoryModel Logical GLSL450\n"
+      << "OpEntryPoint GLCompute %main \"main\"\n"
+      << "OpExecutionMode %main LocalSize 1 1 1\n"
+      << "%void = OpTypeVoid\n"
+      << "%bool = OpTypeBool\n"
+      << "%uint = OpTypeInt 32 0\n"
+      << "%true = OpConstantTrue %bool\n"
+      << "%one = OpConstant %uint 1\n"
+      << "%void_fn = OpTypeFunction %void\n"
+      << "%main = OpFunction %void None %void_fn\n"
+      << "%h0 = OpLabel\n"
+      << "%x0 = OpCopyObject %uint %one\n";
+  for (uint32_t i = 0; i < depth; ++i) {
+    if (i > 0) out << "%h" << i << " = OpLabel\n";
+    out << "%x" << i + 1 << " = OpIAdd %uint %x" << i << " %x0\n"
+        << "OpSelectionMerge %m" << i << " None\n"
+        << "OpBranchConditional %true %h" << i + 1 << " %m" << i << "\n";
+  }
+  out << "%h" << depth << " = OpLabel\n";
+  for (uint32_t i = depth; i > 0; --i) {
+    out << "OpBranch %m" << i - 1 << "\n"
+        << "%m" << i - 1 << " = OpLabel\n";
+  }
+  out << "OpReturn\n"
+      << "OpFunctionEnd\n";
+  return out.str();
+}
+
+std::string GenerateBuffersModule(uint32_t num_buffers) {
+  std::ostringstream out;
+  out << "OpCapability Shader\n"
+      << "OpMemoryModel Logical GLSL450\n"
+      << "OpEntryPoint GLCompute %main \"main\"\n"
+      << "OpExecutionMode %main LocalSize 1 1 1\n"
+      << "OpMemberDecorate %inner 0 Offset 0\n"
+      << "OpMemberDecorate %inner 1 Offset 16\n"
+      << "OpMemberDecorate %inner 1 ColMajor\n"
+      << "OpMemberDecorate %inner 1 MatrixStride 16\n"
+      << "OpDecorate %inner_array ArrayStride 80\n"
+      << "OpDecorate %block Block\n"
+      << "OpMemberDecorate %block 0 Offset 0\n"
+      << "OpMemberDecorate %block 1 Offset 16\n"
+      << "OpMemberDecorate %block 2 Offset 32\n";
+  for (uint32_t i = 0; i < num_buffers; ++i) {
+    out << "OpDecorate %buffer" << i << " DescriptorSet 0\n"
+        << "OpDecorate %buffer" << i << " Binding " << i << "\n";
+  }
+  out << "%void = OpTypeVoid\n"
+      << "%float = OpTypeFloat 32\n"
+      << "%v4float = OpTypeVector %float 4\n"
+      << "%mat4 = OpTypeMatrix %v4float 4\n"
+      << "%uint = OpTypeInt 32 0\n"
+      << "%uint_8 = OpConstant %uint 8\n"
+      << "%inner = OpTypeStruct %v4float %mat4\n"
+      << "%inner_array = OpTypeArray %inner %uint_8\n"
+      << "%block = OpTypeStruct %float %v4float %inner_array\n"
+      << "%ptr_Uniform = OpTypePointer Uniform %block\n"
+      << "%ptr_StorageBuffer = OpTypePointer StorageBuffer %block\n";
+  for (uint32_t i = 0; i < num_buffers; ++i) {
+    const char* storage_class = i % 2 ? "StorageBuffer" : "Uniform";
+    out << "%buffer" << i << " = OpVariable %ptr_" << storage_class << " "
+        << storage_class << "\n";
+  }
+  out << "%void_fn = OpTypeFunction %void\n"
+      << "%main = OpFunction %void None %void_fn\n"
+      << "%entry = OpLabel\n"
+      << "OpReturn\n"
+      << "OpFunctionEnd\n";
+  return out.str();
+}
+
+}  // namespace bench
+}  // namespace spvtools
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TEST_BENCHMARKS_SYNTHETIC_MODULE_H_
+#define TEST_BENCHMARKS_SYNTHETIC_MODULE_H_
+
+#include <cstdint>
+#include <string>
+
+namespace spvtools {
+namespace bench {
+
+// Describes a synthetic module.
+struct SyntheticModuleOptions {
+  // The number of functions besides the entry point.  Each has a loop
+  // containing a selection, and works on function-scope variables, so the
+  // optimization passes have something to do.
+  uint32_t num_functions = 16;
+
+  // Seeds the choice of the constants and arithmetic in the functions.  The
+  // same options always give the same module, on every platform.
+  uint32_t seed = 1;
+
+  // If not empty, the module is a library: instead of being called from an
+  // entry point, the functions are exported, with names that start with this
+  // prefix.
+  std::string export_prefix;
+};
+
+// Returns the assembly text of a valid shader module described by |options|,
+// for SPV_ENV_UNIVERSAL_1_3 and later.
+std::string GenerateSyntheticModule(const SyntheticModuleOptions& options);
+
+// Returns the assembly text of a valid library module that declares
+// |num_types| distinct decorated array types twice each, as linking modules
+// that share types does, for SPV_ENV_UNIVERSAL_1_3 and later.
+std::string GenerateDuplicateTypesModule(uint32_t num_types);
+
+// Returns the assembly text of a valid shader module whose entry point is a
+// sequence of |num_selections| if-then-else selections, each merging into the
+// header of the next, so it has 3 * |num_selections| + 1 blocks and a
+// dominator tree as deep as the number of selections.  It is for
+// SPV_ENV_UNIVERSAL_1_3 and later.
+std::string GenerateManyBlocksModule(uint32_t num_selections);
+
+// Returns the assembly text of a valid shader module whose entry point is
+// |depth| if-then selections, each nested in the then branch of the previous
+// one, so its dominator trees are |depth| blocks deep.  Each header uses a
+// value defined in the outermost header.  It is for SPV_ENV_UNIVERSAL_1_3 and
+// later.
+std::string GenerateNestedSelectionsModule(uint32_t depth);
+
+// Returns the assembly text of a valid shader module that declares
+// |num_buffers| buffer variables, alternately in the Uniform and
+// StorageBuffer storage classes, all of the same Block struct.  The struct
+// holds an array of structs with a matrix each, so checking its layout has
+// some work to do.  It is for SPV_ENV_UNIVERSAL_1_3 and later.
+std::string GenerateBuffersModule(uint32_t num_buffers);
+
+}  // namespace bench
+}  // namespace spvtools
+
+#endif  // TEST_BENCHMARKS_SYNTHETIC_MODULE_H_
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -256,6 +257,24 @@ TEST_F(BinaryParseTest, NullDiagnosticsIsOkForBadParse) {
                      words.size(), invoke_header, invoke_instruction, nullptr));
 }
 
+TEST_F(BinaryParseTest, MisalignedModuleIsRejected) {
+  const auto words = CompileSuccessfully("");
+  const size_t num_bytes = words.size() * sizeof(uint32_t);
+  std::vector<uint32_t> storage(words.size() + 1);
+  char* misaligned = reinterpret_cast<char*>(storage.data()) + 1;
+  memcpy(misaligned, words.data(), num_bytes);
+  EXPECT_HEADER(1).Times(0);
+  EXPECT_CALL(client_, Instruction(_)).Times(0);
+  EXPECT_EQ(SPV_ERROR_INVALID_POINTER,
+            spvBinaryParse(ScopedContext().context, &client_,
+                           reinterpret_cast<const uint32_t*>(misaligned),
+                           words.size(), invoke_header, invoke_instruction,
+                           &diagnostic_));
+  ASSERT_NE(nullptr, diagnostic_);
+  EXPECT_THAT(diagnostic_->error,
+              Eq("Module is not aligned to a word boundary."));
+}
+
 // Make sure that we don't blow up when both the consumer and the diagnostic are
 // null.
 TEST_F(BinaryParseTest, NullConsumerNullDiagnosticsForBadParse) {
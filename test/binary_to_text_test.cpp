@@ -112,6 +112,78 @@ TEST_F(BinaryToText, Print) {
   spvTextDestroy(text);
 }
 
+// Appends the text passed to it to the std::vector<std::string> at
+// |user_data|, one element per call.
+spv_result_t AppendChunk(void* user_data, const char* text, size_t length) {
+  static_cast<std::vector<std::string>*>(user_data)->emplace_back(text, length);
+  return SPV_SUCCESS;
+}
+
+TEST_F(BinaryToText, StreamMatchesText) {
+  spv_text text = nullptr;
+  ASSERT_EQ(SPV_SUCCESS, spvBinaryToText(context, binary->code,
+                                         binary->wordCount,
+                                         SPV_BINARY_TO_TEXT_OPTION_NONE, &text,
+                                         nullptr));
+  std::vector<std::string> chunks;
+  // The print option is ignored.
+  EXPECT_EQ(SPV_SUCCESS,
+            spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_PRINT, AppendChunk,
+                                  &chunks, nullptr));
+  std::string streamed;
+  for (const std::string& chunk : chunks) streamed += chunk;
+  EXPECT_EQ(std::string(text->str, text->length), streamed);
+  spvTextDestroy(text);
+}
+
+TEST_F(BinaryToText, StreamLargeModuleInChunksOfLines) {
+  std::string input;
+  for (int i = 0; i < 2000; ++i) {
+    input += "OpSourceExtension \"extension " + std::to_string(i) + "\"\n";
+  }
+  CompileSuccessfully(input);
+
+  std::vector<std::string> chunks;
+  ASSERT_EQ(SPV_SUCCESS,
+            spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, AppendChunk,
+                                  &chunks, nullptr));
+  EXPECT_GT(chunks.size(), 1u);
+  std::string streamed;
+  for (const std::string& chunk : chunks) {
+    ASSERT_FALSE(chunk.empty());
+    EXPECT_EQ('\n', chunk.back());
+    streamed += chunk;
+  }
+  EXPECT_THAT(streamed, HasSubstr("OpSourceExtension \"extension 0\"\n"));
+  EXPECT_THAT(streamed, HasSubstr("OpSourceExtension \"extension 1999\"\n"));
+}
+
+TEST_F(BinaryToText, StreamStopsWhenSinkFails) {
+  std::string input;
+  for (int i = 0; i < 2000; ++i) input += "OpSourceExtension \"extension\"\n";
+  CompileSuccessfully(input);
+
+  int calls = 0;
+  auto fail = [](void* user_data, const char*, size_t) {
+    ++*static_cast<int*>(user_data);
+    return SPV_ERROR_INTERNAL;
+  };
+  EXPECT_EQ(SPV_ERROR_INTERNAL,
+            spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, fail, &calls,
+                                  nullptr));
+  EXPECT_EQ(1, calls);
+}
+
+TEST_F(BinaryToText, StreamRequiresSink) {
+  EXPECT_EQ(SPV_ERROR_INVALID_POINTER,
+            spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, nullptr,
+                                  nullptr, nullptr));
+}
+
 TEST_F(BinaryToText, MissingModule) {
   spv_text text;
   spv_diagnostic diagnostic = nullptr;
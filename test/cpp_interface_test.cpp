@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -141,6 +142,11 @@ TEST(CppInterface, DisassembleOverloads) {
     EXPECT_TRUE(t.Disassemble(binary.data(), binary.size(), &output_text));
     EXPECT_EQ(input_text, output_text);
   }
+  {
+    std::ostringstream output_stream;
+    EXPECT_TRUE(t.Disassemble(binary.data(), binary.size(), &output_stream));
+    EXPECT_EQ(input_text, output_stream.str());
+  }
 }
 
 TEST(CppInterface, SuccessfulValidation) {
@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
+
 #include "gmock/gmock.h"
+#include "source/spirv_target_env.h"
 #include "test/unit_spirv.h"
 
 namespace spvtools {
@@ -32,6 +35,54 @@ TEST_P(GetTargetOpcodeTableGetTest, InvalidPointerTable) {
   ASSERT_EQ(SPV_ERROR_INVALID_POINTER, spvOpcodeTableGet(nullptr, GetParam()));
 }
 
+TEST_P(GetTargetOpcodeTableGetTest, NameIndexIsSorted) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table, GetParam()));
+  ASSERT_NE(nullptr, table->nameIndex);
+  for (uint32_t i = 1; i < table->count; ++i) {
+    EXPECT_LE(strcmp(table->entries[table->nameIndex[i - 1]].name,
+                     table->entries[table->nameIndex[i]].name),
+              0);
+  }
+}
+
+TEST_P(GetTargetOpcodeTableGetTest, NameLookupFindsEachOpcode) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table, GetParam()));
+  const uint32_t version = spvVersionForTargetEnv(GetParam());
+  for (uint32_t i = 0; i < table->count; ++i) {
+    const spv_opcode_desc_t& entry = table->entries[i];
+    spv_opcode_desc found = nullptr;
+    const spv_result_t result =
+        spvOpcodeTableNameLookup(GetParam(), table, entry.name, &found);
+    if ((version >= entry.minVersion && version <= entry.lastVersion) ||
+        entry.numExtensions > 0u || entry.numCapabilities > 0u) {
+      ASSERT_EQ(SPV_SUCCESS, result) << entry.name;
+      EXPECT_STREQ(entry.name, found->name);
+    } else if (result == SPV_SUCCESS) {
+      // Another entry with the same name is available.
+      EXPECT_STREQ(entry.name, found->name);
+    }
+  }
+}
+
+TEST_P(GetTargetOpcodeTableGetTest, NameLookupRejectsPrefixAndUnknownNames) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table, GetParam()));
+  spv_opcode_desc found = nullptr;
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(GetParam(), table, "Loa", &found));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(GetParam(), table, "Loads", &found));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(GetParam(), table, "", &found));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(GetParam(), table, "~", &found));
+  EXPECT_EQ(SPV_SUCCESS,
+            spvOpcodeTableNameLookup(GetParam(), table, "Load", &found));
+  EXPECT_EQ(SpvOpLoad, found->opcode);
+}
+
 INSTANTIATE_TEST_SUITE_P(OpcodeTableGet, GetTargetOpcodeTableGetTest,
                          ValuesIn(spvtest::AllTargetEnvironments()));
 
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
 #include <vector>
 
 #include "test/unit_spirv.h"
@@ -38,6 +39,48 @@ INSTANTIATE_TEST_SUITE_P(OperandTableGet, GetTargetTest,
                              SPV_ENV_UNIVERSAL_1_0, SPV_ENV_UNIVERSAL_1_1,
                              SPV_ENV_VULKAN_1_0}));
 
+TEST(OperandTableNameLookup, FindsEachEntry) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table, SPV_ENV_UNIVERSAL_1_6));
+  for (uint32_t typeIndex = 0; typeIndex < table->count; ++typeIndex) {
+    const auto& group = table->types[typeIndex];
+    ASSERT_NE(nullptr, group.nameIndex);
+    for (uint32_t index = 0; index < group.count; ++index) {
+      const auto& entry = group.entries[index];
+      spv_operand_desc found = nullptr;
+      const spv_result_t result =
+          spvOperandTableNameLookup(SPV_ENV_UNIVERSAL_1_6, table, group.type,
+                                    entry.name, strlen(entry.name), &found);
+      if (result == SPV_SUCCESS) {
+        EXPECT_STREQ(entry.name, found->name);
+      } else {
+        EXPECT_EQ(SPV_ERROR_WRONG_VERSION, result) << entry.name;
+      }
+    }
+  }
+}
+
+TEST(OperandTableNameLookup, UsesOnlyTheGivenLength) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table, SPV_ENV_UNIVERSAL_1_0));
+  spv_operand_desc found = nullptr;
+  // The name need not be null-terminated.
+  EXPECT_EQ(SPV_SUCCESS,
+            spvOperandTableNameLookup(SPV_ENV_UNIVERSAL_1_0, table,
+                                      SPV_OPERAND_TYPE_CAPABILITY, "Shader|",
+                                      6, &found));
+  EXPECT_EQ(uint32_t(SpvCapabilityShader), found->value);
+  // A prefix of a name is not a match.
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableNameLookup(SPV_ENV_UNIVERSAL_1_0, table,
+                                      SPV_OPERAND_TYPE_CAPABILITY, "Shader", 5,
+                                      &found));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableNameLookup(SPV_ENV_UNIVERSAL_1_0, table,
+                                      SPV_OPERAND_TYPE_CAPABILITY, "", 0,
+                                      &found));
+}
+
 TEST(OperandString, AllAreDefinedExceptVariable) {
   // None has no string, so don't test it.
   EXPECT_EQ(0u, SPV_OPERAND_TYPE_NONE);
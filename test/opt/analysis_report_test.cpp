@@ -0,0 +1,192 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/analysis_report.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "source/opt/build_module.h"
+#include "source/opt/pass_manager.h"
+#include "source/util/string_utils.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+using ::testing::ContainsRegex;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+const std::string kNamedFunction = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpName %3 "main"
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%3 = OpFunction %1 None %2
+%4 = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+// Returns the OpName instruction of |context|.
+Instruction* GetName(IRContext* context) {
+  return &*context->module()->debugs2().begin();
+}
+
+// A pass that changes the string of the OpName, in place.
+class RenamePass : public Pass {
+ public:
+  const char* name() const override { return "rename"; }
+  Status Process() override {
+    GetName(context())->SetInOperand(1, utils::MakeVector("renamed"));
+    return Status::SuccessWithChange;
+  }
+};
+
+// A pass that removes the OpName.
+class KillNamePass : public Pass {
+ public:
+  const char* name() const override { return "kill-name"; }
+  Status Process() override {
+    context()->KillInst(GetName(context()));
+    return Status::SuccessWithChange;
+  }
+};
+
+// A pass that builds the def-use manager and changes nothing.
+class BuildDefUsePass : public Pass {
+ public:
+  const char* name() const override { return "build-def-use"; }
+  Status Process() override {
+    context()->get_def_use_mgr();
+    return Status::SuccessWithoutChange;
+  }
+};
+
+std::unique_ptr<IRContext> BuildNamedFunction() {
+  return BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, kNamedFunction,
+                     SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+}
+
+std::vector<std::string> UnchangedAnalysisNames(IRContext* context,
+                                                Pass* pass) {
+  PreservedAnalysesAudit audit(context, pass);
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass->Run(context));
+  std::vector<std::string> names;
+  for (IRContext::Analysis analysis : audit.UnchangedAnalyses()) {
+    names.push_back(IRContext::GetAnalysisName(analysis));
+  }
+  return names;
+}
+
+TEST(AnalysisReportTest, BuildsAreChargedToTheInvalidatingPass) {
+  AnalysisAccounting accounting;
+  accounting.SetCurrentPass("first");
+  accounting.OnAnalysisBuilt(IRContext::kAnalysisDefUse, 0.5);
+  accounting.OnAnalysisInvalidated(IRContext::kAnalysisDefUse);
+  accounting.SetCurrentPass("second");
+  accounting.OnAnalysisBuilt(IRContext::kAnalysisDefUse, 2);
+  accounting.OnAnalysisBuilt(IRContext::kAnalysisCFG, 0.25);
+  accounting.OnAnalysisInvalidated(IRContext::kAnalysisDefUse);
+  accounting.OnAnalysisBuilt(IRContext::kAnalysisDefUse, 1);
+
+  std::ostringstream report;
+  accounting.Report(&report);
+  std::vector<std::string> lines;
+  std::istringstream stream(report.str());
+  for (std::string line; std::getline(stream, line);) lines.push_back(line);
+
+  ASSERT_EQ(6u, lines.size());
+  EXPECT_THAT(lines[2], ContainsRegex("^first +def-use +1 +2.000000$"));
+  EXPECT_THAT(lines[3], ContainsRegex("^second +def-use +1 +1.000000$"));
+  EXPECT_THAT(lines[4], ContainsRegex("^\\(first build\\) +def-use +1"));
+  EXPECT_THAT(lines[5], ContainsRegex("^\\(first build\\) +cfg +1"));
+}
+
+TEST(AnalysisReportTest, ContextReportsBuildsAndInvalidations) {
+  std::unique_ptr<IRContext> context = BuildNamedFunction();
+  ASSERT_NE(nullptr, context);
+  AnalysisAccounting accounting;
+  context->SetAnalysisListener(&accounting);
+
+  accounting.SetCurrentPass("invalidator");
+  context->get_def_use_mgr();
+  context->InvalidateAnalyses(IRContext::kAnalysisDefUse);
+  context->get_def_use_mgr();
+  context->SetAnalysisListener(nullptr);
+
+  std::ostringstream report;
+  accounting.Report(&report);
+  EXPECT_THAT(report.str(), ContainsRegex("\ninvalidator +def-use +1 "));
+  EXPECT_THAT(report.str(), ContainsRegex("\n\\(first build\\) +def-use +1 "));
+}
+
+TEST(AnalysisReportTest, PassManagerPrintsReport) {
+  std::unique_ptr<IRContext> context = BuildNamedFunction();
+  ASSERT_NE(nullptr, context);
+  std::ostringstream report;
+  PassManager manager;
+  manager.SetAnalysisReport(&report);
+  manager.AddPass<BuildDefUsePass>();
+  manager.AddPass<RenamePass>();
+  manager.AddPass<BuildDefUsePass>();
+  manager.Run(context.get());
+
+  EXPECT_THAT(report.str(), ContainsRegex("\nrename +def-use +1 "));
+}
+
+TEST(AnalysisReportTest, AuditFindsUnchangedAnalyses) {
+  std::unique_ptr<IRContext> context = BuildNamedFunction();
+  ASSERT_NE(nullptr, context);
+  RenamePass pass;
+  EXPECT_THAT(UnchangedAnalysisNames(context.get(), &pass),
+              ElementsAre("def-use", "instr-to-block", "decorations", "cfg",
+                          "dominators", "names", "id-to-function"));
+}
+
+TEST(AnalysisReportTest, AuditSkipsChangedAnalyses) {
+  std::unique_ptr<IRContext> context = BuildNamedFunction();
+  ASSERT_NE(nullptr, context);
+  KillNamePass pass;
+  EXPECT_THAT(UnchangedAnalysisNames(context.get(), &pass),
+              ElementsAre("instr-to-block", "decorations", "cfg", "dominators",
+                          "id-to-function"));
+}
+
+TEST(AnalysisReportTest, PassManagerPrintsAuditFindings) {
+  std::unique_ptr<IRContext> context = BuildNamedFunction();
+  ASSERT_NE(nullptr, context);
+  std::ostringstream findings;
+  PassManager manager;
+  manager.SetPreservedAnalysesAudit(&findings);
+  manager.AddPass<KillNamePass>();
+  manager.Run(context.get());
+
+  EXPECT_THAT(findings.str(),
+              HasSubstr("kill-name: the cfg analysis is unchanged and could "
+                        "be preserved\n"));
+  EXPECT_THAT(findings.str(), Not(HasSubstr("the names analysis")));
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
@@ -0,0 +1,155 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/analysis_snapshot.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "source/opt/build_module.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+// A function whose entry branches to %7 or %8, which both branch to %9.
+const std::string kDiamond = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%3 = OpTypeBool
+%4 = OpConstantTrue %3
+%5 = OpFunction %1 None %2
+%6 = OpLabel
+OpSelectionMerge %9 None
+OpBranchConditional %4 %7 %8
+%7 = OpLabel
+OpBranch %9
+%8 = OpLabel
+OpBranch %9
+%9 = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+class AnalysisSnapshotTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::unique_ptr<IRContext> context =
+        BuildModule(SPV_ENV_UNIVERSAL_1_3, nullptr, kDiamond,
+                    SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+    ASSERT_NE(nullptr, context);
+    context->module()->ToBinary(&binary_, /* skip_nop = */ false);
+    WriteAnalysisSnapshot(context.get(), binary_, &snapshot_);
+  }
+
+  // Returns a new context for the module.
+  std::unique_ptr<IRContext> Load() {
+    return BuildModule(SPV_ENV_UNIVERSAL_1_3, nullptr, binary_.data(),
+                       binary_.size());
+  }
+
+  std::vector<uint32_t> binary_;
+  std::vector<uint32_t> snapshot_;
+};
+
+TEST_F(AnalysisSnapshotTest, LoadsTheSameTrees) {
+  std::unique_ptr<IRContext> computed = Load();
+  std::unique_ptr<IRContext> loaded = Load();
+  ASSERT_TRUE(LoadAnalysisSnapshot(loaded.get(), binary_.data(),
+                                   binary_.size(), snapshot_.data(),
+                                   snapshot_.size()));
+
+  const Function* computed_function = &*computed->module()->begin();
+  const Function* loaded_function = &*loaded->module()->begin();
+  EXPECT_EQ(computed->GetDominatorAnalysis(computed_function)
+                ->GetDomTree()
+                .GetEdges(),
+            loaded->GetDominatorAnalysis(loaded_function)
+                ->GetDomTree()
+                .GetEdges());
+  EXPECT_EQ(computed->GetPostDominatorAnalysis(computed_function)
+                ->GetDomTree()
+                .GetEdges(),
+            loaded->GetPostDominatorAnalysis(loaded_function)
+                ->GetDomTree()
+                .GetEdges());
+
+  DominatorAnalysis* dominators = loaded->GetDominatorAnalysis(loaded_function);
+  EXPECT_TRUE(dominators->StrictlyDominates(6, 9));
+  EXPECT_FALSE(dominators->Dominates(7, 9));
+  EXPECT_EQ(6u, dominators->ImmediateDominator(9)->id());
+  PostDominatorAnalysis* post_dominators =
+      loaded->GetPostDominatorAnalysis(loaded_function);
+  EXPECT_TRUE(post_dominators->StrictlyDominates(9, 6));
+}
+
+TEST_F(AnalysisSnapshotTest, RejectsAnotherModule) {
+  std::unique_ptr<IRContext> context = Load();
+  std::vector<uint32_t> other = binary_;
+  other.push_back(0);
+  EXPECT_FALSE(LoadAnalysisSnapshot(context.get(), other.data(), other.size(),
+                                    snapshot_.data(), snapshot_.size()));
+  other.pop_back();
+  other.back() ^= 1;
+  EXPECT_FALSE(LoadAnalysisSnapshot(context.get(), other.data(), other.size(),
+                                    snapshot_.data(), snapshot_.size()));
+}
+
+TEST_F(AnalysisSnapshotTest, RejectsATruncatedSnapshot) {
+  std::unique_ptr<IRContext> context = Load();
+  for (size_t size = 0; size < snapshot_.size(); ++size) {
+    EXPECT_FALSE(LoadAnalysisSnapshot(context.get(), binary_.data(),
+                                      binary_.size(), snapshot_.data(), size))
+        << size;
+    EXPECT_FALSE(
+        context->AreAnalysesValid(IRContext::kAnalysisDominatorAnalysis));
+  }
+}
+
+TEST_F(AnalysisSnapshotTest, InstallsTreesWithoutComputingThem) {
+  std::unique_ptr<IRContext> context = Load();
+  const Function* function = &*context->module()->begin();
+  // Not the dominator tree of the function, but a tree of its blocks, so it
+  // is installed as given.
+  const DominatorTree::EdgeList edges = {
+      {0, 0}, {6, 0}, {7, 6}, {8, 7}, {9, 8}};
+  ASSERT_TRUE(context->SetDominatorAnalysis(function, edges));
+  DominatorAnalysis* dominators = context->GetDominatorAnalysis(function);
+  EXPECT_EQ(edges, dominators->GetDomTree().GetEdges());
+  EXPECT_EQ(8u, dominators->ImmediateDominator(9)->id());
+}
+
+TEST_F(AnalysisSnapshotTest, RejectsEdgesThatAreNotATree) {
+  std::unique_ptr<IRContext> context = Load();
+  const Function* function = &*context->module()->begin();
+  // A child listed before its parent.
+  EXPECT_FALSE(context->SetDominatorAnalysis(
+      function, {{0, 0}, {7, 6}, {6, 0}, {8, 6}, {9, 6}}));
+  // A block listed twice.
+  EXPECT_FALSE(context->SetDominatorAnalysis(
+      function, {{0, 0}, {6, 0}, {7, 6}, {7, 6}, {8, 6}, {9, 6}}));
+  // An id that is not a block of the function.
+  EXPECT_FALSE(context->SetDominatorAnalysis(
+      function, {{0, 0}, {6, 0}, {7, 6}, {8, 6}, {5, 6}}));
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
@@ -146,6 +146,26 @@ TEST(CommonDominatorsTest, NoCommonDominator) {
                                                GetBlock(6u, context)));
 }
 
+TEST(CommonDominatorsTest, DominatesAll) {
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  EXPECT_NE(nullptr, context);
+
+  DominatorAnalysis* analysis =
+      context->GetDominatorAnalysis(&*context->module()->begin());
+
+  EXPECT_TRUE(analysis->DominatesAll(3u, {3u, 6u, 7u, 8u, 9u, 10u}));
+  EXPECT_TRUE(analysis->DominatesAll(2u, {}));
+  EXPECT_FALSE(analysis->DominatesAll(3u, {6u, 4u}));
+  EXPECT_FALSE(analysis->DominatesAll(8u, {9u, 6u}));
+
+  // Unreachable blocks are not dominated by anything.
+  EXPECT_FALSE(analysis->DominatesAll(1u, {10u, 11u}));
+  EXPECT_TRUE(analysis->DominatesAll(11u, {}));
+  EXPECT_FALSE(analysis->DominatesAll(11u, {11u}));
+}
+
 }  // namespace
 }  // namespace opt
 }  // namespace spvtools
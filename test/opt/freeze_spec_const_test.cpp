@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -173,6 +174,53 @@ TEST_F(FreezeSpecConstantValueRemoveDecorationTest,
                                                      /* skip_nop = */ true);
 }
 
+TEST(FreezeSpecConstantValueDeferredTest, FunctionsAreNotBuilt) {
+  const std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpDecorate %3 SpecId 1
+%1 = OpTypeVoid
+%2 = OpTypeInt 32 0
+%3 = OpSpecConstant %2 7
+%4 = OpTypeFunction %1
+%5 = OpFunction %1 None %4
+%6 = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(tools.Assemble(text, &binary,
+                             SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS));
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, binary.data(), binary.size(),
+                  /* extra_line_tracking = */ true, /* use_arena = */ false,
+                  /* defer_functions = */ true);
+  ASSERT_NE(nullptr, context);
+  ASSERT_TRUE(context->module()->HasDeferredFunctions());
+
+  FreezeSpecConstantValuePass pass;
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+  EXPECT_TRUE(context->module()->HasDeferredFunctions());
+
+  std::vector<uint32_t> frozen;
+  context->module()->ToBinary(&frozen, /* skip_nop = */ true);
+  std::string disassembly;
+  ASSERT_TRUE(tools.Disassemble(frozen, &disassembly,
+                                SPV_BINARY_TO_TEXT_OPTION_NO_HEADER));
+  EXPECT_EQ(R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeInt 32 0
+%3 = OpConstant %2 7
+%4 = OpTypeFunction %1
+%5 = OpFunction %1 None %4
+%6 = OpLabel
+OpReturn
+OpFunctionEnd
+)",
+            disassembly);
+}
+
 }  // namespace
 }  // namespace opt
 }  // namespace spvtools
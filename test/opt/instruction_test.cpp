@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -258,6 +259,34 @@ TEST(InstructionTest, ForInIdNonstandardIdTypes) {
   EXPECT_THAT(ids, Eq(std::vector<uint32_t>{100, 101, 102}));
 }
 
+// Collects the ids it visits.  It cannot be copied, so it cannot be wrapped in
+// a std::function.
+class IdCollector {
+ public:
+  IdCollector() = default;
+  IdCollector(const IdCollector&) = delete;
+  IdCollector& operator=(const IdCollector&) = delete;
+
+  void operator()(const uint32_t* id) { ids.push_back(*id); }
+
+  std::vector<uint32_t> ids;
+};
+
+TEST(InstructionTest, ForInIdTakesAnyCallable) {
+  IRContext context(SPV_ENV_UNIVERSAL_1_2, nullptr);
+  const Instruction inst(&context, kSampleAccessChainInstruction);
+
+  IdCollector collector;
+  inst.ForEachInId(collector);
+  EXPECT_THAT(collector.ids, Eq(std::vector<uint32_t>{102, 103, 104, 105}));
+
+  std::vector<uint32_t> ids;
+  const std::function<void(const uint32_t*)> f =
+      [&ids](const uint32_t* idptr) { ids.push_back(*idptr); };
+  inst.ForEachInId(f);
+  EXPECT_THAT(ids, Eq(std::vector<uint32_t>{102, 103, 104, 105}));
+}
+
 TEST(InstructionTest, UniqueIds) {
   IRContext context(SPV_ENV_UNIVERSAL_1_2, nullptr);
   Instruction inst1(&context);
@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "OpenCLDebugInfo100.h"
 #include "gmock/gmock.h"
@@ -831,6 +832,51 @@ OpFunctionEnd)";
   EXPECT_FALSE(ctx->AreAnalysesValid(IRContext::kAnalysisDominatorAnalysis));
 }
 
+TEST_F(IRContextTest, AnalyzeFunctionsInParallel) {
+  const std::string text = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%3 = OpFunction %1 None %2
+%4 = OpLabel
+OpReturn
+OpFunctionEnd
+%5 = OpFunction %1 None %2
+%6 = OpLabel
+OpReturn
+OpFunctionEnd
+%7 = OpFunction %1 None %2
+%8 = OpLabel
+OpReturn
+OpFunctionEnd)";
+
+  std::unique_ptr<IRContext> ctx =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ctx->set_num_threads(3);
+  ctx->InvalidateAnalyses(IRContext::kAnalysisDefUse |
+                          IRContext::kAnalysisCombinators);
+
+  std::vector<Function*> functions;
+  for (Function& function : *ctx->module()) functions.push_back(&function);
+  std::vector<uint32_t> labels(functions.size());
+  ctx->AnalyzeFunctionsInParallel(
+      functions,
+      IRContext::kAnalysisDefUse | IRContext::kAnalysisCombinators,
+      [&ctx, &labels](Function* function, size_t i) {
+        // The analyses are built before the calls, so they can be read.
+        labels[i] = ctx->get_def_use_mgr()
+                        ->GetDef(function->entry()->id())
+                        ->result_id();
+      });
+
+  EXPECT_TRUE(ctx->AreAnalysesValid(IRContext::kAnalysisDefUse));
+  EXPECT_TRUE(ctx->AreAnalysesValid(IRContext::kAnalysisCombinators));
+  EXPECT_THAT(labels, ::testing::ElementsAre(4, 6, 8));
+}
+
 TEST_F(IRContextTest, AsanErrorTest) {
   std::string shader = R"(
                OpCapability Shader
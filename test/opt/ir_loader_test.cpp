@@ -1393,6 +1393,123 @@ TEST(IrBuilder, KeepModuleProcessedInRightPlace) {
 
 // Checks the given |error_message| is reported when trying to build a module
 // from the given |assembly|.
+// A module with two functions and no debug line information.
+const char kTwoFunctions[] = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Vertex %main "main"
+OpName %main "main"
+%void = OpTypeVoid
+%4 = OpTypeFunction %void
+%int = OpTypeInt 32 1
+%int_1 = OpConstant %int 1
+%main = OpFunction %void None %4
+%7 = OpLabel
+%8 = OpFunctionCall %void %9
+OpReturn
+OpFunctionEnd
+%9 = OpFunction %void None %4
+%10 = OpLabel
+%11 = OpIAdd %int %int_1 %int_1
+OpReturn
+OpFunctionEnd
+)";
+
+std::unique_ptr<IRContext> BuildWithDeferredFunctions(
+    const std::vector<uint32_t>& binary) {
+  return BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, binary.data(),
+                     binary.size(), /* extra_line_tracking = */ true,
+                     /* use_arena = */ false, /* defer_functions = */ true);
+}
+
+TEST(IrBuilder, DeferredFunctionsAreWrittenAsRead) {
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(t.Assemble(kTwoFunctions, &binary));
+  std::unique_ptr<IRContext> context = BuildWithDeferredFunctions(binary);
+  ASSERT_NE(nullptr, context);
+  Module* module = context->module();
+  EXPECT_TRUE(module->HasDeferredFunctions());
+
+  std::vector<uint32_t> written;
+  module->ToBinary(&written, /* skip_nop = */ true);
+  EXPECT_THAT(written, ContainerEq(binary));
+  EXPECT_EQ(11u, module->ComputeIdBound());
+  EXPECT_TRUE(module->HasDeferredFunctions());
+}
+
+TEST(IrBuilder, DeferredFunctionsAreBuiltOnAccess) {
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(t.Assemble(kTwoFunctions, &binary));
+  std::unique_ptr<IRContext> context = BuildWithDeferredFunctions(binary);
+  ASSERT_NE(nullptr, context);
+  Module* module = context->module();
+
+  std::vector<uint32_t> function_ids;
+  for (const Function& function : *module) {
+    function_ids.push_back(function.result_id());
+  }
+  EXPECT_FALSE(module->HasDeferredFunctions());
+  EXPECT_THAT(function_ids, ContainerEq(std::vector<uint32_t>{1, 8}));
+  EXPECT_EQ(11u, module->ComputeIdBound());
+
+  std::vector<uint32_t> written;
+  module->ToBinary(&written, /* skip_nop = */ true);
+  EXPECT_THAT(written, ContainerEq(binary));
+}
+
+TEST(IrBuilder, InvalidDeferredFunctionsAreReportedWhenBuilt) {
+  const std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%2 = OpTypeFunction %void
+%3 = OpFunction %void None %2
+%4 = OpFunction %void None %2
+)";
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(t.Assemble(text, &binary));
+  std::vector<std::string> messages;
+  std::unique_ptr<IRContext> context = BuildModule(
+      SPV_ENV_UNIVERSAL_1_1,
+      [&messages](spv_message_level_t, const char*, const spv_position_t&,
+                  const char* m) { messages.push_back(m); },
+      binary.data(), binary.size(), /* extra_line_tracking = */ true,
+      /* use_arena = */ false, /* defer_functions = */ true);
+  ASSERT_NE(nullptr, context);
+  Module* module = context->module();
+  EXPECT_FALSE(module->FailedToBuildFunctions());
+  EXPECT_TRUE(messages.empty());
+
+  module->begin();
+  EXPECT_TRUE(module->FailedToBuildFunctions());
+  EXPECT_THAT(messages,
+              ContainerEq(std::vector<std::string>{
+                  "function inside function",
+                  "The functions of the module are not valid"}));
+}
+
+TEST(IrBuilder, FunctionsWithLineInfoAreNotDeferred) {
+  const std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+%1 = OpString "file.glsl"
+%void = OpTypeVoid
+%3 = OpTypeFunction %void
+%4 = OpFunction %void None %3
+%5 = OpLabel
+OpLine %1 10 0
+OpReturn
+OpFunctionEnd
+)";
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(t.Assemble(text, &binary));
+  std::unique_ptr<IRContext> context = BuildWithDeferredFunctions(binary);
+  ASSERT_NE(nullptr, context);
+  EXPECT_FALSE(context->module()->HasDeferredFunctions());
+  EXPECT_TRUE(context->module()->ContainsDebugInfo());
+}
+
 void DoErrorMessageCheck(const std::string& assembly,
                          const std::string& error_message, uint32_t line_num) {
   auto consumer = [error_message, line_num](spv_message_level_t, const char*,
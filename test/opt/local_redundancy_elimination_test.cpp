@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <tuple>
 
 #include "gmock/gmock.h"
 #include "source/opt/build_module.h"
@@ -198,6 +199,61 @@ OpFunctionEnd
   SinglePassRunAndMatch<LocalRedundancyEliminationPass>(text, true);
 }
 
+// The redundant instructions of the functions are found concurrently, and the
+// result must be the same as on one thread.
+TEST_F(LocalRedundancyEliminationTest, ManyFunctionsOnSeveralThreads) {
+  const uint32_t kNumFunctions = 16;
+  std::string text = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+)";
+  for (uint32_t i = 0; i < kNumFunctions; ++i) {
+    text += "OpName %" + std::to_string(100 + 10 * i + 5) + " \"sum" +
+            std::to_string(i) + "\"\n";
+  }
+  text += R"(%void = OpTypeVoid
+%2 = OpTypeFunction %void
+%float = OpTypeFloat 32
+%_ptr_Function_float = OpTypePointer Function %float
+)";
+  for (uint32_t i = 0; i < kNumFunctions; ++i) {
+    std::string ids[10];
+    for (uint32_t j = 0; j < 10; ++j) {
+      ids[j] = "%" + std::to_string(100 + 10 * i + j);
+    }
+    text += ids[0] + " = OpFunction %void None %2\n" + ids[1] +
+            " = OpLabel\n" + ids[2] +
+            " = OpVariable %_ptr_Function_float Function\n" + ids[3] +
+            " = OpLoad %float " + ids[2] + "\n" + ids[4] +
+            " = OpFAdd %float " + ids[3] + " " + ids[3] + "\n" + ids[5] +
+            " = OpFAdd %float " + ids[3] + " " + ids[3] + "\n" + ids[6] +
+            " = OpFMul %float " + ids[4] + " " + ids[5] + "\nOpStore " +
+            ids[2] + " " + ids[6] + "\nOpBranch " + ids[7] + "\n" + ids[7] +
+            " = OpLabel\n" + ids[8] + " = OpFAdd %float " + ids[3] + " " +
+            ids[3] + "\n" + ids[9] + " = OpFAdd %float " + ids[3] + " " +
+            ids[3] + "\nOpStore " + ids[2] + " " + ids[9] +
+            "\nOpReturn\nOpFunctionEnd\n";
+  }
+  SetAssembleOptions(SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+
+  OptimizerOptions()->num_threads_ = 1;
+  std::string serial;
+  Pass::Status serial_status = Pass::Status::Failure;
+  std::tie(serial, serial_status) =
+      SinglePassRunAndDisassemble<LocalRedundancyEliminationPass>(
+          text, /* skip_nop = */ true, /* do_validation = */ true);
+  EXPECT_EQ(Pass::Status::SuccessWithChange, serial_status);
+
+  OptimizerOptions()->num_threads_ = 4;
+  std::string parallel;
+  Pass::Status parallel_status = Pass::Status::Failure;
+  std::tie(parallel, parallel_status) =
+      SinglePassRunAndDisassemble<LocalRedundancyEliminationPass>(
+          text, /* skip_nop = */ true, /* do_validation = */ true);
+  EXPECT_EQ(serial_status, parallel_status);
+  EXPECT_EQ(serial, parallel);
+}
+
 }  // namespace
 }  // namespace opt
 }  // namespace spvtools
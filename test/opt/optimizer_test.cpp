@@ -270,6 +270,51 @@ OpFunctionEnd
       << "Was expecting the OpNop to have been removed.";
 }
 
+TEST(Optimizer, ArenaAllocationDoesNotChangeResult) {
+  const std::string text = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%2 = OpTypeFunction %void
+%int = OpTypeInt 32 1
+%_ptr_Function_int = OpTypePointer Function %int
+%int_1 = OpConstant %int 1
+%3 = OpFunction %void None %2
+%4 = OpLabel
+%5 = OpVariable %_ptr_Function_int Function
+OpStore %5 %int_1
+%6 = OpLoad %int %5
+%7 = OpIAdd %int %6 %6
+OpStore %5 %7
+OpBranch %8
+%8 = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  std::vector<uint32_t> binary;
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_0);
+  ASSERT_TRUE(tools.Assemble(text, &binary));
+
+  std::vector<uint32_t> expected;
+  {
+    Optimizer opt(SPV_ENV_UNIVERSAL_1_0);
+    opt.RegisterPerformancePasses();
+    ASSERT_TRUE(opt.Run(binary.data(), binary.size(), &expected));
+  }
+
+  std::vector<uint32_t> actual;
+  {
+    Optimizer opt(SPV_ENV_UNIVERSAL_1_0);
+    opt.RegisterPerformancePasses();
+    OptimizerOptions options;
+    options.set_arena_allocation(true);
+    ASSERT_TRUE(opt.Run(binary.data(), binary.size(), &actual, options));
+  }
+
+  EXPECT_EQ(expected, actual);
+}
+
 TEST(Optimizer, AvoidIntegrityCheckForExtraLineInfo) {
   // Test that it avoids the integrity check when no optimizations are run and
   // OpLines are propagated.
@@ -28,6 +28,7 @@ namespace opt {
 namespace {
 
 using spvtest::GetIdBound;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 
 // A null pass whose constructors accept arguments
@@ -186,6 +187,48 @@ TEST(PassManager, RecomputeIdBoundAutomatically) {
   EXPECT_THAT(GetIdBound(*context.module()), Eq(201u));
 }
 
+// A pass that builds the def-use manager and changes nothing.
+class BuildDefUsePass : public Pass {
+ public:
+  const char* name() const override { return "BuildDefUse"; }
+  Status Process() override {
+    context()->get_def_use_mgr();
+    return Status::SuccessWithoutChange;
+  }
+};
+
+TEST(PassManager, ObserverReceivesMetricsOfEachPass) {
+  PassManager manager;
+  std::vector<std::string> names;
+  std::vector<spv_pass_metrics_t> metrics;
+  manager.SetPassObserver(
+      [&names, &metrics](const spv_pass_metrics_t& pass_metrics) {
+        names.push_back(pass_metrics.pass_name);
+        metrics.push_back(pass_metrics);
+      });
+  IRContext context(SPV_ENV_UNIVERSAL_1_2, MakeUnique<Module>(),
+                    manager.consumer());
+
+  manager.AddPass<BuildDefUsePass>();
+  manager.AddPass<AppendOpNopPass>();
+  EXPECT_EQ(Pass::Status::SuccessWithChange, manager.Run(&context));
+  EXPECT_THAT(names, ElementsAre("BuildDefUse", "AppendOpNop"));
+  ASSERT_EQ(2u, metrics.size());
+
+  EXPECT_FALSE(metrics[0].changed);
+  EXPECT_EQ(0u, metrics[0].num_insts_before);
+  EXPECT_EQ(0u, metrics[0].num_insts_after);
+  EXPECT_EQ(1u, metrics[0].num_analyses_built);
+  EXPECT_EQ(0u, metrics[0].num_analyses_invalidated);
+
+  // The def-use manager is not preserved by a pass that changes the module.
+  EXPECT_TRUE(metrics[1].changed);
+  EXPECT_EQ(0u, metrics[1].num_insts_before);
+  EXPECT_EQ(1u, metrics[1].num_insts_after);
+  EXPECT_EQ(0u, metrics[1].num_analyses_built);
+  EXPECT_EQ(1u, metrics[1].num_analyses_invalidated);
+}
+
 }  // anonymous namespace
 }  // namespace opt
 }  // namespace spvtools
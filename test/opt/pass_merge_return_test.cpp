@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
 #include <string>
 
 #include "gmock/gmock.h"
+#include "source/opt/build_module.h"
+#include "source/opt/def_use_manager.h"
 #include "spirv-tools/libspirv.hpp"
 #include "spirv-tools/optimizer.hpp"
 #include "test/opt/pass_fixture.h"
@@ -222,6 +225,44 @@ OpFunctionEnd
   SinglePassRunAndCheck<MergeReturnPass>(before, after, false, true);
 }
 
+TEST_F(MergeReturnPassTest, TwoReturnsWithValuesPreservesDefUse) {
+  const std::string text =
+      R"(OpCapability Linkage
+OpCapability Kernel
+OpMemoryModel Logical OpenCL
+OpDecorate %7 LinkageAttributes "simple_kernel" Export
+%1 = OpTypeInt 32 0
+%2 = OpTypeBool
+%3 = OpConstantFalse %2
+%4 = OpConstant %1 0
+%5 = OpConstant %1 1
+%6 = OpTypeFunction %1
+%7 = OpFunction %1 None %6
+%8 = OpLabel
+OpBranchConditional %3 %9 %10
+%9 = OpLabel
+OpReturnValue %4
+%10 = OpLabel
+OpReturnValue %5
+OpFunctionEnd
+)";
+
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  context->get_def_use_mgr();
+
+  MergeReturnPass pass;
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+  ASSERT_TRUE(context->AreAnalysesValid(IRContext::kAnalysisDefUse));
+
+  analysis::DefUseManager fresh(context->module());
+  EXPECT_TRUE(CompareAndPrintDifferences(*context->get_def_use_mgr(), fresh));
+  EXPECT_EQ(12u, context->get_def_use_mgr()->GetDef(12)->result_id());
+  EXPECT_EQ(1u, context->get_def_use_mgr()->NumUses(12));
+}
+
 TEST_F(MergeReturnPassTest, UnreachableReturnsNoValue) {
   const std::string before =
       R"(OpCapability Addresses
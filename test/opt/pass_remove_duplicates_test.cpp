@@ -241,6 +241,69 @@ OpName %1 "Type1"
   EXPECT_EQ(GetErrorMessage(), "");
 }
 
+TEST_F(RemoveDuplicatesTest, SameTypeAndDecorationsInDifferentOrder) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 Block
+OpDecorate %1 GLSLPacked
+OpDecorate %2 GLSLPacked
+OpDecorate %2 Block
+%3 = OpTypeInt 32 0
+%1 = OpTypeStruct %3 %3
+%2 = OpTypeStruct %3 %3
+)";
+  const std::string after = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpDecorate %1 Block
+OpDecorate %1 GLSLPacked
+%3 = OpTypeInt 32 0
+%1 = OpTypeStruct %3 %3
+)";
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
+
+TEST_F(RemoveDuplicatesTest, ManyDuplicateTypesAndDecorations) {
+  // Array %<3i + 1> is declared again as %<3i + 2>, of a duplicate element
+  // type, and both repeat their decoration.
+  const uint32_t kNumTypes = 200;
+  std::string spirv = R"(OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+)";
+  std::string after = spirv;
+  for (uint32_t i = 1; i <= kNumTypes; ++i) {
+    const std::string a = std::to_string(3 * i + 1);
+    const std::string b = std::to_string(3 * i + 2);
+    spirv += "OpDecorate %" + a + " ArrayStride 4\n";
+    spirv += "OpDecorate %" + a + " ArrayStride 4\n";
+    spirv += "OpDecorate %" + b + " ArrayStride 4\n";
+    spirv += "OpDecorate %" + b + " ArrayStride 4\n";
+    after += "OpDecorate %" + a + " ArrayStride 4\n";
+  }
+  spirv += "%1 = OpTypeInt 32 0\n%2 = OpTypeInt 32 0\n";
+  after += "%1 = OpTypeInt 32 0\n";
+  for (uint32_t i = 1; i <= kNumTypes; ++i) {
+    const std::string n = std::to_string(3 * i);
+    const std::string a = std::to_string(3 * i + 1);
+    const std::string b = std::to_string(3 * i + 2);
+    const std::string constant =
+        "%" + n + " = OpConstant %1 " + std::to_string(i) + "\n";
+    spirv += constant;
+    spirv += "%" + a + " = OpTypeArray %1 %" + n + "\n";
+    spirv += "%" + b + " = OpTypeArray %2 %" + n + "\n";
+    after += constant;
+    after += "%" + a + " = OpTypeArray %1 %" + n + "\n";
+  }
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
+
 // Check that #1033 has been fixed.
 TEST_F(RemoveDuplicatesTest, DoNotRemoveDifferentOpDecorationGroup) {
   const std::string spirv = R"(
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -1164,6 +1166,63 @@ INSTANTIATE_TEST_SUITE_P(
         },
     }));
 
+TEST(SetSpecConstantDefaultValueDeferredTest, FunctionsAreNotBuilt) {
+  const std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpDecorate %2 SpecId 100
+%1 = OpDecorationGroup
+OpDecorate %1 SpecId 101
+OpGroupDecorate %1 %4
+%3 = OpTypeInt 32 0
+%2 = OpSpecConstant %3 7
+%4 = OpSpecConstant %3 8
+%5 = OpTypeVoid
+%6 = OpTypeFunction %5
+%7 = OpFunction %5 None %6
+%8 = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(tools.Assemble(text, &binary,
+                             SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS));
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, binary.data(), binary.size(),
+                  /* extra_line_tracking = */ true, /* use_arena = */ false,
+                  /* defer_functions = */ true);
+  ASSERT_NE(nullptr, context);
+  ASSERT_TRUE(context->module()->HasDeferredFunctions());
+
+  SetSpecConstantDefaultValuePass pass(
+      SpecIdToValueStrMap{{100, "42"}, {101, "43"}});
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+  EXPECT_TRUE(context->module()->HasDeferredFunctions());
+
+  std::vector<uint32_t> result;
+  context->module()->ToBinary(&result, /* skip_nop = */ true);
+  std::string disassembly;
+  ASSERT_TRUE(tools.Disassemble(result, &disassembly,
+                                SPV_BINARY_TO_TEXT_OPTION_NO_HEADER));
+  EXPECT_EQ(R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpDecorate %2 SpecId 100
+%1 = OpDecorationGroup
+OpDecorate %1 SpecId 101
+OpGroupDecorate %1 %4
+%3 = OpTypeInt 32 0
+%2 = OpSpecConstant %3 42
+%4 = OpSpecConstant %3 43
+%5 = OpTypeVoid
+%6 = OpTypeFunction %5
+%7 = OpFunction %5 None %6
+%8 = OpLabel
+OpReturn
+OpFunctionEnd
+)",
+            disassembly);
+}
+
 }  // namespace
 }  // namespace opt
 }  // namespace spvtools
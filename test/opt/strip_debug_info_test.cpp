@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "test/opt/pass_fixture.h"
@@ -227,6 +229,50 @@ INSTANTIATE_TEST_SUITE_P(
     })));
 // clang-format on
 
+TEST(StripDebugInfoDeferredTest, FunctionsAreNotBuilt) {
+  const std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpSource GLSL 450
+OpName %5 "main"
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%5 = OpFunction %1 None %2
+%6 = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(tools.Assemble(text, &binary,
+                             SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS));
+  std::unique_ptr<IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, binary.data(), binary.size(),
+                  /* extra_line_tracking = */ true, /* use_arena = */ false,
+                  /* defer_functions = */ true);
+  ASSERT_NE(nullptr, context);
+  ASSERT_TRUE(context->module()->HasDeferredFunctions());
+
+  StripDebugInfoPass pass;
+  EXPECT_EQ(Pass::Status::SuccessWithChange, pass.Run(context.get()));
+  EXPECT_TRUE(context->module()->HasDeferredFunctions());
+
+  std::vector<uint32_t> stripped;
+  context->module()->ToBinary(&stripped, /* skip_nop = */ true);
+  std::string disassembly;
+  ASSERT_TRUE(tools.Disassemble(stripped, &disassembly,
+                                SPV_BINARY_TO_TEXT_OPTION_NO_HEADER));
+  EXPECT_EQ(R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%5 = OpFunction %1 None %2
+%6 = OpLabel
+OpReturn
+OpFunctionEnd
+)",
+            disassembly);
+}
+
 }  // namespace
 }  // namespace opt
 }  // namespace spvtools
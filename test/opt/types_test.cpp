@@ -433,6 +433,22 @@ TEST(Types, Clone) {
   }
 }
 
+TEST(Types, HashIgnoresDecorationOrder) {
+  Integer u32(32, false);
+  Struct a({&u32, &u32});
+  Struct b({&u32, &u32});
+  a.AddDecoration({SpvDecorationBlock});
+  a.AddDecoration({SpvDecorationGLSLPacked});
+  a.AddMemberDecoration(0, {SpvDecorationOffset, 0});
+  a.AddMemberDecoration(0, {SpvDecorationNonWritable});
+  b.AddDecoration({SpvDecorationGLSLPacked});
+  b.AddDecoration({SpvDecorationBlock});
+  b.AddMemberDecoration(0, {SpvDecorationNonWritable});
+  b.AddMemberDecoration(0, {SpvDecorationOffset, 0});
+  EXPECT_TRUE(a.IsSame(&b));
+  EXPECT_EQ(a.HashValue(), b.HashValue());
+}
+
 TEST(Types, RemoveDecorations) {
   std::vector<std::unique_ptr<Type>> types = GenerateAllTypesWithDecorations();
   for (auto& t : types) {
@@ -618,6 +618,134 @@ OpFunctionEnd
   SinglePassRunAndCheck<VectorDCE>(before, before, true, true);
 }
 
+TEST_F(VectorDCETest, ManyFunctionsOnSeveralThreads) {
+  // Each function inserts into a component that is never read.  The functions
+  // are analyzed concurrently, and the result must be the same as on one
+  // thread.
+  const uint32_t kNumFunctions = 16;
+  const std::string predefs =
+      R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main" %In0 %Out
+OpExecutionMode %main OriginUpperLeft
+OpName %main "main"
+OpName %In0 "In0"
+OpName %Out "Out"
+%void = OpTypeVoid
+%2 = OpTypeFunction %void
+%float = OpTypeFloat 32
+%v4float = OpTypeVector %float 4
+%float_1 = OpConstant %float 1
+%_ptr_Input_v4float = OpTypePointer Input %v4float
+%In0 = OpVariable %_ptr_Input_v4float Input
+%_ptr_Output_float = OpTypePointer Output %float
+%Out = OpVariable %_ptr_Output_float Output
+)";
+  std::string before = predefs;
+  std::string after = predefs;
+  for (uint32_t i = 0; i < kNumFunctions; ++i) {
+    const uint32_t base = 100 + 10 * i;
+    const std::string function = i == 0 ? "%main" : "%" + std::to_string(base);
+    const std::string label = "%" + std::to_string(base + 1);
+    const std::string load = "%" + std::to_string(base + 2);
+    const std::string insert = "%" + std::to_string(base + 3);
+    const std::string extract = "%" + std::to_string(base + 4);
+    const std::string header = function + " = OpFunction %void None %2\n" +
+                               label + " = OpLabel\n" + load +
+                               " = OpLoad %v4float %In0\n";
+    const std::string footer =
+        "OpStore %Out " + extract + "\nOpReturn\nOpFunctionEnd\n";
+    before += header + insert + " = OpCompositeInsert %v4float %float_1 " +
+              load + " 1\n" + extract + " = OpCompositeExtract %float " +
+              insert + " 0\n" + footer;
+    after += header + extract + " = OpCompositeExtract %float " + load +
+             " 0\n" + footer;
+  }
+
+  OptimizerOptions()->num_threads_ = 4;
+  SetAssembleOptions(SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  SinglePassRunAndCheck<VectorDCE>(before, after, true, true);
+}
+
+TEST_F(VectorDCETest, KernelFunctionsOnSeveralThreads) {
+  // Without the Shader capability there are no combinators to look up for
+  // core opcodes, so nothing is removed.  The functions are analyzed
+  // concurrently, which must only read the combinator table.
+  const uint32_t kNumFunctions = 16;
+  std::string text =
+      R"(OpCapability Addresses
+OpCapability Kernel
+OpCapability Linkage
+OpMemoryModel Physical32 OpenCL
+%uint = OpTypeInt 32 0
+%v4uint = OpTypeVector %uint 4
+%uint_1 = OpConstant %uint 1
+%3 = OpConstantNull %v4uint
+%2 = OpTypeFunction %uint
+)";
+  for (uint32_t i = 0; i < kNumFunctions; ++i) {
+    const uint32_t base = 100 + 10 * i;
+    const std::string insert = "%" + std::to_string(base + 2);
+    const std::string extract = "%" + std::to_string(base + 3);
+    text += "%" + std::to_string(base) + " = OpFunction %uint None %2\n%" +
+            std::to_string(base + 1) + " = OpLabel\n" + insert +
+            " = OpCompositeInsert %v4uint %uint_1 %3 1\n" + extract +
+            " = OpCompositeExtract %uint " + insert +
+            " 0\nOpReturnValue " + extract + "\nOpFunctionEnd\n";
+  }
+
+  OptimizerOptions()->num_threads_ = 4;
+  SetAssembleOptions(SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  SinglePassRunAndCheck<VectorDCE>(text, text, true, true);
+}
+
+TEST_F(VectorDCETest, ExtInstsOnSeveralThreadsAfterStripNonSemantic) {
+  // Removing the extension resets the feature manager, which the workers look
+  // up for each GLSL.std.450 instruction, so it must be rebuilt before the
+  // functions are analyzed concurrently.
+  const uint32_t kNumFunctions = 16;
+  const std::string capability = "OpCapability Shader\n";
+  const std::string extension = "OpExtension \"SPV_KHR_non_semantic_info\"\n";
+  const std::string predefs =
+      R"(%1 = OpExtInstImport "GLSL.std.450"
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main" %In0 %Out
+OpExecutionMode %main OriginUpperLeft
+OpName %main "main"
+OpName %In0 "In0"
+OpName %Out "Out"
+%void = OpTypeVoid
+%2 = OpTypeFunction %void
+%float = OpTypeFloat 32
+%v4float = OpTypeVector %float 4
+%_ptr_Input_v4float = OpTypePointer Input %v4float
+%In0 = OpVariable %_ptr_Input_v4float Input
+%_ptr_Output_float = OpTypePointer Output %float
+%Out = OpVariable %_ptr_Output_float Output
+)";
+  std::string functions;
+  for (uint32_t i = 0; i < kNumFunctions; ++i) {
+    const uint32_t base = 100 + 10 * i;
+    const std::string load = "%" + std::to_string(base + 2);
+    const std::string abs = "%" + std::to_string(base + 3);
+    const std::string extract = "%" + std::to_string(base + 4);
+    functions += (i == 0 ? "%main" : "%" + std::to_string(base)) +
+                 " = OpFunction %void None %2\n%" + std::to_string(base + 1) +
+                 " = OpLabel\n" + load + " = OpLoad %v4float %In0\n" + abs +
+                 " = OpExtInst %v4float %1 FAbs " + load + "\n" + extract +
+                 " = OpCompositeExtract %float " + abs + " 0\nOpStore %Out " +
+                 extract + "\nOpReturn\nOpFunctionEnd\n";
+  }
+  const std::string before = capability + extension + predefs + functions;
+  const std::string after = capability + predefs + functions;
+
+  OptimizerOptions()->num_threads_ = 4;
+  SetAssembleOptions(SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  AddPass<StripNonSemanticInfoPass>();
+  AddPass<VectorDCE>();
+  RunAndCheck(before, after);
+}
+
 TEST_F(VectorDCETest, DeadInsertInCycle) {
   // Dead insert in chain with cycle. Demonstrates analysis can handle
   // cycles in chains going through scalars intermediate values.
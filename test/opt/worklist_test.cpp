@@ -0,0 +1,133 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/opt/worklist.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "source/opt/build_module.h"
+#include "source/opt/cfg.h"
+#include "source/opt/ir_context.h"
+
+namespace spvtools {
+namespace opt {
+namespace {
+
+using ::testing::ElementsAre;
+
+// A function whose blocks are laid out out of reverse post-order: %5 and %6
+// are the two sides of a selection headed by %4, which is entered from %3 and
+// merges at %7.  %9 is unreachable.
+const std::string kFunction = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%10 = OpTypeBool
+%11 = OpConstantTrue %10
+%20 = OpFunction %1 None %2
+%3 = OpLabel
+OpBranch %4
+%7 = OpLabel
+OpReturn
+%6 = OpLabel
+OpBranch %7
+%4 = OpLabel
+OpSelectionMerge %7 None
+OpBranchConditional %11 %5 %6
+%9 = OpLabel
+OpBranch %7
+%5 = OpLabel
+OpBranch %7
+OpFunctionEnd
+)";
+
+class WorklistTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    context_ = BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, kFunction,
+                           SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+    ASSERT_NE(nullptr, context_);
+    function_ = &*context_->module()->begin();
+  }
+
+  BasicBlock* Block(uint32_t id) { return context_->cfg()->block(id); }
+
+  std::unique_ptr<IRContext> context_;
+  Function* function_ = nullptr;
+};
+
+TEST_F(WorklistTest, BlocksComeOutInReversePostOrder) {
+  BlockWorklist worklist;
+  worklist.Reset(context_->cfg(), function_);
+  for (uint32_t id : {7u, 5u, 3u, 4u}) EXPECT_TRUE(worklist.Push(Block(id)));
+
+  std::vector<uint32_t> order;
+  while (!worklist.empty()) order.push_back(worklist.Pop()->id());
+  EXPECT_THAT(order, ElementsAre(3, 4, 5, 7));
+}
+
+TEST_F(WorklistTest, BlockIsPendingOnce) {
+  BlockWorklist worklist;
+  worklist.Reset(context_->cfg(), function_);
+  EXPECT_TRUE(worklist.Push(Block(6)));
+  EXPECT_FALSE(worklist.Push(Block(6)));
+  EXPECT_EQ(6u, worklist.Pop()->id());
+  EXPECT_TRUE(worklist.empty());
+
+  // Once handed out, a block can be added again.
+  EXPECT_TRUE(worklist.Push(Block(6)));
+  EXPECT_FALSE(worklist.empty());
+}
+
+TEST_F(WorklistTest, UnreachableBlocksComeLast) {
+  BlockWorklist worklist;
+  worklist.Reset(context_->cfg(), function_);
+  const uint32_t exit_index = worklist.Index(Block(7));
+  EXPECT_EQ(exit_index + 1, worklist.Index(Block(9)));
+
+  EXPECT_TRUE(worklist.Push(Block(9)));
+  EXPECT_TRUE(worklist.Push(Block(7)));
+  EXPECT_EQ(7u, worklist.Pop()->id());
+  EXPECT_EQ(9u, worklist.Pop()->id());
+}
+
+TEST_F(WorklistTest, InstructionsComeOutInOrderAdded) {
+  std::vector<Instruction*> insts;
+  for (BasicBlock& block : *function_) insts.push_back(block.terminator());
+
+  InstructionWorklist worklist;
+  EXPECT_TRUE(worklist.Push(insts[2]));
+  EXPECT_TRUE(worklist.Push(insts[0]));
+  EXPECT_FALSE(worklist.Push(insts[2]));
+  EXPECT_TRUE(worklist.IsPending(insts[2]));
+  EXPECT_FALSE(worklist.IsPending(insts[1]));
+  EXPECT_EQ(2u, worklist.size());
+
+  EXPECT_EQ(insts[2], worklist.Pop());
+  EXPECT_FALSE(worklist.IsPending(insts[2]));
+  EXPECT_TRUE(worklist.Push(insts[2]));
+  EXPECT_EQ(insts[0], worklist.Pop());
+  EXPECT_EQ(insts[2], worklist.Pop());
+  EXPECT_TRUE(worklist.empty());
+}
+
+}  // namespace
+}  // namespace opt
+}  // namespace spvtools
@@ -558,6 +558,34 @@ TEST(ReducerTest, ShaderReduceWhileDivReachable) {
   ASSERT_EQ(status, Reducer::ReductionResultStatus::kComplete);
 }
 
+TEST(ReducerTest, ParallelReductionMatchesSerialReduction) {
+  std::vector<uint32_t> binary_in;
+  SpirvTools t(kEnv);
+  ASSERT_TRUE(
+      t.Assemble(kShaderWithLoopsDivAndMul, &binary_in, kReduceAssembleOption));
+
+  std::vector<uint32_t> binary_out[2];
+  const uint32_t num_jobs[2] = {1, 4};
+  for (size_t i = 0; i < 2; ++i) {
+    Reducer reducer(kEnv);
+    reducer.SetInterestingnessFunction(InterestingWhileSDivReachable);
+    reducer.AddDefaultReductionPasses();
+    reducer.SetMessageConsumer(kMessageConsumer);
+
+    spvtools::ReducerOptions reducer_options;
+    reducer_options.set_step_limit(500);
+    reducer_options.set_fail_on_validation_error(true);
+    reducer_options.set_num_jobs(num_jobs[i]);
+    spvtools::ValidatorOptions validator_options;
+
+    Reducer::ReductionResultStatus status = reducer.Run(
+        binary_in, &binary_out[i], reducer_options, validator_options);
+    ASSERT_EQ(status, Reducer::ReductionResultStatus::kComplete);
+  }
+
+  ASSERT_EQ(binary_out[0], binary_out[1]);
+}
+
 // Computes an instruction count for each function in the module represented by
 // |binary|.
 std::unordered_map<uint32_t, uint32_t> GetFunctionInstructionCount(
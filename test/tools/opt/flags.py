@@ -14,6 +14,7 @@
 
 import placeholder
 import expect
+import os
 import re
 
 from spirv_test_framework import inside_spirv_testsuite
@@ -355,3 +356,79 @@ class TestLoopPeelingThresholdArgsInvalidNumber(expect.ErrorMessageSubstr):
 
   spirv_args = ['--loop-peeling-threshold=a10f']
   expected_error_substr = 'must have a positive integer argument'
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchWithInputFile(expect.ErrorMessageSubstr):
+  """Tests that --batch cannot be combined with an input file."""
+
+  shader = placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm')
+  spirv_args = [
+      shader, '--batch=list.txt', '-o',
+      placeholder.TempFileName('output')
+  ]
+  expected_error_substr = 'An input file cannot be used with --batch'
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchMissingListFile(expect.ErrorMessageSubstr):
+  """Tests that a missing --batch list file is reported."""
+
+  spirv_args = [
+      '--batch=does-not-exist.txt', '-o',
+      placeholder.TempFileName('output')
+  ]
+  expected_error_substr = "could not open batch list 'does-not-exist.txt'"
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchOfTwoBinaries(expect.ReturnCodeIsZero, expect.StdoutMatch,
+                             expect.CorrectObjectFilePreamble):
+  """Tests that --batch optimizes every listed binary into the -o directory."""
+
+  shaders = [
+      placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm'),
+      placeholder.FileSPIRVShader(empty_main_assembly(), '.spvasm')
+  ]
+  output = placeholder.TempDirectory('output')
+  spirv_args = [
+      placeholder.BatchListFile(shaders), '--jobs=2', '-o', output,
+      '--strip-debug'
+  ]
+  expected_stdout = re.compile(r': ok\n.*: ok\nProcessed 2 modules, 0 failed\.')
+
+  def check_batch_outputs(self, status):
+    for shader in self.shaders:
+      success, message = self.verify_object_file_preamble(
+          os.path.join(status.directory, 'output',
+                       os.path.basename(shader.filename)), 0x10600)
+      if not success:
+        return False, message
+    return True, ''
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestBatchWithPrintAll(expect.ErrorMessageSubstr):
+  """Tests that flags printing to standard error cannot be used with --batch."""
+
+  spirv_args = [
+      '--batch=list.txt', '--print-all', '-o',
+      placeholder.TempFileName('output')
+  ]
+  expected_error_substr = '--print-all cannot be used with --batch'
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestJobsArgsInvalidNumber(expect.ErrorMessageSubstr):
+  """Tests invalid arguments to --jobs."""
+
+  spirv_args = ['--jobs=abc']
+  expected_error_substr = 'Invalid value passed to --jobs'
+
+
+@inside_spirv_testsuite('SpirvOptFlags')
+class TestJobsArgsNegative(expect.ErrorMessageSubstr):
+  """Tests negative arguments to --jobs."""
+
+  spirv_args = ['--jobs=-1']
+  expected_error_substr = 'Invalid value passed to --jobs'
@@ -159,6 +159,34 @@ class FileSPIRVShader(PlaceHolder):
     return self.filename
 
 
+class BatchListFile(PlaceHolder):
+  """Stands for a --batch list file naming the given shader placeholders."""
+
+  def __init__(self, shaders):
+    assert all(isinstance(shader, PlaceHolder) for shader in shaders)
+    self.shaders = shaders
+    self.filename = None
+
+  def instantiate_for_spirv_args(self, testcase):
+    """Instantiates the shaders and writes their names into a temporary file.
+
+        Returns:
+            The --batch flag naming the temporary file.
+    """
+    names = [shader.instantiate_for_spirv_args(testcase)
+             for shader in self.shaders]
+    temp_fd, self.filename = tempfile.mkstemp(
+        dir=testcase.directory, suffix='.txt')
+    fd = os.fdopen(temp_fd, 'w')
+    fd.write(''.join(name + '\n' for name in names))
+    fd.close()
+    return '--batch=%s' % self.filename
+
+  def instantiate_for_expectation(self, testcase):
+    assert self.filename is not None
+    return self.filename
+
+
 class StdinShader(PlaceHolder):
   """Stands for a shader whose source code is from stdin."""
 
@@ -193,6 +221,23 @@ class TempFileName(PlaceHolder):
     return os.path.join(testcase.directory, self.filename)
 
 
+class TempDirectory(PlaceHolder):
+  """Stands for a temporary directory, which is created."""
+
+  def __init__(self, filename):
+    assert isinstance(filename, str)
+    assert filename != ''
+    self.filename = filename
+
+  def instantiate_for_spirv_args(self, testcase):
+    path = os.path.join(testcase.directory, self.filename)
+    os.mkdir(path)
+    return path
+
+  def instantiate_for_expectation(self, testcase):
+    return os.path.join(testcase.directory, self.filename)
+
+
 class SpecializedString(PlaceHolder):
   """Returns a string that has been specialized based on TestCase.
 
@@ -0,0 +1,103 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/util/arena.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+struct Node {
+  static void* operator new(size_t size) { return Arena::Allocate(size); }
+  static void operator delete(void* ptr) { Arena::Deallocate(ptr); }
+
+  explicit Node(uint32_t v) : value(v) {}
+
+  uint32_t value;
+  double payload[3] = {};
+};
+
+TEST(ArenaTest, HeapWithoutScope) {
+  std::unique_ptr<Node> node(new Node(7));
+  EXPECT_EQ(7u, node->value);
+}
+
+TEST(ArenaTest, AllocatesFromCurrentArena) {
+  Arena::Ptr arena = Arena::Create();
+  EXPECT_EQ(0u, arena->reserved_bytes());
+
+  std::vector<std::unique_ptr<Node>> nodes;
+  {
+    ArenaScope scope(arena.get());
+    for (uint32_t i = 0; i < 1000; ++i) nodes.emplace_back(new Node(i));
+  }
+  EXPECT_GT(arena->reserved_bytes(), 0u);
+
+  for (uint32_t i = 0; i < nodes.size(); ++i) {
+    EXPECT_EQ(i, nodes[i]->value);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(nodes[i].get()) %
+                      alignof(std::max_align_t));
+  }
+
+  // Allocations after the scope ends go to the heap.
+  const size_t reserved = arena->reserved_bytes();
+  for (uint32_t i = 0; i < 1000; ++i) nodes.emplace_back(new Node(i));
+  EXPECT_EQ(reserved, arena->reserved_bytes());
+}
+
+TEST(ArenaTest, ObjectsOutliveOwner) {
+  std::vector<std::unique_ptr<Node>> nodes;
+  {
+    Arena::Ptr arena = Arena::Create();
+    ArenaScope scope(arena.get());
+    for (uint32_t i = 0; i < 10; ++i) nodes.emplace_back(new Node(i));
+  }
+  for (uint32_t i = 0; i < nodes.size(); ++i) EXPECT_EQ(i, nodes[i]->value);
+  nodes.clear();
+}
+
+TEST(ArenaTest, ScopesNest) {
+  Arena::Ptr outer = Arena::Create();
+  Arena::Ptr inner = Arena::Create();
+  std::unique_ptr<Node> a;
+  std::unique_ptr<Node> b;
+  std::unique_ptr<Node> c;
+  {
+    ArenaScope outer_scope(outer.get());
+    {
+      ArenaScope inner_scope(inner.get());
+      a.reset(new Node(1));
+    }
+    EXPECT_EQ(0u, outer->reserved_bytes());
+    b.reset(new Node(2));
+    {
+      ArenaScope heap_scope(nullptr);
+      c.reset(new Node(3));
+    }
+  }
+  EXPECT_GT(inner->reserved_bytes(), 0u);
+  EXPECT_GT(outer->reserved_bytes(), 0u);
+  EXPECT_EQ(1u, a->value);
+  EXPECT_EQ(2u, b->value);
+  EXPECT_EQ(3u, c->value);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
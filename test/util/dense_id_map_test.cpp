@@ -0,0 +1,177 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/util/dense_id_map.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+TEST(DenseIdMapTest, Empty) {
+  DenseIdMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(map.end(), map.begin());
+  EXPECT_EQ(map.end(), map.find(0));
+  EXPECT_EQ(map.end(), map.find(100));
+  EXPECT_EQ(0u, map.count(3));
+}
+
+TEST(DenseIdMapTest, SubscriptInserts) {
+  DenseIdMap<int> map;
+  map[5] = 50;
+  map[2];
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(1u, map.count(2));
+  EXPECT_EQ(0, map.at(2));
+  EXPECT_EQ(50, map.at(5));
+  EXPECT_EQ(0u, map.count(3));
+  EXPECT_EQ(50, map.find(5)->second);
+}
+
+TEST(DenseIdMapTest, IdZeroIsAKey) {
+  DenseIdMap<int> map;
+  EXPECT_EQ(0u, map.count(0));
+  map[0] = 7;
+  EXPECT_EQ(1u, map.count(0));
+  EXPECT_THAT(map, ElementsAre(Pair(0u, 7)));
+}
+
+TEST(DenseIdMapTest, InsertDoesNotOverwrite) {
+  DenseIdMap<int> map;
+  auto result = map.insert({3, 30});
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(3u, result.first->first);
+  result = map.insert({3, 31});
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(30, result.first->second);
+  EXPECT_EQ(1u, map.size());
+}
+
+TEST(DenseIdMapTest, IteratesInIdOrder) {
+  DenseIdMap<int> map;
+  map[9] = 90;
+  map[1] = 10;
+  map[4] = 40;
+  EXPECT_THAT(map, ElementsAre(Pair(1u, 10), Pair(4u, 40), Pair(9u, 90)));
+}
+
+TEST(DenseIdMapTest, Erase) {
+  DenseIdMap<int> map;
+  map[1] = 10;
+  map[2] = 20;
+  map[3] = 30;
+  EXPECT_EQ(1u, map.erase(2));
+  EXPECT_EQ(0u, map.erase(2));
+  EXPECT_EQ(0u, map.erase(1000));
+  EXPECT_EQ(2u, map.size());
+
+  auto next = map.erase(map.find(1));
+  ASSERT_NE(map.end(), next);
+  EXPECT_EQ(3u, next->first);
+  EXPECT_THAT(map, ElementsAre(Pair(3u, 30)));
+
+  map[2] = 21;
+  EXPECT_THAT(map, ElementsAre(Pair(2u, 21), Pair(3u, 30)));
+}
+
+TEST(DenseIdMapTest, ReferencesSurviveGrowth) {
+  DenseIdMap<std::vector<int>> map;
+  std::vector<int>& first = map[1];
+  first.push_back(1);
+  for (uint32_t id = 2; id < 5000; ++id) {
+    map[id].push_back(static_cast<int>(id));
+  }
+  EXPECT_EQ(&first, &map.at(1));
+  EXPECT_THAT(first, ElementsAre(1));
+  EXPECT_EQ(4999u, map.size());
+}
+
+TEST(DenseIdMapTest, SparseIds) {
+  DenseIdMap<int> map;
+  map[100000] = 3;
+  map[3] = 1;
+  map[2000] = 2;
+  EXPECT_THAT(map, ElementsAre(Pair(3u, 1), Pair(2000u, 2), Pair(100000u, 3)));
+  EXPECT_EQ(map.end(), map.find(50000));
+  EXPECT_EQ(0u, map.erase(50000));
+  EXPECT_EQ(1u, map.erase(100000));
+  EXPECT_THAT(map, ElementsAre(Pair(3u, 1), Pair(2000u, 2)));
+}
+
+TEST(DenseIdMapTest, ReserveDoesNotAddEntries) {
+  DenseIdMap<int> map;
+  map.reserve(100);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.end(), map.begin());
+  map[99] = 1;
+  EXPECT_THAT(map, ElementsAre(Pair(99u, 1)));
+}
+
+TEST(DenseIdMapTest, Equality) {
+  DenseIdMap<std::vector<int>> a;
+  DenseIdMap<std::vector<int>> b;
+  EXPECT_EQ(a, b);
+  a[1].push_back(1);
+  EXPECT_NE(a, b);
+  b.reserve(50);
+  b[1].push_back(1);
+  EXPECT_EQ(a, b);
+  b[1].push_back(2);
+  EXPECT_NE(a, b);
+}
+
+TEST(DenseIdMapTest, ConstIteration) {
+  DenseIdMap<int> map;
+  map[2] = 20;
+  const DenseIdMap<int>& const_map = map;
+  DenseIdMap<int>::const_iterator it = map.begin();
+  EXPECT_EQ(const_map.begin(), it);
+  EXPECT_EQ(20, it->second);
+  EXPECT_EQ(const_map.end(), ++it);
+}
+
+TEST(DenseIdMapTest, MoveLeavesTheSourceEmpty) {
+  DenseIdMap<int> a;
+  a[3] = 30;
+  a[300] = 3000;
+  DenseIdMap<int> b(std::move(a));
+  EXPECT_THAT(b, ElementsAre(Pair(3u, 30), Pair(300u, 3000)));
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(0u, a.size());
+  EXPECT_EQ(a.end(), a.begin());
+
+  DenseIdMap<int> c;
+  c[7] = 70;
+  c = std::move(b);
+  EXPECT_THAT(c, ElementsAre(Pair(3u, 30), Pair(300u, 3000)));
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(0u, b.size());
+  EXPECT_EQ(b.end(), b.begin());
+
+  // A moved-from map can be used again.
+  b[1] = 10;
+  EXPECT_THAT(b, ElementsAre(Pair(1u, 10)));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
@@ -0,0 +1,62 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/util/parallel.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+using ::testing::Each;
+
+TEST(ParallelForTest, NoWork) {
+  bool called = false;
+  ParallelFor(0, 4, [&called](size_t) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(ParallelForTest, SingleThreadRunsInOrder) {
+  std::vector<size_t> order;
+  ParallelFor(5, 1, [&order](size_t i) { order.push_back(i); });
+  EXPECT_THAT(order, ::testing::ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(ParallelForTest, ZeroThreadsRunsInOrder) {
+  std::vector<size_t> order;
+  ParallelFor(3, 0, [&order](size_t i) { order.push_back(i); });
+  EXPECT_THAT(order, ::testing::ElementsAre(0, 1, 2));
+}
+
+TEST(ParallelForTest, EveryIndexVisitedOnce) {
+  std::vector<int> visits(1000, 0);
+  ParallelFor(visits.size(), 8, [&visits](size_t i) { ++visits[i]; });
+  EXPECT_THAT(visits, Each(1));
+}
+
+TEST(ParallelForTest, MoreThreadsThanWork) {
+  std::vector<int> visits(3, 0);
+  ParallelFor(visits.size(), 16, [&visits](size_t i) { ++visits[i]; });
+  EXPECT_THAT(visits, Each(1));
+}
+
+TEST(HardwareConcurrencyTest, AtLeastOne) {
+  EXPECT_GE(HardwareConcurrency(), 1u);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
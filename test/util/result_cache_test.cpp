@@ -0,0 +1,105 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "source/util/result_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+using ::testing::ElementsAre;
+
+// The entries are written to the working directory of the test, and removed
+// by the fixture.
+class ResultCacheTest : public ::testing::Test {
+ protected:
+  ResultCacheEntry MakeEntry(const std::string& config,
+                             const std::vector<uint32_t>& module) {
+    ResultCacheEntry entry(".", config, module.data(), module.size());
+    paths_.push_back(entry.path());
+    return entry;
+  }
+
+  void TearDown() override {
+    for (const std::string& path : paths_) std::remove(path.c_str());
+  }
+
+ private:
+  std::vector<std::string> paths_;
+};
+
+TEST_F(ResultCacheTest, MissThenHit) {
+  const std::vector<uint32_t> module = {0x07230203, 1, 2, 3};
+  std::vector<uint32_t> result = {42};
+  EXPECT_FALSE(MakeEntry("MissThenHit", module).Load(&result));
+  EXPECT_THAT(result, ElementsAre(42u));
+
+  MakeEntry("MissThenHit", module).Store({4, 5, 6});
+  EXPECT_TRUE(MakeEntry("MissThenHit", module).Load(&result));
+  EXPECT_THAT(result, ElementsAre(4u, 5u, 6u));
+}
+
+TEST_F(ResultCacheTest, EmptyResult) {
+  const std::vector<uint32_t> module = {0x07230203, 7};
+  MakeEntry("EmptyResult", module).Store({});
+  std::vector<uint32_t> result = {1};
+  EXPECT_TRUE(MakeEntry("EmptyResult", module).Load(&result));
+  EXPECT_TRUE(result.empty());
+}
+
+TEST_F(ResultCacheTest, KeyedByConfigAndModule) {
+  const std::vector<uint32_t> module = {0x07230203, 1, 2, 3};
+  MakeEntry("KeyedByConfigAndModule", module).Store({4});
+
+  std::vector<uint32_t> result;
+  EXPECT_FALSE(MakeEntry("KeyedByConfigAndModule2", module).Load(&result));
+  EXPECT_FALSE(
+      MakeEntry("KeyedByConfigAndModule", {0x07230203, 1, 2, 4}).Load(&result));
+  EXPECT_FALSE(
+      MakeEntry("KeyedByConfigAndModule", {0x07230203, 1, 2}).Load(&result));
+  EXPECT_TRUE(MakeEntry("KeyedByConfigAndModule", module).Load(&result));
+}
+
+TEST_F(ResultCacheTest, CorruptEntryIsAMiss) {
+  const std::vector<uint32_t> module = {0x07230203, 9};
+  ResultCacheEntry entry = MakeEntry("CorruptEntryIsAMiss", module);
+  {
+    std::ofstream file(entry.path(), std::ios::binary);
+    file << "not a cache entry";
+  }
+  std::vector<uint32_t> result;
+  EXPECT_FALSE(entry.Load(&result));
+
+  {
+    std::ofstream file(entry.path(), std::ios::binary);
+    file << "not an entry";  // A whole number of words.
+  }
+  EXPECT_FALSE(entry.Load(&result));
+
+  // Storing replaces the corrupt entry.
+  entry.Store({1, 2});
+  EXPECT_TRUE(entry.Load(&result));
+  EXPECT_THAT(result, ElementsAre(1u, 2u));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace spvtools
@@ -667,6 +667,19 @@ TEST(SmallVectorTest, Pop_back_TestDestructor) {
   EXPECT_EQ(num_dtors, num_ctors);
 }
 
+TEST(SmallVectorTest, ElementsFollowTheVectorWhenItIsRelocated) {
+  std::vector<SmallVector<uint32_t, 2>> vectors;
+  vectors.emplace_back(std::vector<uint32_t>{1, 2});
+  vectors.emplace_back(std::vector<uint32_t>{3});
+  // Make the outer vector move its elements to new storage.
+  vectors.reserve(vectors.capacity() * 2);
+  vectors[0][1] = 4;
+
+  EXPECT_EQ(vectors[0], std::vector<uint32_t>({1, 4}));
+  EXPECT_EQ(vectors[1], std::vector<uint32_t>({3}));
+  EXPECT_EQ(vectors[0].data() + 2, vectors[0].end());
+}
+
 }  // namespace
 }  // namespace utils
 }  // namespace spvtools
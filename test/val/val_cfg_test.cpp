@@ -4585,6 +4585,59 @@ OpFunctionEnd
                 "does not structurally dominate the back-edge block 8[%8]"));
 }
 
+// Returns a function of three selections, each nested in the then branch of
+// the previous one, with |use| in the merge block of the outermost selection.
+std::string GetNestedSelections(const std::string& use) {
+  return R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%bool = OpTypeBool
+%uint = OpTypeInt 32 0
+%true = OpConstantTrue %bool
+%one = OpConstant %uint 1
+%void_fn = OpTypeFunction %void
+%func = OpFunction %void None %void_fn
+%h0 = OpLabel
+%x0 = OpCopyObject %uint %one
+OpSelectionMerge %m0 None
+OpBranchConditional %true %h1 %m0
+%h1 = OpLabel
+%x1 = OpIAdd %uint %x0 %one
+OpSelectionMerge %m1 None
+OpBranchConditional %true %h2 %m1
+%h2 = OpLabel
+%x2 = OpIAdd %uint %x1 %x0
+OpSelectionMerge %m2 None
+OpBranchConditional %true %h3 %m2
+%h3 = OpLabel
+%x3 = OpIAdd %uint %x2 %x0
+OpBranch %m2
+%m2 = OpLabel
+OpBranch %m1
+%m1 = OpLabel
+OpBranch %m0
+%m0 = OpLabel
+)" + use + R"(
+OpReturn
+OpFunctionEnd
+)";
+}
+
+TEST_F(ValidateCFG, NestedSelectionsUseOfOuterDefinition) {
+  CompileSuccessfully(GetNestedSelections("%y = OpIAdd %uint %x0 %one"));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateCFG, NestedSelectionsUseOfInnerDefinitionBad) {
+  CompileSuccessfully(GetNestedSelections("%y = OpIAdd %uint %x3 %one"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("ID 18[%x3] defined in block 17[%h3] does not "
+                        "dominate its use in block 10[%m0]"));
+}
+
 }  // namespace
 }  // namespace val
 }  // namespace spvtools
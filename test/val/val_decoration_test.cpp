@@ -6327,6 +6327,45 @@ OpFunctionEnd
                         "stride 4 not satisfying alignment to 16"));
 }
 
+TEST_F(ValidateDecorations, StructSharedByBuffersIsCheckedForEachLayout) {
+  const std::string spirv = R"(
+OpCapability Shader
+OpExtension "SPV_KHR_storage_buffer_storage_class"
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+OpDecorate %struct Block
+OpMemberDecorate %struct 0 Offset 0
+OpDecorate %array ArrayStride 4
+OpDecorate %ssbo DescriptorSet 0
+OpDecorate %ssbo Binding 0
+OpDecorate %ubo DescriptorSet 0
+OpDecorate %ubo Binding 1
+%void = OpTypeVoid
+%int = OpTypeInt 32 0
+%int_4 = OpConstant %int 4
+%array = OpTypeArray %int %int_4
+%struct = OpTypeStruct %array
+%ptr_ssbo = OpTypePointer StorageBuffer %struct
+%ssbo = OpVariable %ptr_ssbo StorageBuffer
+%ptr_ubo = OpTypePointer Uniform %struct
+%ubo = OpVariable %ptr_ubo Uniform
+%void_fn = OpTypeFunction %void
+%main = OpFunction %void None %void_fn
+%entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+
+  CompileSuccessfully(spirv, SPV_ENV_VULKAN_1_0);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions(SPV_ENV_VULKAN_1_0));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Structure id 2 decorated as Block for variable in "
+                        "Uniform storage class must follow standard uniform "
+                        "buffer layout rules: member 0 contains an array with "
+                        "stride 4 not satisfying alignment to 16"));
+}
+
 TEST_F(ValidateDecorations, ImproperStraddleInArray) {
   const std::string spirv = R"(
 OpCapability Shader
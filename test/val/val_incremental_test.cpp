@@ -0,0 +1,194 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests for the validation of modules that are edits of each other.
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "source/val/validate.h"
+#include "spirv-tools/libspirv.hpp"
+#include "test/unit_spirv.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+using ::testing::HasSubstr;
+
+const spv_target_env kEnv = SPV_ENV_UNIVERSAL_1_3;
+
+const char kGlobals[] = R"(
+     OpCapability Shader
+     OpCapability Linkage
+     OpMemoryModel Logical GLSL450
+     %void = OpTypeVoid
+     %fn = OpTypeFunction %void
+     %uint = OpTypeInt 32 0
+     %bool = OpTypeBool
+     %one = OpConstant %uint 1
+)";
+
+const char kFirstFunction[] = R"(
+     %f1 = OpFunction %void None %fn
+     %f1_entry = OpLabel
+     %a = OpIAdd %uint %one %one
+     OpReturn
+     OpFunctionEnd
+)";
+
+const char kSecondFunction[] = R"(
+     %f2 = OpFunction %void None %fn
+     %f2_entry = OpLabel
+     OpReturn
+     OpFunctionEnd
+)";
+
+const char kSecondFunctionWithTwoBlocks[] = R"(
+     %f2 = OpFunction %void None %fn
+     %f2_entry = OpLabel
+     OpBranch %f2_exit
+     %f2_exit = OpLabel
+     OpReturn
+     OpFunctionEnd
+)";
+
+// %b is defined on one side of a selection and used on the other.
+const char kSecondFunctionWithBadDominance[] = R"(
+     %f2 = OpFunction %void None %fn
+     %f2_entry = OpLabel
+     %cond = OpULessThan %bool %one %one
+     OpSelectionMerge %f2_exit None
+     OpBranchConditional %cond %f2_true %f2_false
+     %f2_true = OpLabel
+     %b = OpIAdd %uint %one %one
+     OpBranch %f2_exit
+     %f2_false = OpLabel
+     %c = OpIAdd %uint %b %one
+     OpBranch %f2_exit
+     %f2_exit = OpLabel
+     OpReturn
+     OpFunctionEnd
+)";
+
+// Uses %a, an id of the first function.
+const char kSecondFunctionUsingFirst[] = R"(
+     %f2 = OpFunction %void None %fn
+     %f2_entry = OpLabel
+     %d = OpIAdd %uint %a %one
+     OpReturn
+     OpFunctionEnd
+)";
+
+class ValidateIncremental : public ::testing::Test {
+ protected:
+  ValidateIncremental() : validator_(kEnv, options_) {}
+
+  std::vector<uint32_t> Assemble(const std::string& text) {
+    SpirvTools tools(kEnv);
+    std::vector<uint32_t> binary;
+    EXPECT_TRUE(tools.Assemble(text, &binary,
+                               SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS));
+    return binary;
+  }
+
+  // Validates |text| with |validator_| and expects the same result and
+  // diagnostic as a full validation.
+  spv_result_t Validate(const std::string& text) {
+    const std::vector<uint32_t> binary = Assemble(text);
+    spv_diagnostic diagnostic = nullptr;
+    const spv_result_t result =
+        validator_.Validate(binary.data(), binary.size(), &diagnostic);
+
+    spv_context context = spvContextCreate(kEnv);
+    spv_const_binary_t full_binary = {binary.data(), binary.size()};
+    spv_diagnostic full_diagnostic = nullptr;
+    EXPECT_EQ(spvValidateWithOptions(context, options_, &full_binary,
+                                     &full_diagnostic),
+              result);
+    EXPECT_EQ(full_diagnostic == nullptr, diagnostic == nullptr);
+    if (diagnostic && full_diagnostic) {
+      EXPECT_STREQ(full_diagnostic->error, diagnostic->error);
+      diagnostic_ = diagnostic->error;
+    }
+    spvDiagnosticDestroy(full_diagnostic);
+    spvDiagnosticDestroy(diagnostic);
+    spvContextDestroy(context);
+    return result;
+  }
+
+  ValidatorOptions options_;
+  IncrementalValidator validator_;
+  std::string diagnostic_;
+};
+
+TEST_F(ValidateIncremental, UnchangedFunctionIsNotCheckedAgain) {
+  EXPECT_EQ(SPV_SUCCESS,
+            Validate(std::string(kGlobals) + kFirstFunction + kSecondFunction));
+  EXPECT_EQ(0u, validator_.num_unchanged_functions());
+
+  EXPECT_EQ(SPV_SUCCESS, Validate(std::string(kGlobals) + kFirstFunction +
+                                  kSecondFunctionWithTwoBlocks));
+  EXPECT_EQ(1u, validator_.num_unchanged_functions());
+}
+
+TEST_F(ValidateIncremental, EditedFunctionIsCheckedAgain) {
+  EXPECT_EQ(SPV_SUCCESS,
+            Validate(std::string(kGlobals) + kFirstFunction + kSecondFunction));
+
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, Validate(std::string(kGlobals) +
+                                           kFirstFunction +
+                                           kSecondFunctionWithBadDominance));
+  EXPECT_EQ(1u, validator_.num_unchanged_functions());
+  EXPECT_THAT(diagnostic_, HasSubstr("does not dominate its use"));
+}
+
+TEST_F(ValidateIncremental, FunctionSharingIdsIsCheckedAgain) {
+  EXPECT_EQ(SPV_SUCCESS,
+            Validate(std::string(kGlobals) + kFirstFunction + kSecondFunction));
+
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, Validate(std::string(kGlobals) +
+                                           kFirstFunction +
+                                           kSecondFunctionUsingFirst));
+  EXPECT_EQ(0u, validator_.num_unchanged_functions());
+}
+
+TEST_F(ValidateIncremental, ChangedGlobalsAreCheckedInFull) {
+  EXPECT_EQ(SPV_SUCCESS,
+            Validate(std::string(kGlobals) + kFirstFunction + kSecondFunction));
+
+  EXPECT_EQ(SPV_SUCCESS, Validate(std::string(kGlobals) +
+                                  "%float = OpTypeFloat 32\n" +
+                                  kFirstFunction + kSecondFunction));
+  EXPECT_EQ(0u, validator_.num_unchanged_functions());
+}
+
+TEST_F(ValidateIncremental, InvalidModuleIsNotKept) {
+  EXPECT_EQ(SPV_SUCCESS,
+            Validate(std::string(kGlobals) + kFirstFunction + kSecondFunction));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, Validate(std::string(kGlobals) +
+                                           kFirstFunction +
+                                           kSecondFunctionWithBadDominance));
+
+  // The module is compared with the last valid one, where both functions are
+  // the same.
+  EXPECT_EQ(SPV_SUCCESS,
+            Validate(std::string(kGlobals) + kFirstFunction + kSecondFunction));
+  EXPECT_EQ(2u, validator_.num_unchanged_functions());
+}
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
@@ -0,0 +1,94 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests that the checks of individual instructions agree with the opcodes
+// they are dispatched for.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "source/table.h"
+#include "source/val/instruction.h"
+#include "source/val/validate.h"
+#include "source/val/validation_state.h"
+
+namespace spvtools {
+namespace val {
+namespace {
+
+// This is all we need for these tests.
+uint32_t kFakeBinary[] = {0};
+
+class OpcodeChecksTest : public testing::Test {
+ public:
+  OpcodeChecksTest()
+      : context_(spvContextCreate(SPV_ENV_UNIVERSAL_1_0)),
+        options_(spvValidatorOptionsCreate()) {
+    SetContextMessageConsumer(
+        context_, [this](spv_message_level_t, const char*,
+                         const spv_position_t&, const char* message) {
+          messages_.push_back(message);
+        });
+  }
+
+  ~OpcodeChecksTest() override {
+    spvContextDestroy(context_);
+    spvValidatorOptionsDestroy(options_);
+  }
+
+ protected:
+  spv_context context_;
+  spv_validator_options options_;
+  std::vector<std::string> messages_;
+};
+
+// Each check is given an instruction without operands for every opcode of
+// the grammar its predicate rejects.  A check that acts on such an opcode
+// reports a diagnostic, fails, or throws when it looks up an operand, so
+// this fails when a check handles an opcode that it is never dispatched
+// for.
+TEST_F(OpcodeChecksTest, ChecksIgnoreTheOpcodesTheyAreNotDispatchedFor) {
+  spv_opcode_table opcodes = nullptr;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&opcodes, SPV_ENV_UNIVERSAL_1_0));
+
+  const std::vector<InstructionCheck>& checks = OpcodeChecks();
+  for (size_t i = 0; i < checks.size(); ++i) {
+    for (uint32_t e = 0; e < opcodes->count; ++e) {
+      const SpvOp opcode = opcodes->entries[e].opcode;
+      if (checks[i].checks_opcode(opcode)) continue;
+
+      ValidationState_t state(context_, options_, kFakeBinary, 0, 1);
+      const uint32_t word = (1u << 16) | opcode;
+      spv_parsed_instruction_t parsed = {};
+      parsed.words = &word;
+      parsed.num_words = 1;
+      parsed.opcode = static_cast<uint16_t>(opcode);
+      const Instruction inst(&parsed);
+      messages_.clear();
+      spv_result_t result = SPV_SUCCESS;
+      EXPECT_NO_THROW(result = checks[i].check(state, &inst))
+          << "check " << i << " on Op" << spvOpcodeString(opcode);
+      EXPECT_EQ(SPV_SUCCESS, result)
+          << "check " << i << " on Op" << spvOpcodeString(opcode);
+      EXPECT_TRUE(messages_.empty())
+          << "check " << i << " on Op" << spvOpcodeString(opcode) << ": "
+          << (messages_.empty() ? "" : messages_.front());
+    }
+  }
+}
+
+}  // namespace
+}  // namespace val
+}  // namespace spvtools
@@ -1131,6 +1131,60 @@ TEST_F(ValidateSSA, IdDoesNotDominateItsUseBad) {
                    "  %false_block = OpLabel\n"));
 }
 
+// Returns a function whose ids are prefixed with |name|. Unless |good| is
+// true, the function uses an id in a block its definition does not dominate.
+std::string SelectionFunction(const std::string& name, bool good) {
+  std::string str = R"(
+%NAME_func  = OpFunction %voidt None %vfunct
+%NAME_entry = OpLabel
+%NAME_cond  = OpSLessThan %boolt %one %ten
+              OpSelectionMerge %NAME_merge None
+              OpBranchConditional %NAME_cond %NAME_true %NAME_false
+%NAME_true  = OpLabel
+%NAME_def   = OpIAdd %uintt %one %ten
+              OpBranch %NAME_merge
+%NAME_false = OpLabel
+%NAME_use   = OpIAdd %uintt USE %ten
+              OpBranch %NAME_merge
+%NAME_merge = OpLabel
+              OpReturn
+              OpFunctionEnd
+)";
+  auto replace_all = [&str](const std::string& from, const std::string& to) {
+    for (size_t pos = str.find(from); pos != std::string::npos;
+         pos = str.find(from, pos + to.size())) {
+      str.replace(pos, from.size(), to);
+    }
+  };
+  replace_all("USE", good ? "%one" : "%NAME_def");
+  replace_all("NAME", name);
+  return str;
+}
+
+TEST_F(ValidateSSA, ThreadedManyFunctionsGood) {
+  std::string str = kHeader + kBasicTypes;
+  for (int i = 0; i < 16; ++i) {
+    str += SelectionFunction("f" + std::to_string(i), true);
+  }
+  CompileSuccessfully(str);
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateSSA, ThreadedReportsFirstErrorInModuleOrder) {
+  std::string names;
+  std::string functions;
+  for (int i = 0; i < 16; ++i) {
+    const std::string name = "f" + std::to_string(i);
+    names += "OpName %" + name + "_def \"" + name + "_def\"\n";
+    functions += SelectionFunction(name, i != 5 && i != 11);
+  }
+  CompileSuccessfully(kHeader + names + kBasicTypes + functions);
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("[%f5_def] defined in block"));
+}
+
 TEST_F(ValidateSSA, PhiUseDoesntDominateDefinitionGood) {
   std::string str = kHeader + kBasicTypes +
                     R"(
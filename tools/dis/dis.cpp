@@ -14,11 +14,14 @@
 
 #if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
 #include <stdio.h>  // Need fileno
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
+#include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -64,6 +67,64 @@ Options:
 
 static const auto kDefaultEnvironment = SPV_ENV_UNIVERSAL_1_5;
 
+// How the disassembly is written to the output file.
+enum class OutputMethod {
+  // The file does not exist.  It is created, and removed again if the
+  // disassembly fails.
+  kCreate,
+  // The file is a regular file of ours.  A temporary file next to it is
+  // renamed over it once all of the text was written, so that it is neither
+  // truncated nor removed when the input is invalid.
+  kReplace,
+  // Anything else, such as a device, a pipe, a link or a file owned by
+  // someone else, is written in place.
+  kInPlace,
+};
+
+// Returns how to write the output file |path|.  For kReplace, sets |*mode| to
+// the permissions of the file, which the temporary file is given.
+static OutputMethod ChooseOutputMethod(const char* path, unsigned* mode) {
+#if defined(_POSIX_VERSION)
+  struct stat status;
+  if (lstat(path, &status) != 0) {
+    return errno == ENOENT ? OutputMethod::kCreate : OutputMethod::kInPlace;
+  }
+  if (!S_ISREG(status.st_mode) || status.st_nlink != 1 ||
+      status.st_uid != geteuid() || status.st_gid != getegid()) {
+    return OutputMethod::kInPlace;
+  }
+  *mode = status.st_mode & 07777;
+  return OutputMethod::kReplace;
+#else
+  // rename does not replace an existing file on Windows, so it is only
+  // used on POSIX systems.
+  (void)mode;
+  if (FILE* file = fopen(path, "r")) {
+    fclose(file);
+    return OutputMethod::kInPlace;
+  }
+  return OutputMethod::kCreate;
+#endif
+}
+
+// Creates a file next to |path| that did not exist before, so that neither
+// an existing file nor another run writing to the same |path| is clobbered.
+// Returns the file opened for writing and sets |*temporary_path| to its name,
+// or returns nullptr if no such file could be created.
+static FILE* CreateTemporaryFile(const std::string& path,
+                                 std::string* temporary_path) {
+  std::random_device generator;
+  for (int attempt = 0; attempt < 100; ++attempt) {
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), ".%08x.tmp", generator());
+    *temporary_path = path + suffix;
+    // The "x" mode fails if the file already exists.
+    if (FILE* file = fopen(temporary_path->c_str(), "wx")) return file;
+    if (errno != EEXIST) break;
+  }
+  return nullptr;
+}
+
 int main(int argc, char** argv) {
   const char* inFile = nullptr;
   const char* outFile = nullptr;
@@ -179,24 +240,85 @@ int main(int argc, char** argv) {
   }
 
   // Read the input binary.
-  std::vector<uint32_t> contents;
-  if (!ReadBinaryFile<uint32_t>(inFile, &contents)) return 1;
+  MappedBinaryFile contents;
+  if (!contents.Open(inFile)) return 1;
 
   // If printing to standard output, then spvBinaryToText should
   // do the printing.  In particular, colour printing on Windows is
   // controlled by modifying console objects synchronously while
   // outputting to the stream rather than by injecting escape codes
   // into the output stream.
-  // If the printing option is off, then save the text in memory, so
-  // it can be emitted later in this function.
+  // If the printing option is off, then stream the text to the output file
+  // as it is produced, so that all of it is never held in memory.
   const bool print_to_stdout = SPV_BINARY_TO_TEXT_OPTION_PRINT & options;
-  spv_text text = nullptr;
-  spv_text* textOrNull = print_to_stdout ? nullptr : &text;
   spv_diagnostic diagnostic = nullptr;
   spv_context context = spvContextCreate(kDefaultEnvironment);
-  spv_result_t error =
-      spvBinaryToText(context, contents.data(), contents.size(), options,
-                      textOrNull, &diagnostic);
+  spv_result_t error = SPV_SUCCESS;
+  if (print_to_stdout) {
+    error = spvBinaryToText(context, contents.data(), contents.size(), options,
+                            nullptr, &diagnostic);
+  } else {
+    struct Output {
+      FILE* file;
+      bool failed;
+    };
+    auto write = [](void* user_data, const char* text, size_t length) {
+      Output* out = static_cast<Output*>(user_data);
+      if (fwrite(text, 1, length, out->file) == length) return SPV_SUCCESS;
+      out->failed = true;
+      return SPV_ERROR_INTERNAL;
+    };
+    unsigned mode = 0;
+    OutputMethod method = ChooseOutputMethod(outFile, &mode);
+    std::string temporary_path;
+    Output output = {nullptr, false};
+    if (method == OutputMethod::kReplace) {
+      output.file = CreateTemporaryFile(outFile, &temporary_path);
+#if defined(_POSIX_VERSION)
+      if (output.file &&
+          fchmod(fileno(output.file), static_cast<mode_t>(mode)) != 0) {
+        fclose(output.file);
+        remove(temporary_path.c_str());
+        output.file = nullptr;
+      }
+#endif
+      // Without write access to the directory, the file is written in place.
+      if (output.file == nullptr) method = OutputMethod::kInPlace;
+    }
+    if (method != OutputMethod::kReplace) {
+      output.file = fopen(outFile, "w");
+    }
+    if (output.file == nullptr) {
+      fprintf(stderr, "error: could not open file '%s'\n", outFile);
+      spvContextDestroy(context);
+      return 1;
+    }
+    error = spvBinaryToTextStream(context, contents.data(), contents.size(),
+                                  options, write, &output, &diagnostic);
+    // Data may still be buffered, so closing can fail as a write does.
+    if (fclose(output.file) != 0) output.failed = true;
+    if (output.failed) {
+      fprintf(stderr, "error: could not write to file '%s'\n", outFile);
+    }
+    if (error || output.failed) {
+      if (method == OutputMethod::kReplace) {
+        remove(temporary_path.c_str());
+      } else if (method == OutputMethod::kCreate) {
+        remove(outFile);
+      }
+      if (!error) {
+        spvContextDestroy(context);
+        return 1;
+      }
+    } else if (method == OutputMethod::kReplace) {
+      if (rename(temporary_path.c_str(), outFile) != 0) {
+        fprintf(stderr, "error: could not write to file '%s'\n", outFile);
+        remove(temporary_path.c_str());
+        spvContextDestroy(context);
+        return 1;
+      }
+    }
+  }
   spvContextDestroy(context);
   if (error) {
     spvDiagnosticPrint(diagnostic);
@@ -204,13 +326,5 @@ int main(int argc, char** argv) {
     return error;
   }
 
-  if (!print_to_stdout) {
-    if (!WriteFile<char>(outFile, "w", text->str, text->length)) {
-      spvTextDestroy(text);
-      return 1;
-    }
-  }
-  spvTextDestroy(text);
-
   return 0;
 }
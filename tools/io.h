@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <string>
 #include <vector>
 
 #if defined(SPIRV_WINDOWS)
@@ -37,6 +38,25 @@
 #define SET_STDOUT_MODE(mode)
 #endif
 
+#if (defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))) && \
+    !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPIRV_TOOLS_IO_HAS_MMAP 1
+#endif
+
+// Reports the error |message|: sets |*error| to it if |error| is not nullptr,
+// and writes it to standard error otherwise.
+inline void ReportFileError(const std::string& message, std::string* error) {
+  if (error) {
+    *error = message;
+  } else {
+    fprintf(stderr, "error: %s\n", message.c_str());
+  }
+}
+
 // Appends the contents of the |file| to |data|, assuming each element in the
 // file is of type |T|.
 template <typename T>
@@ -51,26 +71,28 @@ void ReadFile(FILE* file, std::vector<T>* data) {
 }
 
 // Returns true if |file| has encountered an error opening the file or reading
-// the file as a series of element of type |T|. If there was an error, writes an
-// error message to standard error.
+// the file as a series of element of type |T|. If there was an error, reports
+// it as ReportFileError does.
 template <class T>
-bool WasFileCorrectlyRead(FILE* file, const char* filename) {
+bool WasFileCorrectlyRead(FILE* file, const char* filename,
+                          std::string* error = nullptr) {
+  const std::string name = filename ? filename : "-";
   if (file == nullptr) {
-    fprintf(stderr, "error: file does not exist '%s'\n", filename);
+    ReportFileError("file does not exist '" + name + "'", error);
     return false;
   }
 
   if (ftell(file) == -1L) {
     if (ferror(file)) {
-      fprintf(stderr, "error: error reading file '%s'\n", filename);
+      ReportFileError("error reading file '" + name + "'", error);
       return false;
     }
   } else {
     if (sizeof(T) != 1 && (ftell(file) % sizeof(T))) {
-      fprintf(
-          stderr,
-          "error: file size should be a multiple of %zd; file '%s' corrupt\n",
-          sizeof(T), filename);
+      ReportFileError("file size should be a multiple of " +
+                          std::to_string(sizeof(T)) + "; file '" + name +
+                          "' corrupt",
+                      error);
       return false;
     }
   }
@@ -80,10 +102,11 @@ bool WasFileCorrectlyRead(FILE* file, const char* filename) {
 // Appends the contents of the file named |filename| to |data|, assuming
 // each element in the file is of type |T|. The file is opened as a binary file
 // If |filename| is nullptr or "-", reads from the standard input, but
-// reopened as a binary file. If any error occurs, writes error messages to
-// standard error and returns false.
+// reopened as a binary file. If any error occurs, reports it as
+// ReportFileError does and returns false.
 template <typename T>
-bool ReadBinaryFile(const char* filename, std::vector<T>* data) {
+bool ReadBinaryFile(const char* filename, std::vector<T>* data,
+                    std::string* error = nullptr) {
   const bool use_file = filename && strcmp("-", filename);
   FILE* fp = nullptr;
   if (use_file) {
@@ -94,7 +117,7 @@ bool ReadBinaryFile(const char* filename, std::vector<T>* data) {
   }
 
   ReadFile(fp, data);
-  bool succeeded = WasFileCorrectlyRead<T>(fp, filename);
+  bool succeeded = WasFileCorrectlyRead<T>(fp, filename, error);
   if (use_file && fp) fclose(fp);
   return succeeded;
 }
@@ -122,6 +145,91 @@ bool ReadTextFile(const char* filename, std::vector<T>* data) {
 }
 
 namespace {
+// A read-only view of the contents of a binary file as a sequence of words.
+// On POSIX systems a regular file is memory-mapped, so its contents are never
+// copied and only the pages that are touched are read.  Otherwise, and for
+// standard input, the contents are read into memory as by ReadBinaryFile.
+class MappedBinaryFile {
+ public:
+  MappedBinaryFile() : words_(nullptr), num_words_(0), mapped_bytes_(0) {}
+  ~MappedBinaryFile() { Unmap(); }
+
+  MappedBinaryFile(const MappedBinaryFile&) = delete;
+  MappedBinaryFile& operator=(const MappedBinaryFile&) = delete;
+
+  // Makes this a view of the file named |filename|, or of the standard input
+  // if |filename| is nullptr or "-".  If any error occurs, reports it as
+  // ReportFileError does and returns false.
+  bool Open(const char* filename, std::string* error = nullptr) {
+    Unmap();
+    contents_.clear();
+    words_ = nullptr;
+    num_words_ = 0;
+#if defined(SPIRV_TOOLS_IO_HAS_MMAP)
+    if (filename && strcmp("-", filename)) {
+      const int fd = open(filename, O_RDONLY);
+      if (fd == -1) {
+        ReportFileError(std::string("file does not exist '") + filename + "'",
+                        error);
+        return false;
+      }
+      struct stat info;
+      // Pipes, devices and empty files cannot be mapped; read them instead.
+      if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        const size_t size = static_cast<size_t>(info.st_size);
+        if (size % sizeof(uint32_t)) {
+          ReportFileError("file size should be a multiple of " +
+                              std::to_string(sizeof(uint32_t)) + "; file '" +
+                              filename + "' corrupt",
+                          error);
+          close(fd);
+          return false;
+        }
+        void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) {
+          ReportFileError(std::string("error reading file '") + filename + "'",
+                          error);
+          return false;
+        }
+        words_ = static_cast<const uint32_t*>(map);
+        num_words_ = size / sizeof(uint32_t);
+        mapped_bytes_ = size;
+        return true;
+      }
+      close(fd);
+    }
+#endif
+    if (!ReadBinaryFile<uint32_t>(filename, &contents_, error)) return false;
+    words_ = contents_.data();
+    num_words_ = contents_.size();
+    return true;
+  }
+
+  // Returns the words of the file.  They stay valid until the next call to
+  // Open or the destruction of this object.
+  const uint32_t* data() const { return words_; }
+
+  // Returns the number of words in the file.
+  size_t size() const { return num_words_; }
+
+ private:
+  void Unmap() {
+#if defined(SPIRV_TOOLS_IO_HAS_MMAP)
+    if (mapped_bytes_) {
+      munmap(const_cast<uint32_t*>(words_), mapped_bytes_);
+      mapped_bytes_ = 0;
+    }
+#endif
+  }
+
+  const uint32_t* words_;
+  size_t num_words_;
+  // The size of the mapping, or 0 if the contents were read.
+  size_t mapped_bytes_;
+  std::vector<uint32_t> contents_;
+};
+
 // A class to create and manage a file for outputting data.
 class OutputFile {
  public:
@@ -162,20 +270,21 @@ class OutputFile {
 // Writes the given |data| into the file named as |filename| using the given
 // |mode|, assuming |data| is an array of |count| elements of type |T|. If
 // |filename| is nullptr or "-", writes to standard output. If any error occurs,
-// returns false and outputs error message to standard error.
+// returns false and reports it as ReportFileError does.
 template <typename T>
 bool WriteFile(const char* filename, const char* mode, const T* data,
-               size_t count) {
+               size_t count, std::string* error = nullptr) {
+  const std::string name = filename ? filename : "-";
   OutputFile file(filename, mode);
   FILE* fp = file.GetFileHandle();
   if (fp == nullptr) {
-    fprintf(stderr, "error: could not open file '%s'\n", filename);
+    ReportFileError("could not open file '" + name + "'", error);
     return false;
   }
 
   size_t written = fwrite(data, sizeof(T), count, fp);
   if (count != written) {
-    fprintf(stderr, "error: could not write to file '%s'\n", filename);
+    ReportFileError("could not write to file '" + name + "'", error);
     return false;
   }
 
@@ -20,14 +20,17 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "source/opt/log.h"
 #include "source/spirv_target_env.h"
+#include "source/util/parse_number.h"
 #include "source/util/string_utils.h"
 #include "spirv-tools/libspirv.hpp"
 #include "spirv-tools/optimizer.hpp"
 #include "tools/io.h"
+#include "tools/util/batch.h"
 #include "tools/util/cli_consumer.h"
 
 namespace {
@@ -40,6 +43,20 @@ struct OptStatus {
   int code;
 };
 
+// Options for optimizing many binaries in one invocation.
+struct BatchOptions {
+  // The file listing the binaries to optimize, or nullptr to optimize a
+  // single input.
+  const char* list_file = nullptr;
+  // The number of binaries optimized at once, or 0 for one per hardware
+  // thread.
+  uint32_t num_jobs = 0;
+  // The last flag given that cannot be used with a batch, or nullptr.  Such
+  // flags print to standard error, where the output for the binaries would
+  // interleave, or name a file that every binary would share.
+  const char* unbatchable_flag = nullptr;
+};
+
 // Message consumer for this tool.  Used to emit diagnostics during
 // initialization and setup. Note that |source| and |position| are irrelevant
 // here because we are still not processing a SPIR-V input file.
@@ -51,6 +68,35 @@ void opt_diagnostic(spv_message_level_t level, const char* /*source*/,
   fprintf(stderr, "%s\n", message);
 }
 
+// Parses the value of the numeric flag |flag|, of the form --<name>=<value>,
+// into |*value|.  Emits an error and returns false if the value is not a
+// non-negative number that fits.
+bool ParseUnsignedFlag(const char* flag, uint32_t* value) {
+  const auto split_flag = spvtools::utils::SplitFlagArgs(flag);
+  if (!spvtools::utils::ParseNumber(split_flag.second.c_str(), value)) {
+    spvtools::Error(opt_diagnostic, nullptr, {},
+                    ("Invalid value passed to --" + split_flag.first).c_str());
+    return false;
+  }
+  return true;
+}
+
+// Prints the |metrics| of a pass to standard error output as one line of JSON.
+// Pass names are plain identifiers, so they need no escaping.
+void PrintPassMetricsAsJson(const spv_pass_metrics_t& metrics) {
+  std::ostringstream line;
+  line << "{\"pass\":\"" << metrics.pass_name << "\""
+       << ",\"wall_time\":" << metrics.wall_time
+       << ",\"cpu_time\":" << metrics.cpu_time
+       << ",\"peak_rss_delta_kb\":" << metrics.peak_rss_delta
+       << ",\"insts_before\":" << metrics.num_insts_before
+       << ",\"insts_after\":" << metrics.num_insts_after
+       << ",\"analyses_invalidated\":" << metrics.num_analyses_invalidated
+       << ",\"analyses_built\":" << metrics.num_analyses_built
+       << ",\"changed\":" << (metrics.changed ? "true" : "false") << "}\n";
+  std::cerr << line.str();
+}
+
 std::string GetListOfPassesAsString(const spvtools::Optimizer& optimizer) {
   std::stringstream ss;
   for (const auto& name : optimizer.GetPassNames()) {
@@ -86,26 +132,67 @@ void PrintUsage(const char* program) {
       R"(%s - Optimize a SPIR-V binary file.
 
 USAGE: %s [options] [<input>] -o <output>
+       %s [options] --batch=<listfile> -o <directory>
 
 The SPIR-V binary is read from <input>. If no file is specified,
 or if <input> is "-", then the binary is read from standard input.
 if <output> is "-", then the optimized output is written to
 standard output.
 
+With --batch, every binary named in <listfile>, one per line, is
+optimized with the same options, and written to <directory> under
+its own file name.
+
 NOTE: The optimizer is a work in progress.
 
 Options (in lexicographical order):)",
-      program, program);
+      program, program, program);
   printf(R"(
   --amd-ext-to-khr
                Replaces the extensions VK_AMD_shader_ballot, VK_AMD_gcn_shader,
                and VK_AMD_shader_trinary_minmax with equivalent code using core
                instructions and capabilities.)");
   printf(R"(
+  --analysis-report
+               Print to standard error output, after the last pass, how many
+               times each analysis was built and how long that took. Each
+               build is charged to the pass that last invalidated the
+               analysis, the most expensive first.)");
+  printf(R"(
+  --analysis-snapshot=<file>
+               Reads the dominator and postdominator trees of the input from
+               <file>, if it was written for the same binary, and then
+               replaces <file> with the trees of the output.  Optimizing the
+               output again with the same <file> then skips computing them.
+               Only use a <file> that nobody untrusted can write.  Cannot be
+               used with --batch.)");
+  printf(R"(
+  --audit-preserved-analyses
+               After each pass that changed the module, check which of the
+               analyses it invalidated are still the same, and could have been
+               declared preserved. Findings are printed to standard error
+               output. This is slow.)");
+  printf(R"(
+  --batch=<listfile>
+               Optimizes every binary named in <listfile>, one per line,
+               instead of a single input.  Each result is written to the
+               directory given with -o, under the file name of its input.
+               The result for each binary is printed, followed by a summary.
+               Flags that print reports, such as --print-all and
+               --time-report, and --analysis-snapshot cannot be used with it.
+               See also --jobs.)");
+  printf(R"(
   --before-hlsl-legalization
                Forwards this option to the validator.  See the validator help
                for details.)");
   printf(R"(
+  --cache-dir=<directory>
+               Keeps a cache of optimization results in <directory>, which
+               must exist.  A binary that was optimized before with the same
+               target environment, passes and options is read from the cache
+               instead of being optimized again.  The cache is not used with
+               --print-all or --time-report.)");
+  printf(R"(
   --ccp
                Apply the conditional constant propagation transform.  This will
                propagate constant values throughout the program, and simplify
@@ -261,6 +348,10 @@ Options (in lexicographical order):)",
                functions. Currently does not inline calls to functions with
                early return in a loop.)");
   printf(R"(
+  --jobs=<n>
+               Sets the number of binaries optimized at once with --batch.
+               The default, 0, uses one thread per hardware thread.)");
+  printf(R"(
   --legalize-hlsl
                Runs a series of optimizations that attempts to take SPIR-V
                generated by an HLSL front-end and generates legal Vulkan SPIR-V.
@@ -340,6 +431,12 @@ Options (in lexicographical order):)",
                the loop on each branch of the conditional and adjusting each
                copy of the loop.)");
   printf(R"(
+  --num-threads=<n>
+               Sets the number of threads that passes which support it, such
+               as --vector-dce, use to analyze functions concurrently. The
+               default, 1, uses the calling thread only, and 0 uses one thread
+               per hardware thread. The result does not depend on it.)");
+  printf(R"(
   -O
                Optimize for performance. Apply a sequence of transformations
                in an attempt to improve the performance of the generated
@@ -510,6 +607,15 @@ Options (in lexicographical order):)",
                USR/SYS time are returned by getrusage() and can have a small
                error.)");
   printf(R"(
+  --time-report=json
+               Print the measurements taken while running each pass to
+               standard error output, one JSON object per line: the pass name,
+               its wall and CPU time in seconds, the growth of the peak RSS in
+               kilobytes, the number of instructions before and after it, the
+               number of analyses it invalidated and built, and whether it
+               changed the module.  Times and RSS are -1 when they cannot be
+               measured.)");
+  printf(R"(
   --upgrade-memory-model
                Upgrades the Logical GLSL450 memory model to Logical VulkanKHR.
                Transforms memory, image, atomic and barrier operations to conform
@@ -600,20 +706,22 @@ OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
                      const char** out_file,
                      spvtools::ValidatorOptions* validator_options,
-                     spvtools::OptimizerOptions* optimizer_options);
+                     spvtools::OptimizerOptions* optimizer_options,
+                     BatchOptions* batch_options);
 
 // Parses and handles the -Oconfig flag. |prog_name| contains the name of
 // the spirv-opt binary (used to build a new argv vector for the recursive
 // invocation to ParseFlags). |opt_flag| contains the -Oconfig=FILENAME flag.
-// |optimizer|, |in_file|, |out_file|, |validator_options|, and
-// |optimizer_options| are as in ParseFlags.
+// |optimizer|, |in_file|, |out_file|, |validator_options|,
+// |optimizer_options| and |batch_options| are as in ParseFlags.
 //
 // This returns the same OptStatus instance returned by ParseFlags.
 OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
                            spvtools::Optimizer* optimizer, const char** in_file,
                            const char** out_file,
                            spvtools::ValidatorOptions* validator_options,
-                           spvtools::OptimizerOptions* optimizer_options) {
+                           spvtools::OptimizerOptions* optimizer_options,
+                           BatchOptions* batch_options) {
   std::vector<std::string> flags;
   flags.push_back(prog_name);
 
@@ -638,7 +746,7 @@ OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
 
   auto ret_val =
       ParseFlags(static_cast<int>(flags.size()), new_argv, optimizer, in_file,
-                 out_file, validator_options, optimizer_options);
+                 out_file, validator_options, optimizer_options, batch_options);
   delete[] new_argv;
   return ret_val;
 }
@@ -688,14 +796,15 @@ std::string CanonicalizeFlag(const char** argv, int argc, int* argi) {
 // Optimizer instance used to optimize the program.
 //
 // On return, this function stores the name of the input program in |in_file|.
-// The name of the output file in |out_file|. The return value indicates whether
-// optimization should continue and a status code indicating an error or
-// success.
+// The name of the output file in |out_file|, and the batch mode settings in
+// |batch_options|. The return value indicates whether optimization should
+// continue and a status code indicating an error or success.
 OptStatus ParseFlags(int argc, const char** argv,
                      spvtools::Optimizer* optimizer, const char** in_file,
                      const char** out_file,
                      spvtools::ValidatorOptions* validator_options,
-                     spvtools::OptimizerOptions* optimizer_options) {
+                     spvtools::OptimizerOptions* optimizer_options,
+                     BatchOptions* batch_options) {
   std::vector<std::string> pass_flags;
   for (int argi = 1; argi < argc; ++argi) {
     const char* cur_arg = argv[argi];
@@ -726,28 +835,62 @@ OptStatus ParseFlags(int argc, const char** argv,
       } else if (0 == strncmp(cur_arg, "-Oconfig=", sizeof("-Oconfig=") - 1)) {
         OptStatus status =
             ParseOconfigFlag(argv[0], cur_arg, optimizer, in_file, out_file,
-                             validator_options, optimizer_options);
+                             validator_options, optimizer_options,
+                             batch_options);
         if (status.action != OPT_CONTINUE) {
           return status;
         }
+      } else if (0 == strncmp(cur_arg, "--batch=", sizeof("--batch=") - 1)) {
+        batch_options->list_file = cur_arg + sizeof("--batch=") - 1;
+      } else if (0 == strncmp(cur_arg, "--jobs=", sizeof("--jobs=") - 1)) {
+        if (!ParseUnsignedFlag(cur_arg, &batch_options->num_jobs)) {
+          return {OPT_STOP, 1};
+        }
+      } else if (0 == strncmp(cur_arg, "--num-threads=",
+                              sizeof("--num-threads=") - 1)) {
+        uint32_t num_threads = 0;
+        if (!ParseUnsignedFlag(cur_arg, &num_threads)) {
+          return {OPT_STOP, 1};
+        }
+        optimizer_options->set_num_threads(num_threads);
+      } else if (0 == strncmp(cur_arg, "--cache-dir=",
+                              sizeof("--cache-dir=") - 1)) {
+        optimizer_options->set_cache_directory(cur_arg +
+                                               sizeof("--cache-dir=") - 1);
+      } else if (0 == strncmp(cur_arg, "--analysis-snapshot=",
+                              sizeof("--analysis-snapshot=") - 1)) {
+        batch_options->unbatchable_flag = "--analysis-snapshot";
+        optimizer_options->set_analysis_snapshot(
+            cur_arg + sizeof("--analysis-snapshot=") - 1);
       } else if (0 == strcmp(cur_arg, "--skip-validation")) {
         optimizer_options->set_run_validator(false);
       } else if (0 == strcmp(cur_arg, "--print-all")) {
+        batch_options->unbatchable_flag = cur_arg;
         optimizer->SetPrintAll(&std::cerr);
       } else if (0 == strcmp(cur_arg, "--preserve-bindings")) {
         optimizer_options->set_preserve_bindings(true);
       } else if (0 == strcmp(cur_arg, "--preserve-spec-constants")) {
         optimizer_options->set_preserve_spec_constants(true);
       } else if (0 == strcmp(cur_arg, "--time-report")) {
+        batch_options->unbatchable_flag = cur_arg;
         optimizer->SetTimeReport(&std::cerr);
+      } else if (0 == strcmp(cur_arg, "--time-report=json")) {
+        batch_options->unbatchable_flag = cur_arg;
+        optimizer->SetPassObserver(PrintPassMetricsAsJson);
+      } else if (0 == strcmp(cur_arg, "--analysis-report")) {
+        batch_options->unbatchable_flag = cur_arg;
+        optimizer->SetAnalysisReport(&std::cerr);
+      } else if (0 == strcmp(cur_arg, "--audit-preserved-analyses")) {
+        batch_options->unbatchable_flag = cur_arg;
+        optimizer->SetPreservedAnalysesAudit(&std::cerr);
       } else if (0 == strcmp(cur_arg, "--relax-struct-store")) {
         validator_options->SetRelaxStructStore(true);
       } else if (0 == strncmp(cur_arg, "--max-id-bound=",
                               sizeof("--max-id-bound=") - 1)) {
-        auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
-        // Will not allow values in the range [2^31,2^32).
-        uint32_t max_id_bound =
-            static_cast<uint32_t>(atoi(split_flag.second.c_str()));
+        uint32_t max_id_bound = 0;
+        if (!ParseUnsignedFlag(cur_arg, &max_id_bound)) {
+          return {OPT_STOP, 1};
+        }
 
         // That SPIR-V mandates the minimum value for max id bound but
         // implementations may allow higher minimum bounds.
@@ -815,6 +958,94 @@ OptStatus ParseFlags(int argc, const char** argv,
   return {OPT_CONTINUE, 0};
 }
 
+// Returns the part of |path| after the last directory separator.
+std::string FileName(const std::string& path) {
+  const size_t separator = path.find_last_of("/\\");
+  return separator == std::string::npos ? path : path.substr(separator + 1);
+}
+
+// Optimizes the binaries listed in the batch list of |batch_options| into the
+// directory |out_dir|, using |optimizer_options|.  An Optimizer cannot be
+// shared between threads, so every worker configures its own by parsing
+// |argc| and |argv| again.  Returns the exit code of the tool.
+int OptimizeBatch(int argc, const char** argv,
+                  const BatchOptions& batch_options, const char* out_dir,
+                  const spvtools::OptimizerOptions& optimizer_options) {
+  std::vector<std::string> files;
+  if (!spvtools::utils::ReadBatchList(batch_options.list_file, &files)) {
+    return 1;
+  }
+
+  std::vector<std::string> out_files;
+  std::unordered_set<std::string> file_names;
+  for (const std::string& file : files) {
+    const std::string file_name = FileName(file);
+    if (!file_names.insert(file_name).second) {
+      spvtools::Error(opt_diagnostic, nullptr, {},
+                      ("More than one input in the batch is named " +
+                       file_name)
+                          .c_str());
+      return 1;
+    }
+    out_files.push_back(std::string(out_dir) + "/" + file_name);
+  }
+
+  const size_t num_failed = spvtools::utils::RunBatch(
+      files, batch_options.num_jobs,
+      [argc, argv, &files, &out_files, &optimizer_options]() {
+        auto optimizer =
+            std::make_shared<spvtools::Optimizer>(kDefaultEnvironment);
+        const char* in_file = nullptr;
+        const char* out_file = nullptr;
+        spvtools::ValidatorOptions validator_options;
+        spvtools::OptimizerOptions unused_optimizer_options;
+        BatchOptions unused_batch_options;
+        // The flags were accepted by main, so they parse again.
+        ParseFlags(argc, argv, optimizer.get(), &in_file, &out_file,
+                   &validator_options, &unused_optimizer_options,
+                   &unused_batch_options);
+
+        // The consumer logs to the binary the worker is on.
+        struct Current {
+          const std::string* file;
+          std::string* log;
+        };
+        auto current = std::make_shared<Current>();
+        optimizer->SetMessageConsumer(
+            [current](spv_message_level_t level, const char*,
+                      const spv_position_t& position, const char* message) {
+              spvtools::utils::AppendBatchMessage(*current->file, level,
+                                                  position, message,
+                                                  current->log);
+            });
+
+        return spvtools::utils::BatchTask(
+            [&files, &out_files, &optimizer_options, optimizer, current](
+                size_t index, std::string* log) {
+              MappedBinaryFile input;
+              std::string error;
+              if (!input.Open(files[index].c_str(), &error)) {
+                log->append("error: " + error + "\n");
+                return false;
+              }
+              current->file = &files[index];
+              current->log = log;
+              std::vector<uint32_t> binary;
+              if (!optimizer->Run(input.data(), input.size(), &binary,
+                                  optimizer_options)) {
+                return false;
+              }
+              if (!WriteFile<uint32_t>(out_files[index].c_str(), "wb",
+                                       binary.data(), binary.size(), &error)) {
+                log->append("error: " + error + "\n");
+                return false;
+              }
+              return true;
+            });
+      });
+  return num_failed == 0 ? 0 : 1;
+}
+
 }  // namespace
 
 int main(int argc, const char** argv) {
@@ -828,8 +1059,10 @@ int main(int argc, const char** argv) {
 
   spvtools::ValidatorOptions validator_options;
   spvtools::OptimizerOptions optimizer_options;
+  BatchOptions batch_options;
   OptStatus status = ParseFlags(argc, argv, &optimizer, &in_file, &out_file,
-                                &validator_options, &optimizer_options);
+                                &validator_options, &optimizer_options,
+                                &batch_options);
   optimizer_options.set_validator_options(validator_options);
 
   if (status.action == OPT_STOP) {
@@ -841,15 +1074,31 @@ int main(int argc, const char** argv) {
     return 1;
   }
 
-  std::vector<uint32_t> binary;
-  if (!ReadBinaryFile<uint32_t>(in_file, &binary)) {
+  if (batch_options.list_file) {
+    if (in_file) {
+      spvtools::Error(opt_diagnostic, nullptr, {},
+                      "An input file cannot be used with --batch");
+      return 1;
+    }
+    if (batch_options.unbatchable_flag) {
+      spvtools::Error(opt_diagnostic, nullptr, {},
+                      (std::string(batch_options.unbatchable_flag) +
+                       " cannot be used with --batch")
+                          .c_str());
+      return 1;
+    }
+    return OptimizeBatch(argc, argv, batch_options, out_file,
+                         optimizer_options);
+  }
+
+  MappedBinaryFile input;
+  if (!input.Open(in_file)) {
     return 1;
   }
 
-  // By using the same vector as input and output, we save time in the case
-  // that there was no change.
+  std::vector<uint32_t> binary;
   bool ok =
-      optimizer.Run(binary.data(), binary.size(), &binary, optimizer_options);
+      optimizer.Run(input.data(), input.size(), &binary, optimizer_options);
 
   if (!WriteFile<uint32_t>(out_file, "wb", binary.data(), binary.size())) {
     return 1;
@@ -23,6 +23,7 @@
 #include "source/opt/log.h"
 #include "source/reduce/reducer.h"
 #include "source/spirv_reducer_options.h"
+#include "source/util/parse_number.h"
 #include "source/util/string_utils.h"
 #include "tools/io.h"
 #include "tools/util/cli_consumer.h"
@@ -100,6 +101,13 @@ Options (in lexicographical order):
                SPIR-V module that fails to validate.
   -h, --help
                Print this help.
+  --jobs=
+               32-bit unsigned integer specifying the number of reduction
+               steps to try at once.  The interestingness test runs
+               concurrently on the modules of those steps, each with its own
+               temporary file, and the first interesting step is kept, so the
+               result is the same as trying one step at a time (the default,
+               1).  0 uses one job per hardware thread.
   --step-limit=
                32-bit unsigned integer specifying maximum number of steps the
                reducer will take before giving up.
@@ -187,6 +195,17 @@ ReduceStatus ParseFlags(int argc, const char** argv,
             static_cast<uint32_t>(strtol(split_flag.second.c_str(), &end, 10));
         assert(end != split_flag.second.c_str() && errno == 0);
         reducer_options->set_target_function(target_function);
+      } else if (0 == strncmp(cur_arg, "--jobs=", sizeof("--jobs=") - 1)) {
+        const auto split_flag = spvtools::utils::SplitFlagArgs(cur_arg);
+        uint32_t num_jobs = 0;
+        if (!spvtools::utils::ParseNumber(split_flag.second.c_str(),
+                                          &num_jobs)) {
+          spvtools::Error(ReduceDiagnostic, nullptr, {},
+                          ("Invalid value passed to --" + split_flag.first)
+                              .c_str());
+          return {REDUCE_STOP, 1};
+        }
+        reducer_options->set_num_jobs(num_jobs);
       } else if (0 == strcmp(cur_arg, "--fail-on-validation-error")) {
         reducer_options->set_fail_on_validation_error(true);
       } else if (0 == strcmp(cur_arg, "--before-hlsl-legalization")) {
@@ -0,0 +1,110 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tools/util/batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "source/util/parallel.h"
+
+namespace spvtools {
+namespace utils {
+
+bool ReadBatchList(const char* list_file, std::vector<std::string>* files) {
+  std::ifstream input(list_file);
+  if (!input) {
+    std::cerr << "error: could not open batch list '" << list_file << "'"
+              << std::endl;
+    return false;
+  }
+  std::string line;
+  while (std::getline(input, line)) {
+    // Tolerate lists written with Windows line endings.
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.find_first_not_of(" \t") == std::string::npos) continue;
+    files->push_back(line);
+  }
+  if (input.bad()) {
+    std::cerr << "error: error reading batch list '" << list_file << "'"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+size_t RunBatch(const std::vector<std::string>& files, uint32_t num_jobs,
+                const std::function<BatchTask()>& make_task) {
+  const size_t count = files.size();
+  if (num_jobs == 0) num_jobs = HardwareConcurrency();
+  const uint32_t num_workers = static_cast<uint32_t>(
+      std::min<size_t>(num_jobs, std::max<size_t>(count, 1)));
+
+  std::vector<std::string> logs(count);
+  // Not std::vector<bool>, whose elements cannot be written concurrently.
+  std::vector<char> succeeded(count, 0);
+  std::atomic<size_t> next(0);
+  ParallelFor(num_workers, num_workers, [&](size_t) {
+    BatchTask task = make_task();
+    for (size_t index = next++; index < count; index = next++) {
+      succeeded[index] = task(index, &logs[index]);
+    }
+  });
+
+  size_t num_failed = 0;
+  for (size_t index = 0; index < count; ++index) {
+    std::cerr << logs[index];
+    if (succeeded[index]) {
+      std::cout << files[index] << ": ok\n";
+    } else {
+      std::cout << files[index] << ": failed\n";
+      ++num_failed;
+    }
+  }
+  std::cerr << std::flush;
+  std::cout << "Processed " << count << " modules, " << num_failed
+            << " failed." << std::endl;
+  return num_failed;
+}
+
+void AppendBatchMessage(const std::string& file, spv_message_level_t level,
+                        const spv_position_t& position, const char* message,
+                        std::string* log) {
+  const char* kind = nullptr;
+  switch (level) {
+    case SPV_MSG_FATAL:
+    case SPV_MSG_INTERNAL_ERROR:
+    case SPV_MSG_ERROR:
+      kind = "error";
+      break;
+    case SPV_MSG_WARNING:
+      kind = "warning";
+      break;
+    case SPV_MSG_INFO:
+      kind = "info";
+      break;
+    default:
+      return;
+  }
+  std::ostringstream os;
+  os << kind << ": " << file << ": line " << position.index << ": " << message
+     << "\n";
+  log->append(os.str());
+}
+
+}  // namespace utils
+}  // namespace spvtools
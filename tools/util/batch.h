@@ -0,0 +1,60 @@
+// Copyright (c) 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLS_UTIL_BATCH_H_
+#define TOOLS_UTIL_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "include/spirv-tools/libspirv.h"
+
+namespace spvtools {
+namespace utils {
+
+// Processes the module at position |index| of a batch, appending messages
+// about it to |log|.  Returns true on success.
+using BatchTask = std::function<bool(size_t index, std::string* log)>;
+
+// Appends the names of the modules of a batch to |files|.  The names are read
+// from the file named |list_file|, one per line; blank lines are skipped.  If
+// the file cannot be read, writes an error message to standard error and
+// returns false.
+bool ReadBatchList(const char* list_file, std::vector<std::string>* files);
+
+// Processes the modules named in |files| on |num_jobs| worker threads, or on
+// one thread per hardware thread if |num_jobs| is 0.  Each worker calls
+// |make_task| once, possibly concurrently with other workers, and then runs
+// the returned task on modules until none are left, so the setup done by
+// |make_task| is shared by all the modules a worker processes.
+//
+// Once every module is done, writes the messages logged for each module to
+// standard error and its result to standard output, in batch order, followed
+// by a summary.  Returns the number of modules that failed.
+size_t RunBatch(const std::vector<std::string>& files, uint32_t num_jobs,
+                const std::function<BatchTask()>& make_task);
+
+// Appends |message| to |log| in the format used by CLIMessageConsumer, with
+// the name of the module, |file|, in front.
+void AppendBatchMessage(const std::string& file, spv_message_level_t level,
+                        const spv_position_t& position, const char* message,
+                        std::string* log);
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // TOOLS_UTIL_BATCH_H_
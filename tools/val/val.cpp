@@ -16,12 +16,16 @@
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "source/spirv_target_env.h"
 #include "source/spirv_validator_options.h"
+#include "source/util/parse_number.h"
 #include "spirv-tools/libspirv.hpp"
 #include "tools/io.h"
+#include "tools/util/batch.h"
 #include "tools/util/cli_consumer.h"
 
 void print_usage(char* argv0) {
@@ -30,14 +34,22 @@ void print_usage(char* argv0) {
       R"(%s - Validate a SPIR-V binary file.
 
 USAGE: %s [options] [<filename>]
+       %s [options] --batch <listfile>
 
 The SPIR-V binary is read from <filename>. If no file is specified,
 or if the filename is "-", then the binary is read from standard input.
 
+With --batch, every binary named in <listfile>, one per line, is validated
+with the same options, and the result for each is printed followed by a
+summary.
+
 NOTE: The validator is a work in progress.
 
 Options:
   -h, --help                       Print this help.
+  --batch                          <file listing the binaries to validate>
+  --jobs                           <number of binaries validated at once with --batch>
+                                   Defaults to 0, which uses one thread per hardware thread.
   --max-struct-members             <maximum number of structure members allowed>
   --max-struct-depth               <maximum allowed nesting depth of structures>
   --max-local-variables            <maximum number of local variables allowed>
@@ -68,15 +80,20 @@ Options:
                                    be allowed by the target environment.
   --before-hlsl-legalization       Allows code patterns that are intended to be
                                    fixed by spirv-opt's legalization passes.
+  --threads                        <number of threads used to validate function bodies>
+                                   Defaults to 1. 0 uses one thread per hardware thread.
+                                   Diagnostics are the same for any number of threads.
   --version                        Display validator version information.
   --target-env                     {%s}
                                    Use validation rules from the specified environment.
 )",
-      argv0, argv0, target_env_list.c_str());
+      argv0, argv0, argv0, target_env_list.c_str());
 }
 
 int main(int argc, char** argv) {
   const char* inFile = nullptr;
+  const char* batch_list = nullptr;
+  uint32_t num_jobs = 0;
   spv_target_env target_env = SPV_ENV_UNIVERSAL_1_6;
   spvtools::ValidatorOptions options;
   bool continue_processing = true;
@@ -144,6 +161,39 @@ int main(int argc, char** argv) {
           continue_processing = false;
           return_code = 1;
         }
+      } else if (0 == strcmp(cur_arg, "--threads")) {
+        uint32_t num_threads = 0;
+        if (argi + 1 >= argc) {
+          fprintf(stderr, "error: Missing argument to --threads\n");
+          continue_processing = false;
+          return_code = 1;
+        } else if (!spvtools::utils::ParseNumber(argv[++argi], &num_threads)) {
+          fprintf(stderr, "error: Invalid argument to --threads: %s\n",
+                  argv[argi]);
+          continue_processing = false;
+          return_code = 1;
+        } else {
+          options.SetNumThreads(num_threads);
+        }
+      } else if (0 == strcmp(cur_arg, "--batch")) {
+        if (argi + 1 < argc) {
+          batch_list = argv[++argi];
+        } else {
+          fprintf(stderr, "error: Missing argument to --batch\n");
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--jobs")) {
+        if (argi + 1 >= argc) {
+          fprintf(stderr, "error: Missing argument to --jobs\n");
+          continue_processing = false;
+          return_code = 1;
+        } else if (!spvtools::utils::ParseNumber(argv[++argi], &num_jobs)) {
+          fprintf(stderr, "error: Invalid argument to --jobs: %s\n",
+                  argv[argi]);
+          continue_processing = false;
+          return_code = 1;
+        }
       } else if (0 == strcmp(cur_arg, "--before-hlsl-legalization")) {
         options.SetBeforeHlslLegalization(true);
       } else if (0 == strcmp(cur_arg, "--relax-logical-pointer")) {
@@ -192,8 +242,51 @@ int main(int argc, char** argv) {
     return return_code;
   }
 
-  std::vector<uint32_t> contents;
-  if (!ReadBinaryFile<uint32_t>(inFile, &contents)) return 1;
+  if (batch_list) {
+    if (inFile) {
+      fprintf(stderr, "error: An input file cannot be used with --batch\n");
+      return 1;
+    }
+    std::vector<std::string> files;
+    if (!spvtools::utils::ReadBatchList(batch_list, &files)) return 1;
+
+    // Each worker validates with its own SpirvTools, whose consumer logs to
+    // the module the worker is on.
+    const size_t num_failed = spvtools::utils::RunBatch(
+        files, num_jobs, [&files, &options, target_env]() {
+          struct Current {
+            const std::string* file;
+            std::string* log;
+          };
+          auto current = std::make_shared<Current>();
+          auto tools = std::make_shared<spvtools::SpirvTools>(target_env);
+          tools->SetMessageConsumer(
+              [current](spv_message_level_t level, const char*,
+                        const spv_position_t& position, const char* message) {
+                spvtools::utils::AppendBatchMessage(*current->file, level,
+                                                    position, message,
+                                                    current->log);
+              });
+          return spvtools::utils::BatchTask(
+              [&files, &options, current, tools](size_t index,
+                                                 std::string* log) {
+                MappedBinaryFile contents;
+                std::string error;
+                if (!contents.Open(files[index].c_str(), &error)) {
+                  log->append("error: " + error + "\n");
+                  return false;
+                }
+                current->file = &files[index];
+                current->log = log;
+                return tools->Validate(contents.data(), contents.size(),
+                                       options);
+              });
+        });
+    return num_failed == 0 ? 0 : 1;
+  }
+
+  MappedBinaryFile contents;
+  if (!contents.Open(inFile)) return 1;
 
   spvtools::SpirvTools tools(target_env);
   tools.SetMessageConsumer(spvtools::utils::CLIMessageConsumer);
@@ -146,6 +146,29 @@ def generate_extension_arrays(extensions):
     return '\n'.join(arrays)
 
 
+def generate_name_index(array_name, names):
+    """Returns the C definition of the name index of a table.
+
+    The name index lists the positions of the table entries in the order of
+    their names, so they can be looked up by binary search.  Entries with the
+    same name keep their order in the table.
+
+    Arguments:
+      - array_name: the name of the array to define
+      - names: the names of the table entries, in table order
+    """
+    assert len(names) < 2**16
+    if not names:
+        # A zero-length array is ill-formed, so an empty table gets an index
+        # with one entry.  Lookups take the number of entries from the table,
+        # so it is never read.
+        return 'static const uint16_t {}[] = {{0}};'.format(array_name)
+    # Sorting the UTF-8 encoding orders the names the same way as strcmp.
+    index = sorted(range(len(names)), key=lambda i: names[i].encode('utf-8'))
+    return 'static const uint16_t {}[] = {{{}}};'.format(
+        array_name, ', '.join([str(i) for i in index]))
+
+
 def convert_operand_kind(operand_tuple):
     """Returns the corresponding operand type used in spirv-tools for the given
     operand kind and quantifier used in the JSON grammar.
@@ -356,8 +379,12 @@ def generate_instruction_table(inst_table):
     insts = [generate_instruction(inst, False) for inst in inst_table]
     insts = ['static const spv_opcode_desc_t kOpcodeTableEntries[] = {{\n'
              '  {}\n}};'.format(',\n  '.join(insts))]
+    name_index = generate_name_index(
+        'kOpcodeTableNameIndex',
+        [inst['opname'][2:] for inst in inst_table])  # Without "Op".
 
-    return '{}\n\n{}\n\n{}'.format(caps_arrays, exts_arrays, '\n'.join(insts))
+    return '{}\n\n{}\n\n{}\n\n{}'.format(caps_arrays, exts_arrays,
+                                       '\n'.join(insts), name_index)
 
 
 def generate_extended_instruction_table(json_grammar, set_name, operand_kind_prefix=""):
@@ -382,8 +409,11 @@ def generate_extended_instruction_table(json_grammar, set_name, operand_kind_pre
     insts = [generate_instruction(inst, True) for inst in inst_table]
     insts = ['static const spv_ext_inst_desc_t {}_entries[] = {{\n'
              '  {}\n}};'.format(set_name, ',\n  '.join(insts))]
+    name_index = generate_name_index(
+        '{}_name_index'.format(set_name),
+        [inst['opname'] for inst in inst_table])
 
-    return '{}\n\n{}'.format(caps_arrays, '\n'.join(insts))
+    return '{}\n\n{}\n\n{}'.format(caps_arrays, '\n'.join(insts), name_index)
 
 
 class EnumerantInitializer(object):
@@ -495,16 +525,20 @@ def generate_enum_operand_kind(enum, synthetic_exts_list):
     synthetic_exts_list.extend(extension_map.values())
 
     name = '{}_{}Entries'.format(PYGEN_VARIABLE_PREFIX, kind)
+    index_name = '{}_{}NameIndex'.format(PYGEN_VARIABLE_PREFIX, kind)
+    name_index = generate_name_index(
+        index_name, [e.get('enumerant') for e in entries])
     entries = ['  {}'.format(generate_enum_operand_kind_entry(e, extension_map))
                for e in entries]
 
     template = ['static const spv_operand_desc_t {name}[] = {{',
-                '{entries}', '}};']
+                '{entries}', '}};', '{name_index}']
     entries = '\n'.join(template).format(
         name=name,
-        entries=',\n'.join(entries))
+        entries=',\n'.join(entries),
+        name_index=name_index)
 
-    return kind, name, entries
+    return kind, name, index_name, entries
 
 
 def generate_operand_kind_table(enums):
@@ -529,15 +563,15 @@ def generate_operand_kind_table(enums):
     optional_enums = [e for e in enums if e[0] in optional_enums]
     enums.extend(optional_enums)
 
-    enum_kinds, enum_names, enum_entries = zip(*enums)
+    enum_kinds, enum_names, enum_indices, enum_entries = zip(*enums)
     # Mark the last few as optional ones.
     enum_quantifiers = [''] * (len(enums) - len(optional_enums)) + ['?'] * len(optional_enums)
     # And we don't want redefinition of them.
     enum_entries = enum_entries[:-len(optional_enums)]
     enum_kinds = [convert_operand_kind(e)
                   for e in zip(enum_kinds, enum_quantifiers)]
-    table_entries = zip(enum_kinds, enum_names, enum_names)
-    table_entries = ['  {{{}, ARRAY_SIZE({}), {}}}'.format(*e)
+    table_entries = zip(enum_kinds, enum_names, enum_names, enum_indices)
+    table_entries = ['  {{{}, ARRAY_SIZE({}), {}, {}}}'.format(*e)
                      for e in table_entries]
 
     template = [